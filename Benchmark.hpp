@@ -0,0 +1,346 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+using namespace std;
+
+/*
+	Средства для воспроизводимых замеров производительности таблиц
+	Каждый замер повторяется несколько раз после прогревочных повторов, перед
+	каждым повтором кеш вытесняется проходом по большому буферу, а операции
+	замеряются блоками фиксированного размера: по временам блоков считаются
+	минимум, медиана и 99-й перцентиль времени операции, а по общему времени -
+	среднее. Результаты выводятся таблицей и записываются в CSV и JSON
+*/
+
+// распределение ключей
+enum class KeyDistribution {
+	Uniform, // случайные ключи, поиск равномерный
+	Sequential, // подряд идущие ключи
+	Zipfian, // случайные ключи, поиск по закону Ципфа (часть ключей запрашивается намного чаще)
+	Clustered // плотные группы соседних ключей, отсутствующие ключи лежат между присутствующими
+};
+
+// название распределения
+inline string DistributionName(KeyDistribution distribution) {
+	switch (distribution) {
+		case KeyDistribution::Uniform:
+			return "uniform";
+
+		case KeyDistribution::Sequential:
+			return "sequential";
+
+		case KeyDistribution::Zipfian:
+			return "zipfian";
+
+		default:
+			return "clustered";
+	}
+}
+
+// набор ключей для одного замера
+struct KeySet {
+	vector<int> present; // ключи, добавляемые в таблицу (в порядке добавления)
+	vector<int> hits; // запросы присутствующих ключей
+	vector<int> misses; // запросы отсутствующих ключей
+};
+
+// генерация count различных случайных ключей от 0 до maxKey
+inline vector<int> UniformKeys(int count, mt19937 &generator, int maxKey = INT32_MAX) {
+	uniform_int_distribution<int> distribution(0, maxKey);
+	vector<int> keys;
+
+	while ((int) keys.size() < count) {
+		while ((int) keys.size() < count)
+			keys.push_back(distribution(generator));
+
+		sort(keys.begin(), keys.end());
+		keys.erase(unique(keys.begin(), keys.end()), keys.end());
+	}
+
+	shuffle(keys.begin(), keys.end(), generator);
+	return keys;
+}
+
+// генерация набора из count присутствующих ключей и queries запросов попаданий и промахов
+inline KeySet GenerateKeys(KeyDistribution distribution, int count, int queries, unsigned int seed) {
+	mt19937 generator(seed);
+	KeySet keys;
+	vector<int> absent;
+
+	if (distribution == KeyDistribution::Sequential) {
+		int base = uniform_int_distribution<int>(0, INT32_MAX / 2)(generator);
+
+		for (int i = 0; i < count; i++) {
+			keys.present.push_back(base + i);
+			absent.push_back(base + count + i);
+		}
+	}
+	else if (distribution == KeyDistribution::Clustered) {
+		// группы из 64 соседних ключей с началами, кратными 4096: чётные ключи группы присутствуют, нечётные - нет
+		const int clusterSize = 64;
+		vector<int> clusters = UniformKeys((count * 2 + clusterSize - 1) / clusterSize, generator, INT32_MAX >> 12);
+
+		for (size_t i = 0; i < clusters.size() && (int) keys.present.size() < count; i++) {
+			int base = clusters[i] << 12;
+
+			for (int j = 0; j < clusterSize && (int) keys.present.size() < count; j += 2) {
+				keys.present.push_back(base + j);
+				absent.push_back(base + j + 1);
+			}
+		}
+	}
+	else {
+		vector<int> all = UniformKeys(count * 2, generator);
+
+		keys.present.assign(all.begin(), all.begin() + count);
+		absent.assign(all.begin() + count, all.end());
+	}
+
+	if (distribution == KeyDistribution::Zipfian) {
+		// функция распределения рангов с показателем 0.99, ранги сопоставлены ключам в случайном порядке
+		vector<double> cdf(count);
+		double sum = 0;
+
+		for (int i = 0; i < count; i++) {
+			sum += 1 / pow(i + 1, 0.99);
+			cdf[i] = sum;
+		}
+
+		uniform_real_distribution<double> uniform(0, sum);
+
+		for (int i = 0; i < queries; i++) {
+			int rank = lower_bound(cdf.begin(), cdf.end(), uniform(generator)) - cdf.begin();
+			keys.hits.push_back(keys.present[min(rank, count - 1)]);
+		}
+	}
+	else {
+		uniform_int_distribution<int> index(0, count - 1);
+
+		for (int i = 0; i < queries; i++)
+			keys.hits.push_back(keys.present[index(generator)]);
+	}
+
+	uniform_int_distribution<int> index(0, absent.size() - 1);
+
+	for (int i = 0; i < queries; i++)
+		keys.misses.push_back(absent[index(generator)]);
+
+	return keys;
+}
+
+// статистика времени операции в наносекундах
+struct BenchmarkStats {
+	double mean; // общее время, делённое на число операций
+	double min; // минимум по блокам
+	double median; // медиана по блокам
+	double p99; // 99-й перцентиль по блокам
+};
+
+// вычисление статистики по временам блоков
+inline BenchmarkStats ComputeStats(vector<double> samples, double mean) {
+	BenchmarkStats stats = { mean, 0, 0, 0 };
+
+	if (samples.empty())
+		return stats;
+
+	sort(samples.begin(), samples.end());
+
+	stats.min = samples.front();
+	stats.median = samples[samples.size() / 2];
+	stats.p99 = samples[min(samples.size() - 1, (size_t) ceil(samples.size() * 0.99) - 1)];
+	return stats;
+}
+
+// замер операций блоками фиксированного размера: время каждого блока - отдельная выборка
+class BlockTimer {
+    int blockSize; // число операций в блоке
+    vector<double> samples; // время операции в каждом блоке
+    double totalTime; // общее время всех операций
+    long long operations; // общее число операций
+
+public:
+    BlockTimer(int blockSize = 1024) : blockSize(blockSize), totalTime(0), operations(0) {}
+
+    // замер count операций op(i)
+    template <typename Operation>
+    void Run(int count, Operation op) {
+    	for (int start = 0; start < count; start += blockSize) {
+    		int end = min(start + blockSize, count);
+    		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    		for (int i = start; i < end; i++)
+    			op(i);
+
+    		chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+    		double time = chrono::duration<double, nano>(t2 - t1).count();
+
+    		samples.push_back(time / (end - start));
+    		totalTime += time;
+    		operations += end - start;
+    	}
+    }
+
+    BenchmarkStats GetStats() const { return ComputeStats(samples, operations ? totalTime / operations : 0); } // статистика всех замеров
+    long long GetOperations() const { return operations; } // число замеренных операций
+};
+
+// вытеснение данных предыдущих замеров из кеша проходом по буферу большего размера
+inline void FlushCache(size_t bytes = 64 << 20) {
+	static vector<char> buffer;
+	buffer.resize(bytes);
+
+	for (size_t i = 0; i < buffer.size(); i += 64)
+		buffer[i]++;
+
+	volatile char sink = buffer[rand() % buffer.size()];
+	(void) sink;
+}
+
+// результат одного замера
+struct BenchmarkResult {
+	string table; // название таблицы
+	string keyType; // тип ключей
+	string distribution; // распределение ключей
+	double loadFactor; // коэффициент заполнения
+	string operation; // замеряемая операция
+	long long operations; // число замеренных операций
+	BenchmarkStats stats; // статистика времени операции
+	double bytesPerEntry; // память таблицы на один элемент
+};
+
+// накопление результатов и их вывод
+class BenchmarkReport {
+    vector<BenchmarkResult> results; // результаты замеров
+
+    static string Escape(const string &text); // экранирование строки для JSON
+
+public:
+    void Add(const BenchmarkResult &result); // добавление результата с выводом строки таблицы
+    void PrintHeader() const; // вывод заголовка таблицы
+
+    void WriteCsv(const string &path) const; // запись результатов в CSV
+    void WriteJson(const string &path) const; // запись результатов в JSON
+};
+
+// экранирование строки для JSON
+inline string BenchmarkReport::Escape(const string &text) {
+	string escaped;
+
+	for (char c : text) {
+		if (c == '"' || c == '\\')
+			escaped += '\\';
+
+		escaped += c;
+	}
+
+	return escaped;
+}
+
+// вывод заголовка таблицы
+inline void BenchmarkReport::PrintHeader() const {
+	cout << left << setw(40) << "table" << setw(8) << "key" << setw(12) << "keys" << setw(6) << "load" << setw(12) << "operation";
+	cout << right << setw(10) << "mean, ns" << setw(10) << "min" << setw(10) << "median" << setw(10) << "p99" << setw(10) << "B/entry" << endl;
+}
+
+// добавление результата с выводом строки таблицы
+inline void BenchmarkReport::Add(const BenchmarkResult &result) {
+	results.push_back(result);
+
+	cout << left << setw(40) << result.table << setw(8) << result.keyType << setw(12) << result.distribution << setw(6) << result.loadFactor << setw(12) << result.operation;
+	cout << right << fixed << setprecision(1);
+	cout << setw(10) << result.stats.mean << setw(10) << result.stats.min << setw(10) << result.stats.median << setw(10) << result.stats.p99 << setw(10) << result.bytesPerEntry << endl;
+	cout << defaultfloat << setprecision(6);
+}
+
+// запись результатов в CSV
+inline void BenchmarkReport::WriteCsv(const string &path) const {
+	ofstream f(path);
+
+	if (!f)
+		throw string("Unable to open file '") + path + "'";
+
+	f << "table,key_type,distribution,load_factor,operation,operations,mean_ns,min_ns,median_ns,p99_ns,bytes_per_entry" << endl;
+
+	for (const BenchmarkResult &result : results) {
+		f << '"' << result.table << "\"," << result.keyType << "," << result.distribution << "," << result.loadFactor << "," << result.operation << "," << result.operations << ",";
+		f << result.stats.mean << "," << result.stats.min << "," << result.stats.median << "," << result.stats.p99 << "," << result.bytesPerEntry << endl;
+	}
+}
+
+// запись результатов в JSON
+inline void BenchmarkReport::WriteJson(const string &path) const {
+	ofstream f(path);
+
+	if (!f)
+		throw string("Unable to open file '") + path + "'";
+
+	f << "[" << endl;
+
+	for (size_t i = 0; i < results.size(); i++) {
+		const BenchmarkResult &result = results[i];
+
+		f << "  {\"table\": \"" << Escape(result.table) << "\", \"key_type\": \"" << result.keyType << "\", \"distribution\": \"" << result.distribution << "\", ";
+		f << "\"load_factor\": " << result.loadFactor << ", \"operation\": \"" << result.operation << "\", \"operations\": " << result.operations << ", ";
+		f << "\"mean_ns\": " << result.stats.mean << ", \"min_ns\": " << result.stats.min << ", \"median_ns\": " << result.stats.median << ", \"p99_ns\": " << result.stats.p99 << ", \"bytes_per_entry\": " << result.bytesPerEntry << "}";
+		f << (i + 1 < results.size() ? "," : "") << endl;
+	}
+
+	f << "]" << endl;
+}
+
+// параметры запуска замеров
+struct BenchmarkOptions {
+	int warmup = 1; // число прогревочных повторов
+	int trials = 5; // число замеряемых повторов
+	int tableSize = 1 << 18; // ёмкость таблиц
+	vector<double> loadFactors = { 0.1, 0.25, 0.5, 0.75, 0.9, 0.95 }; // коэффициенты заполнения
+	string filter; // замеряются только таблицы, в названии которых есть эта строка
+	string csvPath; // файл для CSV (пусто - не записывать)
+	string jsonPath; // файл для JSON (пусто - не записывать)
+
+	// разбор аргументов командной строки
+	void Parse(int argc, char **argv) {
+		for (int i = 1; i < argc; i++) {
+			string arg = argv[i];
+
+			if (arg == "--quick") {
+				trials = 3;
+				tableSize = 1 << 16;
+				loadFactors = { 0.25, 0.5, 0.9 };
+				continue;
+			}
+
+			if (i + 1 >= argc)
+				throw string("Missing value for argument '") + arg + "'";
+
+			string value = argv[++i];
+
+			if (arg == "--warmup")
+				warmup = atoi(value.c_str());
+			else if (arg == "--trials")
+				trials = max(1, atoi(value.c_str()));
+			else if (arg == "--size")
+				tableSize = max(1024, atoi(value.c_str()));
+			else if (arg == "--filter")
+				filter = value;
+			else if (arg == "--csv")
+				csvPath = value;
+			else if (arg == "--json")
+				jsonPath = value;
+			else
+				throw string("Unknown argument '") + arg + "'";
+		}
+	}
+};
@@ -0,0 +1,578 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include "HashTable.h"
+#include "HashFunctions.hpp"
+#include "NodeAllocator.hpp"
+
+using namespace std;
+
+/*
+	Хеш таблица на основе метода цепочек из звеньев
+	Элементы корзины хранятся в звеньях, каждое из которых занимает линию кеша
+	и содержит несколько элементов подряд. Для каждого элемента хранится
+	однобайтовый отпечаток хеша, причём отпечатки первого звена лежат прямо
+	в массиве корзин, поэтому большинство промахов не требует перехода по
+	указателю, а ключи сравниваются только при совпадении отпечатков.
+	Как и в обычном методе цепочек, коэффициент заполнения может быть больше
+	единицы; при его превышении число корзин удваивается
+*/
+
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename KeyEqual = equal_to<K>>
+class BucketChainingTable final : public HashTable<K, T> {
+	static constexpr int CHUNK_SIZE = min(7, max(1, 48 / int(sizeof(K) + sizeof(T)))); // число элементов в звене (звено занимает линию кеша)
+
+    // звено цепочки
+    struct alignas(64) Chunk {
+    	unsigned char tags[CHUNK_SIZE]; // отпечатки хешей элементов (у первого звена хранятся в корзине)
+    	unsigned char count; // число элементов в звене
+    	Chunk *next; // следующее звено
+    	K keys[CHUNK_SIZE]; // ключи элементов
+    	T values[CHUNK_SIZE]; // значения элементов
+    };
+
+    // корзина: элементы заполняют сначала первое звено, затем остальные,
+    // причём частично заполненным может быть только первое или второе звено
+    struct alignas(16) Bucket {
+    	unsigned char tags[CHUNK_SIZE]; // отпечатки хешей элементов первого звена
+    	unsigned char count; // число элементов в первом звене
+    	Chunk *head; // первое звено цепочки
+    };
+
+    // расположение элемента
+    struct Entry {
+    	unsigned char *tag;
+    	K *key;
+    	T *value;
+    };
+
+    int capacity; // число корзин
+    int size; // число элементов в таблице
+    double maxLoadFactor; // максимальный коэффициент заполнения
+
+    Bucket *buckets; // массив корзин
+    PooledNodes<Chunk, allocator<char>> chunks; // память под звенья цепочек
+
+    Hash hasher; // хеш-функция
+    KeyEqual keyEqual; // сравнение ключей
+
+    // ненулевой отпечаток хеша из частного от деления на число корзин: остаток задаёт корзину, поэтому
+    // у ключей одной корзины различаются только старшие биты (частное и остаток вычисляются одним делением)
+    unsigned char Tag(uint64_t hash) const { return ((hash / capacity) & 0x7f) + 1; }
+
+    template <typename Key>
+    bool Locate(const Key& key, uint64_t hash, Entry& entry) const; // поиск элемента (ложь, если нет)
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой корзины в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+    template <typename KeyArg, typename ValueArg>
+    T* Append(Bucket& bucket, unsigned char tag, KeyArg&& key, ValueArg&& value); // добавление элемента в конец корзины
+    Chunk* NewChunk(); // создание пустого звена
+    void FreeChunks(Bucket& bucket); // освобождение цепочки корзины
+    void Allocate(int newCapacity); // выделение памяти под корзины
+    void Rebuild(int newCapacity); // перестроение таблицы
+    template <typename KeyArg, typename ValueArg>
+    pair<T*, bool> Emplace(KeyArg&& key, ValueArg&& value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+
+public:
+    BucketChainingTable(int tableSize, const Hash& hasher = Hash(), double maxLoadFactor = 2, const KeyEqual& keyEqual = KeyEqual()); // конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+    BucketChainingTable(int tableSize, int (*h)(K), double maxLoadFactor = 2); // конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+    BucketChainingTable(const BucketChainingTable& table); // конструктор копирования
+    BucketChainingTable(BucketChainingTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    BucketChainingTable& operator=(BucketChainingTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(BucketChainingTable& table) noexcept; // обмен содержимым таблиц за O(1)
+
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
+    bool Remove(const K& key); // удаление по ключу
+    bool Find(const K& key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+
+    T Get(const K& key) const; // получение значения по ключу
+
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    // поиск по ключу другого типа при прозрачных хеш-функции и сравнении ключей
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    T* FindPtr(const Key& key) { Entry entry; return Locate(key, hasher(key), entry) ? entry.value : nullptr; }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    const T* FindPtr(const Key& key) const { Entry entry; return Locate(key, hasher(key), entry) ? entry.value : nullptr; }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    bool Find(const Key& key) const { Entry entry; return Locate(key, hasher(key), entry); }
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Print() const; // вывод таблицы
+
+    ~BucketChainingTable(); // деструктор (освобождение памяти)
+};
+
+// конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+template <typename K, typename T, typename Hash, typename KeyEqual>
+BucketChainingTable<K, T, Hash, KeyEqual>::BucketChainingTable(int tableSize, const Hash& hasher, double maxLoadFactor, const KeyEqual& keyEqual) : hasher(hasher), keyEqual(keyEqual) {
+	this->size = 0; // изначально нет элементов
+	this->maxLoadFactor = maxLoadFactor;
+
+	Allocate(tableSize); // выделяем память под корзины
+}
+
+// конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+template <typename K, typename T, typename Hash, typename KeyEqual>
+BucketChainingTable<K, T, Hash, KeyEqual>::BucketChainingTable(int tableSize, int (*h)(K), double maxLoadFactor) : BucketChainingTable(tableSize, Hash(h), maxLoadFactor) {
+}
+
+// конструктор копирования
+template <typename K, typename T, typename Hash, typename KeyEqual>
+BucketChainingTable<K, T, Hash, KeyEqual>::BucketChainingTable(const BucketChainingTable& table) : chunks(table.chunks), hasher(table.hasher), keyEqual(table.keyEqual) {
+	size = table.size; // копируем количество элементов
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
+
+	// у перемещённой таблицы корзин нет, поэтому нет их и у копии
+	if (table.capacity == 0) {
+		capacity = 0;
+		buckets = nullptr;
+		return;
+	}
+
+	Allocate(table.capacity); // выделяем память под корзины
+
+	for (int i = 0; i < capacity; i++) {
+		const Bucket& bucket = table.buckets[i];
+
+		if (bucket.head == nullptr)
+			continue;
+
+		for (int j = 0; j < bucket.count; j++)
+			Append(buckets[i], bucket.tags[j], bucket.head->keys[j], bucket.head->values[j]);
+
+		for (const Chunk *chunk = bucket.head->next; chunk != nullptr; chunk = chunk->next)
+			for (int j = 0; j < chunk->count; j++)
+				Append(buckets[i], chunk->tags[j], chunk->keys[j], chunk->values[j]);
+	}
+}
+
+// конструктор перемещения: таблица забирает массив и узлы, а перемещённой остаётся ноль корзин без выделенной памяти
+// (при первой вставке превышение коэффициента заполнения перестраивает таблицу)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+BucketChainingTable<K, T, Hash, KeyEqual>::BucketChainingTable(BucketChainingTable&& table) noexcept : chunks(table.chunks), hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = 0;
+	size = 0;
+	maxLoadFactor = table.maxLoadFactor;
+	buckets = nullptr;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash, typename KeyEqual>
+BucketChainingTable<K, T, Hash, KeyEqual>& BucketChainingTable<K, T, Hash, KeyEqual>::operator=(BucketChainingTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void BucketChainingTable<K, T, Hash, KeyEqual>::Swap(BucketChainingTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(size, table.size);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(buckets, table.buckets);
+	chunks.Swap(table.chunks); // звенья остаются на месте, меняется только владелец памяти
+	swap(hasher, table.hasher);
+	swap(keyEqual, table.keyEqual);
+}
+
+// поиск элемента (ложь, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+bool BucketChainingTable<K, T, Hash, KeyEqual>::Locate(const Key& key, uint64_t hash, Entry& entry) const {
+	if (capacity == 0)
+		return false; // у перемещённой таблицы нет корзин
+
+	Bucket& bucket = buckets[hash % capacity];
+	unsigned char tag = Tag(hash);
+	Chunk *head = bucket.head;
+
+	if (head == nullptr)
+		return false; // корзина пуста
+
+	// сначала сравниваем отпечатки первого звена, хранящиеся в самой корзине, и переходим к звену только при совпадении
+	for (int i = 0; i < bucket.count; i++) {
+		if (bucket.tags[i] == tag && keyEqual(head->keys[i], key)) {
+			entry = { &bucket.tags[i], &head->keys[i], &head->values[i] };
+			return true;
+		}
+	}
+
+	// остальные звенья есть только при заполненном первом звене
+	if (bucket.count < CHUNK_SIZE)
+		return false;
+
+	for (Chunk *chunk = head->next; chunk != nullptr; chunk = chunk->next) {
+		for (int i = 0; i < chunk->count; i++) {
+			if (chunk->tags[i] == tag && keyEqual(chunk->keys[i], key)) {
+				entry = { &chunk->tags[i], &chunk->keys[i], &chunk->values[i] };
+				return true;
+			}
+		}
+	}
+
+	return false; // не нашли
+}
+
+// хеш ключа с предварительной загрузкой корзины в кеш
+template <typename K, typename T, typename Hash, typename KeyEqual>
+uint64_t BucketChainingTable<K, T, Hash, KeyEqual>::PrefetchKey(const K& key) const {
+	uint64_t hash = hasher(key);
+
+	if (capacity > 0) // у перемещённой таблицы нет корзин
+		__builtin_prefetch(buckets + hash % capacity);
+
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual>
+const T* BucketChainingTable<K, T, Hash, KeyEqual>::FindHashed(const K& key, uint64_t hash) const {
+	Entry entry;
+
+	return Locate(key, hash, entry) ? entry.value : nullptr;
+}
+
+// добавление элемента в конец корзины
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename KeyArg, typename ValueArg>
+T* BucketChainingTable<K, T, Hash, KeyEqual>::Append(Bucket& bucket, unsigned char tag, KeyArg&& key, ValueArg&& value) {
+	if (bucket.head == nullptr)
+		bucket.head = NewChunk();
+
+	Chunk *head = bucket.head;
+
+	// пока в первом звене есть место, элемент хранится в нём
+	if (bucket.count < CHUNK_SIZE) {
+		int slot = bucket.count++;
+
+		bucket.tags[slot] = tag;
+		head->keys[slot] = forward<KeyArg>(key);
+		head->values[slot] = forward<ValueArg>(value);
+
+		return &head->values[slot];
+	}
+
+	Chunk *chunk = head->next;
+
+	// если второе звено заполнено, то вставляем новое звено сразу за первым
+	if (chunk == nullptr || chunk->count == CHUNK_SIZE) {
+		chunk = NewChunk();
+		chunk->next = head->next;
+		head->next = chunk;
+	}
+
+	int slot = chunk->count++;
+
+	chunk->tags[slot] = tag;
+	chunk->keys[slot] = forward<KeyArg>(key);
+	chunk->values[slot] = forward<ValueArg>(value);
+
+	return &chunk->values[slot];
+}
+
+// создание пустого звена
+template <typename K, typename T, typename Hash, typename KeyEqual>
+typename BucketChainingTable<K, T, Hash, KeyEqual>::Chunk* BucketChainingTable<K, T, Hash, KeyEqual>::NewChunk() {
+	Chunk *chunk = new (chunks.Allocate()) Chunk();
+	chunk->count = 0;
+	chunk->next = nullptr;
+
+	return chunk;
+}
+
+// освобождение цепочки корзины
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void BucketChainingTable<K, T, Hash, KeyEqual>::FreeChunks(Bucket& bucket) {
+	while (bucket.head != nullptr) {
+		Chunk *chunk = bucket.head;
+		bucket.head = chunk->next;
+
+		chunk->~Chunk();
+		chunks.Deallocate(chunk);
+	}
+
+	bucket.count = 0;
+}
+
+// выделение памяти под корзины
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void BucketChainingTable<K, T, Hash, KeyEqual>::Allocate(int newCapacity) {
+	capacity = max(1, newCapacity);
+	buckets = new Bucket[capacity];
+
+	for (int i = 0; i < capacity; i++) {
+		buckets[i].count = 0;
+		buckets[i].head = nullptr;
+	}
+}
+
+// перестроение таблицы
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void BucketChainingTable<K, T, Hash, KeyEqual>::Rebuild(int newCapacity) {
+	Bucket *prevBuckets = buckets; // запоминаем текущий массив
+	int prevCapacity = capacity;
+
+	Allocate(newCapacity); // выделяем память под новый массив
+
+	// переносим элементы, отпечатки зависят от числа корзин и вычисляются заново
+	for (int i = 0; i < prevCapacity; i++) {
+		Bucket& bucket = prevBuckets[i];
+
+		if (bucket.head == nullptr)
+			continue;
+
+		for (int j = 0; j < bucket.count; j++) {
+			uint64_t hash = hasher(bucket.head->keys[j]);
+			Append(buckets[hash % capacity], Tag(hash), move(bucket.head->keys[j]), move(bucket.head->values[j]));
+		}
+
+		for (Chunk *chunk = bucket.head->next; chunk != nullptr; chunk = chunk->next) {
+			for (int j = 0; j < chunk->count; j++) {
+				uint64_t hash = hasher(chunk->keys[j]);
+				Append(buckets[hash % capacity], Tag(hash), move(chunk->keys[j]), move(chunk->values[j]));
+			}
+		}
+
+		FreeChunks(bucket);
+	}
+
+	delete[] prevBuckets;
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename KeyArg, typename ValueArg>
+pair<T*, bool> BucketChainingTable<K, T, Hash, KeyEqual>::Emplace(KeyArg&& key, ValueArg&& value, bool assign) {
+	uint64_t hash = hasher(key);
+	Entry entry;
+
+	if (Locate(key, hash, entry)) {
+		if (assign)
+			*entry.value = forward<ValueArg>(value); // обновляем значение на месте
+
+		return make_pair(entry.value, false);
+	}
+
+	// если после вставки будет превышен коэффициент заполнения, то удваиваем число корзин
+	if (size + 1 > maxLoadFactor * capacity)
+		Rebuild(capacity * 2);
+
+	size++; // увеличиваем счётчик числа элементов
+
+	return make_pair(Append(buckets[hash % capacity], Tag(hash), forward<KeyArg>(key), forward<ValueArg>(value)), true);
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void BucketChainingTable<K, T, Hash, KeyEqual>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool BucketChainingTable<K, T, Hash, KeyEqual>::Remove(const K& key) {
+	uint64_t hash = hasher(key);
+	Entry entry;
+
+	if (!Locate(key, hash, entry))
+		return false; // не нашли, возвращаем ложь
+
+	Bucket& bucket = buckets[hash % capacity];
+	Chunk *head = bucket.head;
+	Chunk *tail = head->next; // частично заполненное звено, если первое звено заполнено
+
+	// последний элемент корзины лежит во втором звене или, если его нет, в первом
+	int last = tail != nullptr ? tail->count - 1 : bucket.count - 1;
+	Entry end = tail != nullptr ? Entry { &tail->tags[last], &tail->keys[last], &tail->values[last] } : Entry { &bucket.tags[last], &head->keys[last], &head->values[last] };
+
+	// переносим последний элемент на место удаляемого, чтобы элементы оставались подряд
+	if (entry.key != end.key) {
+		*entry.tag = *end.tag;
+		*entry.key = move(*end.key);
+		*entry.value = move(*end.value);
+	}
+
+	// опустевшее звено освобождаем
+	if (tail != nullptr) {
+		if (--tail->count == 0) {
+			head->next = tail->next;
+			tail->~Chunk();
+			chunks.Deallocate(tail);
+		}
+	}
+	else if (--bucket.count == 0) {
+		bucket.head = nullptr;
+		head->~Chunk();
+		chunks.Deallocate(head);
+	}
+
+	size--; // уменьшаем счётчик числа элементов
+
+	return true; // возвращаем истину
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool BucketChainingTable<K, T, Hash, KeyEqual>::Find(const K& key) const {
+	Entry entry;
+
+	return Locate(key, hasher(key), entry);
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void BucketChainingTable<K, T, Hash, KeyEqual>::Clear() {
+	// если звеньям не нужны деструкторы, то освобождаем память целыми блоками, не обходя цепочки
+	if constexpr (is_trivially_destructible<Chunk>::value) {
+		chunks.Release();
+
+		for (int i = 0; i < capacity; i++) {
+			buckets[i].count = 0;
+			buckets[i].head = nullptr;
+		}
+	}
+	else {
+		for (int i = 0; i < capacity; i++)
+			FreeChunks(buckets[i]);
+	}
+
+	size = 0; // обнуляем счётчик числа элементов
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int BucketChainingTable<K, T, Hash, KeyEqual>::GetSize() const {
+	return size; // возвращаем размер
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool BucketChainingTable<K, T, Hash, KeyEqual>::IsEmpty() const {
+	return size == 0; // таблица пуста, если нет элементов
+}
+
+// получение значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T BucketChainingTable<K, T, Hash, KeyEqual>::Get(const K& key) const {
+	Entry entry;
+
+	if (!Locate(key, hasher(key), entry))
+		throw string("No value with this key"); // бросаем исключение
+
+	return *entry.value; // возвращаем значение
+}
+
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T* BucketChainingTable<K, T, Hash, KeyEqual>::FindPtr(const K& key) {
+	Entry entry;
+
+	return Locate(key, hasher(key), entry) ? entry.value : nullptr;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+const T* BucketChainingTable<K, T, Hash, KeyEqual>::FindPtr(const K& key) const {
+	Entry entry;
+
+	return Locate(key, hasher(key), entry) ? entry.value : nullptr;
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> BucketChainingTable<K, T, Hash, KeyEqual>::TryEmplace(K key, T value) {
+	return Emplace(move(key), move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> BucketChainingTable<K, T, Hash, KeyEqual>::InsertOrAssign(K key, T value) {
+	return Emplace(move(key), move(value), true);
+}
+
+// деструктор (освобождения памяти)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+BucketChainingTable<K, T, Hash, KeyEqual>::~BucketChainingTable() {
+	Clear(); // удаляем все звенья
+
+	delete[] buckets; // удаляем массив корзин
+}
+
+// статистика заполнения и длин поиска (длина поиска - число загружаемых звеньев)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+TableStats BucketChainingTable<K, T, Hash, KeyEqual>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+
+	int chunkTotal = 0; // число звеньев всех корзин
+
+	for (int i = 0; i < capacity; i++) {
+		const Bucket& bucket = buckets[i];
+		int length = bucket.count; // число элементов корзины
+		int chunkCount = 1; // номер звена
+
+		for (int j = 0; j < bucket.count; j++)
+			stats.AddHit(1);
+
+		for (const Chunk *chunk = bucket.head ? bucket.head->next : nullptr; chunk != nullptr; chunk = chunk->next) {
+			chunkCount++;
+			length += chunk->count;
+
+			for (int j = 0; j < chunk->count; j++)
+				stats.AddHit(chunkCount);
+		}
+
+		stats.AddChain(length);
+
+		if (bucket.head != nullptr)
+			chunkTotal += chunkCount;
+
+		// при неполном первом звене отсутствие ключа видно по отпечаткам корзины, иначе просматриваются остальные звенья
+		stats.AddMiss(bucket.count < CHUNK_SIZE ? 0 : chunkCount - 1);
+	}
+
+	stats.bytes = sizeof(*this) + capacity * sizeof(Bucket) + chunks.Bytes(chunkTotal);
+	return stats;
+}
+
+// оператор вывода в поток
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void BucketChainingTable<K, T, Hash, KeyEqual>::Print() const {
+    for (int i = 0; i < capacity; i++) {
+		const Bucket& bucket = buckets[i];
+
+		if (bucket.head == nullptr)
+			continue; // если корзина пуста, то переходим к следующей
+
+		cout << "[" << i << "]: "; // выводим номер корзины
+
+		for (int j = 0; j < bucket.count; j++)
+			cout << bucket.head->values[j] << "(" << bucket.head->keys[j] << ") ";
+
+		for (const Chunk *chunk = bucket.head->next; chunk != nullptr; chunk = chunk->next)
+			for (int j = 0; j < chunk->count; j++)
+				cout << chunk->values[j] << "(" << chunk->keys[j] << ") ";
+
+		cout << endl;
+	}
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void swap(BucketChainingTable<K, T, Hash, KeyEqual>& table1, BucketChainingTable<K, T, Hash, KeyEqual>& table2) {
+	table1.Swap(table2);
+}
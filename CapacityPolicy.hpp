@@ -0,0 +1,116 @@
+#pragma once
+
+#include <string>
+#include <climits>
+#include <cstdint>
+#include <numeric>
+#include "HashFunctions.hpp"
+
+/*
+	Способы выбора ёмкости таблиц с открытой адресацией и приведения хеша к индексу
+	Round - допустимая ёмкость, не меньшая заданной (запрошенная ёмкость передаётся в 64 битах,
+	чтобы удвоение не переполняло int, а недостижимая ёмкость приводит к исключению)
+	Index - начальная ячейка по значению хеш-функции
+	Step - шаг пробирования в диапазоне [1, capacity) по значению хеш-функции, взаимно простой с ёмкостью
+*/
+
+// ближайший не меньший остатка шаг, взаимно простой с ёмкостью: такой шаг обходит все ячейки массива
+// (после удвоения ёмкость становится чётной, и чётный шаг просматривал бы только часть ячеек)
+inline int CoprimeStep(uint64_t value, int capacity) {
+	if (capacity < 2)
+		return 1; // в массиве не больше одной ячейки (или нет массива у перемещённой таблицы)
+
+	int step = value % capacity;
+
+	if (step == 0)
+		step = 1; // нулевой шаг не сдвигает пробную последовательность
+
+	while (step > 1 && std::gcd(step, capacity) != 1)
+		step++;
+
+	return step;
+}
+
+// произвольная ёмкость, индекс - остаток от деления
+struct ModuloCapacity {
+	static int Round(int64_t capacity) {
+		if (capacity > INT_MAX)
+			throw std::string("Table capacity is too large");
+
+		return capacity;
+	}
+
+	static int Index(uint64_t hash, int capacity) {
+		return hash % capacity;
+	}
+
+	static int Step(uint64_t hash, int capacity) {
+		return CoprimeStep(hash, capacity);
+	}
+};
+
+// ёмкость - степень двойки, индекс - младшие биты перемешанного хеша
+struct PowerOfTwoCapacity {
+	static const int MAX_CAPACITY = 1 << 30; // наибольшая степень двойки, представимая в int
+
+	static int Round(int64_t capacity) {
+		if (capacity > MAX_CAPACITY)
+			throw std::string("Table capacity is too large");
+
+		int rounded = 1;
+
+		while (rounded < capacity)
+			rounded *= 2;
+
+		return rounded;
+	}
+
+	// хеш перемешивается, чтобы хеш-функции вида key не давали кластеров
+	static int Index(uint64_t hash, int capacity) {
+		return MixHash(hash) & (capacity - 1);
+	}
+
+	// нечётный шаг взаимно прост с ёмкостью и обходит все ячейки
+	static int Step(uint64_t hash, int capacity) {
+		return (MixHash(hash) & (capacity - 1)) | 1;
+	}
+};
+
+// ёмкость - простое число, индекс - старшие биты произведения перемешанного хеша на ёмкость (fastrange)
+struct PrimeCapacity {
+	// INT_MAX - простое число, поэтому поиск не выходит за пределы int
+	static int Round(int64_t capacity) {
+		if (capacity > INT_MAX)
+			throw std::string("Table capacity is too large");
+
+		int rounded = capacity < 2 ? 2 : capacity;
+
+		while (!IsPrime(rounded))
+			rounded++;
+
+		return rounded;
+	}
+
+	static int Index(uint64_t hash, int capacity) {
+		return FastRange(MixHash(hash), capacity);
+	}
+
+	// любой ненулевой шаг взаимно прост с простой ёмкостью
+	static int Step(uint64_t hash, int capacity) {
+		return capacity < 2 ? 1 : 1 + FastRange(MixHash(hash), capacity - 1);
+	}
+
+private:
+	// отображение 64-битного значения на [0, range) без деления
+	static int FastRange(uint64_t hash, int range) {
+		return ((unsigned __int128) hash * (uint64_t) range) >> 64;
+	}
+
+	static bool IsPrime(int value) {
+		for (int i = 2; (long long) i * i <= value; i++)
+			if (value % i == 0)
+				return false;
+
+		return value >= 2;
+	}
+};
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/*
+	Способы хранения ячеек таблиц с открытой адресацией
+	Хранилище - лёгкий дескриптор массива ячеек: копирование дескриптора
+	не копирует ячейки, память выделяется и освобождается таблицей явно
+	через Allocate и Free
+	Память выделяется обнулённой, а нулевое состояние означает свободную
+	ячейку, поэтому новый массив не нужно обходить: большие блоки система
+	отдаёт нулевыми страницами, которые не затрагиваются до первой записи
+	Ключи и значения не создаются конструктором по умолчанию: они существуют
+	только в занятых ячейках, создаются при записи элемента (Construct) и
+	уничтожаются при его удалении или переносе (Destroy)
+	Bytes - объём памяти массива заданной ёмкости
+*/
+
+// выделение обнулённой памяти под count объектов размера size
+inline void* AllocateZeroed(size_t count, size_t size) {
+	void *memory = calloc(count > 0 ? count : 1, size);
+
+	if (memory == nullptr)
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+// массив структур: ключ, значение и состояние ячейки лежат рядом
+template <typename K, typename T>
+class NodeStorage {
+    // ячейки не создаются и не уничтожаются целиком: ключ и значение в объединениях
+    // создаются и уничтожаются явно, только пока ячейка занята
+    struct HashNode {
+    	union { K key; }; // значение ключа элемента
+    	union { T value; }; // значение элемента
+    	int state; // состояние ячейки
+    };
+
+    HashNode *nodes; // массив ячеек
+
+public:
+    NodeStorage() : nodes(nullptr) {}
+
+    void Allocate(int capacity) { nodes = static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))); } // выделение памяти под свободные ячейки
+    void Free() { free(nodes); nodes = nullptr; } // освобождение памяти (элементы должны быть уже уничтожены)
+    bool IsAllocated() const { return nodes != nullptr; } // проверка выделения памяти
+    void Prefetch(int index) const { __builtin_prefetch(nodes + index); } // предварительная загрузка ячейки в кеш
+    static size_t Bytes(int capacity) { return capacity * sizeof(HashNode); } // объём памяти массива
+
+    int GetState(int index) const { return nodes[index].state; } // получение состояния ячейки
+    void SetState(int index, int state) { nodes[index].state = state; } // изменение состояния ячейки
+
+    // создание ключа и значения в ячейке
+    template <typename KeyArg, typename ValueArg>
+    void Construct(int index, KeyArg&& key, ValueArg&& value) {
+    	new (&nodes[index].key) K(std::forward<KeyArg>(key));
+
+    	try {
+    		new (&nodes[index].value) T(std::forward<ValueArg>(value));
+    	}
+    	catch (...) {
+    		nodes[index].key.~K();
+    		throw;
+    	}
+    }
+
+    // уничтожение ключа и значения ячейки
+    void Destroy(int index) {
+    	nodes[index].key.~K();
+    	nodes[index].value.~T();
+    }
+
+    K& Key(int index) { return nodes[index].key; } // ключ ячейки
+    const K& Key(int index) const { return nodes[index].key; }
+
+    T& Value(int index) { return nodes[index].value; } // значение ячейки
+    const T& Value(int index) const { return nodes[index].value; }
+};
+
+// структура массивов: состояния, ключи и значения хранятся в отдельных массивах,
+// поэтому при пробировании не загружаются в кеш значения элементов
+template <typename K, typename T>
+class SplitStorage {
+    unsigned char *states; // массив состояний ячеек
+    K *keys; // массив ключей
+    T *values; // массив значений
+
+public:
+    SplitStorage() : states(nullptr), keys(nullptr), values(nullptr) {}
+
+    // выделение памяти под свободные ячейки
+    void Allocate(int capacity) {
+    	unsigned char *newStates = static_cast<unsigned char*>(AllocateZeroed(capacity, 1));
+    	K *newKeys = nullptr;
+    	T *newValues = nullptr;
+
+    	// при нехватке памяти уже выделенные массивы освобождаются, а хранилище не меняется
+    	try {
+    		newKeys = static_cast<K*>(AllocateZeroed(capacity, sizeof(K)));
+    		newValues = static_cast<T*>(AllocateZeroed(capacity, sizeof(T)));
+    	}
+    	catch (...) {
+    		free(newStates);
+    		free(newKeys);
+    		throw;
+    	}
+
+    	states = newStates;
+    	keys = newKeys;
+    	values = newValues;
+    }
+
+    // освобождение памяти (элементы должны быть уже уничтожены)
+    void Free() {
+    	free(states);
+    	free(keys);
+    	free(values);
+
+    	states = nullptr;
+    	keys = nullptr;
+    	values = nullptr;
+    }
+
+    bool IsAllocated() const { return states != nullptr; } // проверка выделения памяти
+    static size_t Bytes(int capacity) { return capacity * (1 + sizeof(K) + sizeof(T)); } // объём памяти массивов
+
+    // предварительная загрузка состояния и ключа ячейки в кеш
+    void Prefetch(int index) const {
+    	__builtin_prefetch(states + index);
+    	__builtin_prefetch(keys + index);
+    }
+
+    int GetState(int index) const { return states[index]; } // получение состояния ячейки
+    void SetState(int index, int state) { states[index] = state; } // изменение состояния ячейки
+
+    // создание ключа и значения в ячейке
+    template <typename KeyArg, typename ValueArg>
+    void Construct(int index, KeyArg&& key, ValueArg&& value) {
+    	new (keys + index) K(std::forward<KeyArg>(key));
+
+    	try {
+    		new (values + index) T(std::forward<ValueArg>(value));
+    	}
+    	catch (...) {
+    		keys[index].~K();
+    		throw;
+    	}
+    }
+
+    // уничтожение ключа и значения ячейки
+    void Destroy(int index) {
+    	keys[index].~K();
+    	values[index].~T();
+    }
+
+    K& Key(int index) { return keys[index]; } // ключ ячейки
+    const K& Key(int index) const { return keys[index]; }
+
+    T& Value(int index) { return values[index]; } // значение ячейки
+    const T& Value(int index) const { return values[index]; }
+};
+
+// компактное хранение: состояния занимают по 2 бита и упакованы в 64-битные слова,
+// а ключ и значение ячейки лежат рядом без поля состояния и выравнивания под него
+// (для целых ключей и значений 8.25 байта на ячейку вместо 12)
+template <typename K, typename T>
+class PackedStorage {
+	static const int STATES_PER_WORD = 32; // число состояний в слове
+
+    // ключ и значение в объединениях создаются и уничтожаются явно, только пока ячейка занята
+    struct HashNode {
+    	union { K key; }; // значение ключа элемента
+    	union { T value; }; // значение элемента
+    };
+
+    uint64_t *states; // упакованные состояния ячеек
+    HashNode *nodes; // массив ключей и значений
+
+    static int Words(int capacity) { return (capacity + STATES_PER_WORD - 1) / STATES_PER_WORD; } // число слов состояний
+
+public:
+    PackedStorage() : states(nullptr), nodes(nullptr) {}
+
+    // выделение памяти под свободные ячейки
+    void Allocate(int capacity) {
+    	uint64_t *newStates = static_cast<uint64_t*>(AllocateZeroed(Words(capacity), sizeof(uint64_t)));
+
+    	// при нехватке памяти массив состояний освобождается, а хранилище не меняется
+    	try {
+    		nodes = static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode)));
+    	}
+    	catch (...) {
+    		free(newStates);
+    		throw;
+    	}
+
+    	states = newStates;
+    }
+
+    // освобождение памяти (элементы должны быть уже уничтожены)
+    void Free() {
+    	free(states);
+    	free(nodes);
+
+    	states = nullptr;
+    	nodes = nullptr;
+    }
+
+    bool IsAllocated() const { return states != nullptr; } // проверка выделения памяти
+    static size_t Bytes(int capacity) { return Words(capacity) * sizeof(uint64_t) + capacity * sizeof(HashNode); } // объём памяти массивов
+
+    // предварительная загрузка состояния и ячейки в кеш
+    void Prefetch(int index) const {
+    	__builtin_prefetch(states + index / STATES_PER_WORD);
+    	__builtin_prefetch(nodes + index);
+    }
+
+    // получение состояния ячейки
+    int GetState(int index) const {
+    	return (states[index / STATES_PER_WORD] >> (index % STATES_PER_WORD * 2)) & 3;
+    }
+
+    // изменение состояния ячейки
+    void SetState(int index, int state) {
+    	uint64_t& word = states[index / STATES_PER_WORD];
+    	int shift = index % STATES_PER_WORD * 2;
+
+    	word = (word & ~(3ull << shift)) | ((uint64_t) state << shift);
+    }
+
+    // создание ключа и значения в ячейке
+    template <typename KeyArg, typename ValueArg>
+    void Construct(int index, KeyArg&& key, ValueArg&& value) {
+    	new (&nodes[index].key) K(std::forward<KeyArg>(key));
+
+    	try {
+    		new (&nodes[index].value) T(std::forward<ValueArg>(value));
+    	}
+    	catch (...) {
+    		nodes[index].key.~K();
+    		throw;
+    	}
+    }
+
+    // уничтожение ключа и значения ячейки
+    void Destroy(int index) {
+    	nodes[index].key.~K();
+    	nodes[index].value.~T();
+    }
+
+    K& Key(int index) { return nodes[index].key; } // ключ ячейки
+    const K& Key(int index) const { return nodes[index].key; }
+
+    T& Value(int index) { return nodes[index].value; } // значение ячейки
+    const T& Value(int index) const { return nodes[index].value; }
+};
@@ -0,0 +1,740 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#include "CellStorage.hpp"
+#include "HashTable.h"
+#include "HashFunctions.hpp"
+
+using namespace std;
+
+/*
+	Хеш таблица на основе кукушкиного хеширования с корзинами
+	Каждый ключ может находиться только в одной из двух корзин, выбираемых двумя
+	хеш-функциями, а корзина содержит несколько ячеек и выровнена по строке кеша,
+	поэтому поиск (в том числе неуспешный) просматривает не более двух корзин.
+	Если обе корзины заполнены, то поиском в ширину находится кратчайший путь
+	вытеснения: элементы по цепочке переносятся в свои альтернативные корзины, пока
+	одна из корзин пути не окажется свободной. Элементы, для которых путь не нашёлся,
+	попадают в небольшой запас, который просматривается после обеих корзин, а при
+	переполнении запаса таблица перестраивается со сменой перемешивания хешей (и
+	удвоением числа корзин, если таблица заполнена больше чем наполовину)
+	Массив корзин выделяется обнулённым, и нулевая маска означает пустую корзину,
+	поэтому ключи и значения создаются только в занятых ячейках
+*/
+
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename KeyEqual = equal_to<K>>
+class CuckooTable final : public HashTable<K, T> {
+	static const int SLOTS = 4; // число ячеек в корзине
+	static const unsigned FULL = (1 << SLOTS) - 1; // маска заполненной корзины
+	static const int STASH_SIZE = 4; // начальный размер запаса
+	static const int MAX_SEARCH = 256; // максимальное число корзин, просматриваемых при поиске пути вытеснения
+
+    // ключ и значение в объединениях создаются и уничтожаются явно, только пока ячейка занята
+    struct Slot {
+    	union { K key; }; // значение ключа элемента
+    	union { T value; }; // значение элемента
+    };
+
+    // корзина выровнена по строке кеша: корзина небольших элементов загружается одним обращением к памяти
+    struct alignas(64) Bucket {
+    	Slot slots[SLOTS]; // ячейки корзины
+    	unsigned char used; // маска занятых ячеек
+    };
+
+    // вершина поиска пути вытеснения в ширину
+    struct KickStep {
+    	int bucket; // корзина
+    	int parent; // вершина, из корзины которой элемент переносится в эту корзину (-1 для корзин нового ключа)
+    	int slot; // ячейка переносимого элемента в корзине вершины parent
+    };
+
+    int bucketCount; // число корзин
+    int size; // число элементов в таблице
+    double maxLoadFactor; // максимальный коэффициент заполнения
+
+    void *memory; // выделенная память (массив корзин выровнен внутри неё)
+    Bucket *buckets; // массив корзин
+
+    vector<pair<K, T>> stash; // запас элементов, для которых не нашлось места в корзинах
+    int stashLimit; // размер запаса, при превышении которого таблица перестраивается
+    uint64_t seed; // перемешивание хешей (меняется при перестроении)
+
+    Hash hasher1; // первая хеш-функция
+    Hash hasher2; // вторая хеш-функция
+    KeyEqual keyEqual; // сравнение ключей
+
+    int First(uint64_t hash1) const; // первая корзина ключа
+    int Second(uint64_t hash1, uint64_t hash2) const; // вторая корзина ключа
+    int Alternative(const K& key, int bucket) const; // другая корзина элемента, находящегося в корзине bucket (-1, если корзины совпадают)
+
+    template <typename Key>
+    int FindSlot(const Bucket& bucket, const Key& key) const; // поиск ячейки с ключом в корзине (-1, если нет)
+    int FreeSlot(const Bucket& bucket) const; // первая свободная ячейка корзины (-1, если корзина заполнена)
+    template <typename Key>
+    int FindStashed(const Key& key) const; // поиск индекса элемента в запасе (-1, если нет)
+
+    template <typename Key>
+    const T* FindValue(const Key& key) const; // поиск значения в корзинах и запасе (nullptr, если нет)
+    template <typename Key>
+    const T* FindValue(const Key& key, uint64_t hash1) const;
+
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой первой корзины в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+
+    bool OnPath(const KickStep *steps, int step, int bucket) const; // проверка, что корзина уже входит в путь до вершины step
+    bool MakeRoom(int first, int second, int& bucket, int& slot); // освобождение ячейки в одной из корзин вытеснением (ложь, если путь не найден)
+    void Construct(int bucket, int slot, K&& key, T&& value); // создание элемента в свободной ячейке
+    void Destroy(int bucket, int slot); // уничтожение элемента ячейки
+    T* PlaceInBuckets(K& key, T& value, uint64_t hash1, uint64_t hash2); // запись элемента в корзину (nullptr, если путь вытеснения не найден)
+    T* Place(K key, T value, uint64_t hash1, uint64_t hash2); // запись элемента в корзину или запас (указатель на значение)
+    void Unstash(); // перенос элементов запаса в освободившиеся ячейки их корзин
+    pair<T*, bool> Emplace(K key, T value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+    void Rebuild(int newBucketCount); // перестроение таблицы со сменой перемешивания хешей
+    void Allocate(); // выделение памяти под пустые корзины
+    void Release(); // уничтожение элементов и освобождение памяти
+
+public:
+    CuckooTable(int tableSize, const Hash& hasher1 = Hash(), const Hash& hasher2 = Hash(), double maxLoadFactor = 0.9, const KeyEqual& keyEqual = KeyEqual()); // конструктор из размера, хеш-функций, коэффициента заполнения и сравнения ключей
+    CuckooTable(int tableSize, int (*h1)(K), int (*h2)(K), double maxLoadFactor = 0.9); // конструктор из размера, указателей на хеш-функции и коэффициента заполнения
+    CuckooTable(const CuckooTable& table); // конструктор копирования
+    CuckooTable(CuckooTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    CuckooTable& operator=(CuckooTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(CuckooTable& table) noexcept; // обмен содержимым таблиц за O(1)
+
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
+    bool Remove(const K& key); // удаление по ключу
+    bool Find(const K& key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+
+    T Get(const K& key) const; // получение значения по ключу
+
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    // поиск по ключу другого типа при прозрачных хеш-функции и сравнении ключей
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    T* FindPtr(const Key& key) { return const_cast<T*>(FindValue(key)); }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    const T* FindPtr(const Key& key) const { return FindValue(key); }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    bool Find(const Key& key) const { return FindValue(key) != nullptr; }
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Print() const; // вывод таблицы
+
+    ~CuckooTable(); // деструктор (освобождение памяти)
+};
+
+// конструктор из размера, хеш-функций, коэффициента заполнения и сравнения ключей
+template <typename K, typename T, typename Hash, typename KeyEqual>
+CuckooTable<K, T, Hash, KeyEqual>::CuckooTable(int tableSize, const Hash& hasher1, const Hash& hasher2, double maxLoadFactor, const KeyEqual& keyEqual) : hasher1(hasher1), hasher2(hasher2), keyEqual(keyEqual) {
+	this->bucketCount = max(1, (tableSize + SLOTS - 1) / SLOTS); // переданный размер - число ячеек
+	this->size = 0; // изначально нет элементов
+	this->maxLoadFactor = maxLoadFactor;
+	this->stashLimit = STASH_SIZE;
+	this->seed = 0;
+
+	Allocate(); // выделяем память под корзины (все корзины сразу пусты)
+}
+
+// конструктор из размера, указателей на хеш-функции и коэффициента заполнения
+template <typename K, typename T, typename Hash, typename KeyEqual>
+CuckooTable<K, T, Hash, KeyEqual>::CuckooTable(int tableSize, int (*h1)(K), int (*h2)(K), double maxLoadFactor) : CuckooTable(tableSize, Hash(h1), Hash(h2), maxLoadFactor) {
+}
+
+// конструктор копирования
+template <typename K, typename T, typename Hash, typename KeyEqual>
+CuckooTable<K, T, Hash, KeyEqual>::CuckooTable(const CuckooTable& table) : stash(table.stash), hasher1(table.hasher1), hasher2(table.hasher2), keyEqual(table.keyEqual) {
+	bucketCount = table.bucketCount; // копируем число корзин
+	size = table.size; // копируем количество элементов
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
+	stashLimit = table.stashLimit;
+	seed = table.seed; // элементы остаются в тех же корзинах только при том же перемешивании
+
+	Allocate(); // выделяем память под массив (у перемещённой таблицы его нет)
+
+	// копируем занятые ячейки всех корзин
+	for (int i = 0; i < bucketCount; i++) {
+		for (unsigned mask = table.buckets[i].used; mask; mask &= mask - 1) {
+			int slot = __builtin_ctz(mask);
+
+			new (&buckets[i].slots[slot].key) K(table.buckets[i].slots[slot].key);
+			new (&buckets[i].slots[slot].value) T(table.buckets[i].slots[slot].value);
+		}
+
+		buckets[i].used = table.buckets[i].used;
+	}
+}
+
+// конструктор перемещения: таблица забирает массивы, а перемещённой остаются ноль корзин без выделенной памяти
+// (корзины выделяются при следующей вставке)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+CuckooTable<K, T, Hash, KeyEqual>::CuckooTable(CuckooTable&& table) noexcept : hasher1(table.hasher1), hasher2(table.hasher2), keyEqual(table.keyEqual) {
+	bucketCount = 0;
+	size = 0;
+	maxLoadFactor = table.maxLoadFactor;
+	memory = nullptr;
+	buckets = nullptr;
+	stashLimit = STASH_SIZE;
+	seed = 0;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash, typename KeyEqual>
+CuckooTable<K, T, Hash, KeyEqual>& CuckooTable<K, T, Hash, KeyEqual>::operator=(CuckooTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Swap(CuckooTable& table) noexcept {
+	swap(bucketCount, table.bucketCount);
+	swap(size, table.size);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(memory, table.memory);
+	swap(buckets, table.buckets);
+	stash.swap(table.stash);
+	swap(stashLimit, table.stashLimit);
+	swap(seed, table.seed);
+	swap(hasher1, table.hasher1);
+	swap(hasher2, table.hasher2);
+	swap(keyEqual, table.keyEqual);
+}
+
+// первая корзина ключа: старшие биты перемешанного хеша умножением переводятся в номер корзины без деления
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int CuckooTable<K, T, Hash, KeyEqual>::First(uint64_t hash1) const {
+	return ((MixHash(hash1 ^ seed) >> 32) * bucketCount) >> 32;
+}
+
+// вторая корзина ключа: зависит от обоих хешей, поэтому корзины различаются и при одинаковых хеш-функциях
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int CuckooTable<K, T, Hash, KeyEqual>::Second(uint64_t hash1, uint64_t hash2) const {
+	return ((MixHash(hash1 ^ SplitMix(hash2 ^ seed)) >> 32) * bucketCount) >> 32;
+}
+
+// другая корзина элемента, находящегося в корзине bucket (-1, если корзины совпадают)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int CuckooTable<K, T, Hash, KeyEqual>::Alternative(const K& key, int bucket) const {
+	uint64_t hash1 = hasher1(key);
+	int first = First(hash1);
+	int second = Second(hash1, hasher2(key));
+
+	if (first == second)
+		return -1;
+
+	return first == bucket ? second : first;
+}
+
+// поиск ячейки с ключом в корзине (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+int CuckooTable<K, T, Hash, KeyEqual>::FindSlot(const Bucket& bucket, const Key& key) const {
+	for (unsigned mask = bucket.used; mask; mask &= mask - 1) {
+		int slot = __builtin_ctz(mask);
+
+		if (keyEqual(bucket.slots[slot].key, key))
+			return slot;
+	}
+
+	return -1;
+}
+
+// первая свободная ячейка корзины (-1, если корзина заполнена)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int CuckooTable<K, T, Hash, KeyEqual>::FreeSlot(const Bucket& bucket) const {
+	unsigned free = ~bucket.used & FULL;
+
+	return free ? __builtin_ctz(free) : -1;
+}
+
+// поиск индекса элемента в запасе (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+int CuckooTable<K, T, Hash, KeyEqual>::FindStashed(const Key& key) const {
+	for (size_t i = 0; i < stash.size(); i++)
+		if (keyEqual(stash[i].first, key))
+			return i;
+
+	return -1;
+}
+
+// поиск значения в корзинах и запасе (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+const T* CuckooTable<K, T, Hash, KeyEqual>::FindValue(const Key& key) const {
+	return FindValue(key, hasher1(key));
+}
+
+// вторая хеш-функция вычисляется, только если ключа нет в первой корзине
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+const T* CuckooTable<K, T, Hash, KeyEqual>::FindValue(const Key& key, uint64_t hash1) const {
+	if (bucketCount == 0)
+		return nullptr; // у перемещённой таблицы нет корзин
+
+	const Bucket& first = buckets[First(hash1)];
+	int slot = FindSlot(first, key);
+
+	if (slot != -1)
+		return &first.slots[slot].value;
+
+	const Bucket& second = buckets[Second(hash1, hasher2(key))];
+	slot = FindSlot(second, key);
+
+	if (slot != -1)
+		return &second.slots[slot].value;
+
+	int index = FindStashed(key);
+
+	return index == -1 ? nullptr : &stash[index].second;
+}
+
+// хеш ключа с предварительной загрузкой первой корзины в кеш
+template <typename K, typename T, typename Hash, typename KeyEqual>
+uint64_t CuckooTable<K, T, Hash, KeyEqual>::PrefetchKey(const K& key) const {
+	uint64_t hash1 = hasher1(key);
+
+	if (bucketCount > 0) // у перемещённой таблицы нет корзин
+		__builtin_prefetch(buckets + First(hash1));
+
+	return hash1;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual>
+const T* CuckooTable<K, T, Hash, KeyEqual>::FindHashed(const K& key, uint64_t hash) const {
+	return FindValue(key, hash);
+}
+
+// проверка, что корзина уже входит в путь до вершины step
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool CuckooTable<K, T, Hash, KeyEqual>::OnPath(const KickStep *steps, int step, int bucket) const {
+	for (; step != -1; step = steps[step].parent)
+		if (steps[step].bucket == bucket)
+			return true;
+
+	return false;
+}
+
+// освобождение ячейки в одной из корзин вытеснением (ложь, если путь не найден)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool CuckooTable<K, T, Hash, KeyEqual>::MakeRoom(int first, int second, int& bucket, int& slot) {
+	KickStep steps[MAX_SEARCH]; // вершины поиска в ширину
+	int count = 0;
+
+	// сначала проверяем корзины самого ключа
+	for (int index : { first, second }) {
+		slot = FreeSlot(buckets[index]);
+
+		if (slot != -1) {
+			bucket = index;
+			return true;
+		}
+
+		if (count == 0 || index != steps[0].bucket)
+			steps[count++] = { index, -1, -1 };
+	}
+
+	for (int step = 0; step < count; step++) {
+		const Bucket& current = buckets[steps[step].bucket]; // корзина заполнена, иначе путь был бы найден раньше
+
+		for (int i = 0; i < SLOTS && count < MAX_SEARCH; i++) {
+			int next = Alternative(current.slots[i].key, steps[step].bucket);
+
+			// путь не должен проходить через одну корзину дважды, иначе один элемент будет перенесён два раза
+			if (next == -1 || OnPath(steps, step, next))
+				continue;
+
+			steps[count] = { next, step, i };
+			int free = FreeSlot(buckets[next]);
+
+			if (free == -1) {
+				count++;
+				continue;
+			}
+
+			// переносим элементы по пути с конца: каждый элемент занимает ячейку, освобождённую следующим
+			for (int index = count; steps[index].parent != -1; index = steps[index].parent) {
+				Bucket& from = buckets[steps[steps[index].parent].bucket];
+				int moved = steps[index].slot;
+
+				Construct(steps[index].bucket, free, move(from.slots[moved].key), move(from.slots[moved].value));
+				Destroy(steps[steps[index].parent].bucket, moved);
+				free = moved;
+			}
+
+			int root = step; // освободившаяся ячейка находится в корзине нового ключа, с которой начался путь
+
+			while (steps[root].parent != -1)
+				root = steps[root].parent;
+
+			bucket = steps[root].bucket;
+			slot = free;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// создание элемента в свободной ячейке
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Construct(int bucket, int slot, K&& key, T&& value) {
+	new (&buckets[bucket].slots[slot].key) K(move(key));
+
+	try {
+		new (&buckets[bucket].slots[slot].value) T(move(value));
+	}
+	catch (...) {
+		buckets[bucket].slots[slot].key.~K();
+		throw;
+	}
+
+	buckets[bucket].used |= 1 << slot;
+}
+
+// уничтожение элемента ячейки
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Destroy(int bucket, int slot) {
+	buckets[bucket].slots[slot].key.~K();
+	buckets[bucket].slots[slot].value.~T();
+	buckets[bucket].used &= ~(1 << slot);
+}
+
+// запись элемента в корзину (nullptr, если путь вытеснения не найден)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T* CuckooTable<K, T, Hash, KeyEqual>::PlaceInBuckets(K& key, T& value, uint64_t hash1, uint64_t hash2) {
+	int bucket, slot;
+
+	if (!MakeRoom(First(hash1), Second(hash1, hash2), bucket, slot))
+		return nullptr;
+
+	Construct(bucket, slot, move(key), move(value));
+	return &buckets[bucket].slots[slot].value;
+}
+
+// запись элемента в корзину или запас (указатель на значение)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T* CuckooTable<K, T, Hash, KeyEqual>::Place(K key, T value, uint64_t hash1, uint64_t hash2) {
+	while (true) {
+		T *placed = PlaceInBuckets(key, value, hash1, hash2);
+
+		if (placed != nullptr)
+			return placed;
+
+		if ((int) stash.size() < stashLimit) {
+			stash.emplace_back(move(key), move(value));
+			return &stash.back().second;
+		}
+
+		// при невысоком заполнении достаточно сменить перемешивание хешей
+		Rebuild(size + 1 > bucketCount * SLOTS / 2 ? bucketCount * 2 : bucketCount);
+	}
+}
+
+// перенос элементов запаса в освободившиеся ячейки их корзин
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Unstash() {
+	for (int i = stash.size() - 1; i >= 0; i--) {
+		uint64_t hash1 = hasher1(stash[i].first);
+
+		for (int bucket : { First(hash1), Second(hash1, hasher2(stash[i].first)) }) {
+			int slot = FreeSlot(buckets[bucket]);
+
+			if (slot != -1) {
+				Construct(bucket, slot, move(stash[i].first), move(stash[i].second));
+				stash.erase(stash.begin() + i);
+				break;
+			}
+		}
+	}
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> CuckooTable<K, T, Hash, KeyEqual>::Emplace(K key, T value, bool assign) {
+	// у перемещённой таблицы корзины выделяются только при первой вставке
+	if (bucketCount == 0) {
+		bucketCount = 1;
+
+		try {
+			Allocate();
+		}
+		catch (...) {
+			bucketCount = 0; // при нехватке памяти таблица остаётся без корзин
+			throw;
+		}
+	}
+
+	uint64_t hash1 = hasher1(key);
+	uint64_t hash2 = hasher2(key);
+	T *found = nullptr;
+
+	// ключ может находиться только в двух корзинах или в запасе
+	for (int bucket : { First(hash1), Second(hash1, hash2) }) {
+		int slot = FindSlot(buckets[bucket], key);
+
+		if (slot != -1) {
+			found = &buckets[bucket].slots[slot].value;
+			break;
+		}
+	}
+
+	if (found == nullptr) {
+		int index = FindStashed(key);
+
+		if (index != -1)
+			found = &stash[index].second;
+	}
+
+	if (found != nullptr) {
+		if (assign)
+			*found = move(value); // обновляем значение на месте
+
+		return make_pair(found, false);
+	}
+
+	// если после вставки будет превышен коэффициент заполнения, то удваиваем число корзин
+	if (size + 1 > maxLoadFactor * bucketCount * SLOTS)
+		Rebuild(bucketCount * 2);
+
+	T *placed = Place(move(key), move(value), hash1, hash2);
+	size++; // увеличиваем счётчик числа элементов
+
+	return make_pair(placed, true);
+}
+
+// перестроение таблицы со сменой перемешивания хешей
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Rebuild(int newBucketCount) {
+	void *prevMemory = memory; // запоминаем текущий массив
+	Bucket *prevBuckets = buckets;
+	int prevBucketCount = bucketCount;
+	vector<pair<K, T>> prevStash;
+	prevStash.swap(stash);
+
+	bucketCount = newBucketCount;
+	seed = SplitMix(seed); // новое перемешивание даёт ключам другие пары корзин
+	Allocate();
+
+	// элементы без пути вытеснения при перестроении остаются в запасе, каким бы большим он ни стал
+	auto place = [this](K& key, T& value) {
+		if (PlaceInBuckets(key, value, hasher1(key), hasher2(key)) == nullptr)
+			stash.emplace_back(move(key), move(value));
+	};
+
+	// перемещаем все элементы в новый массив
+	for (int i = 0; i < prevBucketCount; i++) {
+		for (unsigned mask = prevBuckets[i].used; mask; mask &= mask - 1) {
+			Slot& slot = prevBuckets[i].slots[__builtin_ctz(mask)];
+
+			place(slot.key, slot.value);
+			slot.key.~K();
+			slot.value.~T();
+		}
+	}
+
+	for (size_t i = 0; i < prevStash.size(); i++)
+		place(prevStash[i].first, prevStash[i].second);
+
+	int grown = stash.size() * 2; // после перестроения в запасе всегда остаётся место
+	stashLimit = grown > STASH_SIZE ? grown : STASH_SIZE;
+	free(prevMemory);
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool CuckooTable<K, T, Hash, KeyEqual>::Remove(const K& key) {
+	if (bucketCount == 0)
+		return false; // у перемещённой таблицы нет элементов
+
+	uint64_t hash1 = hasher1(key);
+	int bucket = First(hash1);
+	int slot = FindSlot(buckets[bucket], key);
+
+	if (slot == -1) {
+		bucket = Second(hash1, hasher2(key));
+		slot = FindSlot(buckets[bucket], key);
+	}
+
+	if (slot != -1) {
+		Destroy(bucket, slot);
+		size--; // уменьшаем счётчик числа элементов
+
+		if (!stash.empty())
+			Unstash(); // освободившаяся ячейка может принять элемент из запаса
+
+		return true;
+	}
+
+	int index = FindStashed(key);
+
+	if (index == -1)
+		return false; // не нашли, возвращаем ложь
+
+	stash.erase(stash.begin() + index);
+	size--;
+
+	return true;
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool CuckooTable<K, T, Hash, KeyEqual>::Find(const K& key) const {
+	return FindValue(key) != nullptr;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Clear() {
+	Release(); // вместо обхода корзин массив заменяется новым обнулённым
+	Allocate(); // у перемещённой таблицы корзин нет, и память не выделяется
+
+	stash.clear();
+	stashLimit = STASH_SIZE;
+	size = 0; // обнуляем счётчик числа элементов
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int CuckooTable<K, T, Hash, KeyEqual>::GetSize() const {
+	return size; // возвращаем размер
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool CuckooTable<K, T, Hash, KeyEqual>::IsEmpty() const {
+	return size == 0; // таблица пуста, если нет элементов
+}
+
+// получение значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T CuckooTable<K, T, Hash, KeyEqual>::Get(const K& key) const {
+	const T *value = FindValue(key);
+
+	if (value == nullptr)
+		throw string("No value with this key"); // бросаем исключение
+
+	return *value; // возвращаем значение
+}
+
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T* CuckooTable<K, T, Hash, KeyEqual>::FindPtr(const K& key) {
+	return const_cast<T*>(FindValue(key));
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+const T* CuckooTable<K, T, Hash, KeyEqual>::FindPtr(const K& key) const {
+	return FindValue(key);
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> CuckooTable<K, T, Hash, KeyEqual>::TryEmplace(K key, T value) {
+	return Emplace(move(key), move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> CuckooTable<K, T, Hash, KeyEqual>::InsertOrAssign(K key, T value) {
+	return Emplace(move(key), move(value), true);
+}
+
+// деструктор (освобождения памяти)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+CuckooTable<K, T, Hash, KeyEqual>::~CuckooTable() {
+	Release(); // удаляем массив корзин
+}
+
+// выделение памяти под пустые корзины: лишняя корзина оставляет место для выравнивания массива
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Allocate() {
+	if (bucketCount == 0) {
+		memory = nullptr;
+		buckets = nullptr;
+		return;
+	}
+
+	memory = AllocateZeroed(bucketCount + 1, sizeof(Bucket));
+	buckets = reinterpret_cast<Bucket*>((reinterpret_cast<uintptr_t>(memory) + alignof(Bucket) - 1) & ~(uintptr_t) (alignof(Bucket) - 1));
+}
+
+// уничтожение элементов и освобождение памяти
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Release() {
+	// тривиально уничтожаемые элементы не требуют обхода массива
+	if (!is_trivially_destructible<K>::value || !is_trivially_destructible<T>::value)
+		for (int i = 0; i < bucketCount; i++)
+			for (unsigned mask = buckets[i].used; mask; mask &= mask - 1)
+				Destroy(i, __builtin_ctz(mask));
+
+	free(memory);
+}
+
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash, typename KeyEqual>
+TableStats CuckooTable<K, T, Hash, KeyEqual>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = bucketCount * SLOTS;
+	stats.bytes = sizeof(*this) + (bucketCount ? bucketCount + 1 : 0) * sizeof(Bucket) + stash.capacity() * sizeof(pair<K, T>);
+
+	int stashed = stash.empty() ? 0 : 1; // запас просматривается как ещё одна корзина
+
+	for (int i = 0; i < bucketCount; i++) {
+		for (unsigned mask = buckets[i].used; mask; mask &= mask - 1)
+			stats.AddHit(First(hasher1(buckets[i].slots[__builtin_ctz(mask)].key)) == i ? 1 : 2);
+
+		stats.AddMiss(2 + stashed); // неуспешный поиск всегда просматривает обе корзины
+	}
+
+	for (size_t i = 0; i < stash.size(); i++)
+		stats.AddHit(3);
+
+	return stats;
+}
+
+// оператор вывода в поток
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void CuckooTable<K, T, Hash, KeyEqual>::Print() const {
+	for (int i = 0; i < bucketCount; i++) {
+		for (unsigned mask = buckets[i].used; mask; mask &= mask - 1) {
+			int slot = __builtin_ctz(mask);
+
+			cout << "[" << i * SLOTS + slot << "]: "; // выводим номер ячейки
+			cout << buckets[i].slots[slot].value << "(" << buckets[i].slots[slot].key << ") "; // выводим содержимое ячейки
+			cout << endl; // переходим на новую строку
+		}
+	}
+
+	for (size_t i = 0; i < stash.size(); i++)
+		cout << "[stash " << i << "]: " << stash[i].second << "(" << stash[i].first << ") " << endl;
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void swap(CuckooTable<K, T, Hash, KeyEqual>& table1, CuckooTable<K, T, Hash, KeyEqual>& table2) {
+	table1.Swap(table2);
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <random>
+#include <type_traits>
+
+/*
+	Хеш-функции для таблиц
+	Таблицы принимают тип хеш-функции параметром шаблона и вызывают её
+	напрямую, что позволяет компилятору встраивать вычисление хеша в цикл
+	пробирования. Все функции возвращают беззнаковое 64-битное значение
+*/
+
+// перемешивание битов 64-битного значения (финализатор MurmurHash3)
+inline uint64_t MixHash(uint64_t hash) {
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+
+	return hash;
+}
+
+// перемешивание битов 64-битного значения (финализатор SplitMix64)
+inline uint64_t SplitMix(uint64_t hash) {
+	hash += 0x9e3779b97f4a7c15ULL;
+	hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+
+	return hash ^ (hash >> 31);
+}
+
+// умножение 64-битных чисел с объединением старшей и младшей половин 128-битного результата
+constexpr uint64_t MultiplyMix(uint64_t a, uint64_t b) {
+	unsigned __int128 product = (unsigned __int128) a * b;
+
+	return (uint64_t) product ^ (uint64_t) (product >> 64);
+}
+
+// чтение 8 и 4 байт без требований к выравниванию
+inline uint64_t Read64(const uint8_t *bytes) {
+	uint64_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+inline uint64_t Read32(const uint8_t *bytes) {
+	uint32_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+// хеш последовательности байт (по схеме wyhash)
+inline uint64_t HashBytes(const void *data, size_t length, uint64_t seed = 0) {
+	const uint64_t secret0 = 0xa0761d6478bd642fULL;
+	const uint64_t secret1 = 0xe7037ed1a0b428dbULL;
+	const uint64_t secret2 = 0x8ebc6af09c88c6e3ULL;
+	const uint64_t secret3 = 0x589965cc75374cc3ULL;
+
+	const uint8_t *bytes = (const uint8_t *) data;
+	uint64_t a, b;
+
+	seed ^= MultiplyMix(seed ^ secret0, secret1);
+
+	if (length <= 16) {
+		if (length >= 4) {
+			size_t offset = (length >> 3) << 2; // 0 для длин 4..7 и 4 для длин 8..16
+
+			a = (Read32(bytes) << 32) | Read32(bytes + offset);
+			b = (Read32(bytes + length - 4) << 32) | Read32(bytes + length - 4 - offset);
+		}
+		else if (length > 0) {
+			a = ((uint64_t) bytes[0] << 16) | ((uint64_t) bytes[length >> 1] << 8) | bytes[length - 1];
+			b = 0;
+		}
+		else {
+			a = b = 0;
+		}
+	}
+	else {
+		size_t rest = length;
+
+		// длинные строки обрабатываем тремя независимыми потоками по 16 байт
+		if (rest > 48) {
+			uint64_t seed1 = seed;
+			uint64_t seed2 = seed;
+
+			do {
+				seed = MultiplyMix(Read64(bytes) ^ secret1, Read64(bytes + 8) ^ seed);
+				seed1 = MultiplyMix(Read64(bytes + 16) ^ secret2, Read64(bytes + 24) ^ seed1);
+				seed2 = MultiplyMix(Read64(bytes + 32) ^ secret3, Read64(bytes + 40) ^ seed2);
+
+				bytes += 48;
+				rest -= 48;
+			} while (rest > 48);
+
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (rest > 16) {
+			seed = MultiplyMix(Read64(bytes) ^ secret1, Read64(bytes + 8) ^ seed);
+
+			bytes += 16;
+			rest -= 16;
+		}
+
+		a = Read64(bytes + rest - 16);
+		b = Read64(bytes + rest - 8);
+	}
+
+	a ^= secret1;
+	b ^= seed;
+
+	unsigned __int128 product = (unsigned __int128) a * b;
+
+	return MultiplyMix((uint64_t) product ^ secret0 ^ length, (uint64_t) (product >> 64) ^ secret1);
+}
+
+// хеш-функция целых чисел
+template <typename K>
+struct IntegerHash {
+	uint64_t operator()(K key) const {
+		return SplitMix((uint64_t) key);
+	}
+};
+
+// хеш-функция целых чисел для таблиц, перемешивающих хеш при вычислении начальной ячейки (IntegerTable)
+// вид функции выбирается по размеру ключа на этапе компиляции: ключ до 32 бит используется как есть
+// (умножение таблицы на 64-битную константу перемешивает все его биты), а 64-битный ключ сворачивается
+// умножением, чтобы старшие биты ключа влияли не только на старшие биты произведения
+template <typename K>
+struct IntegerMixer {
+	constexpr uint64_t operator()(K key) const {
+		if constexpr (sizeof(K) <= sizeof(uint32_t))
+			return (typename std::make_unsigned<K>::type) key;
+		else
+			return MultiplyMix((uint64_t) key, 0x9e3779b97f4a7c15ULL);
+	}
+};
+
+// хеш-функция строк
+// прозрачна: string_view и const char* хешируются без создания string
+struct StringHash {
+	using is_transparent = void;
+
+	uint64_t operator()(std::string_view key) const {
+		return HashBytes(key.data(), key.length());
+	}
+};
+
+// хеш-функция с секретным начальным значением для защиты от подбора коллизий (HashDoS)
+// по умолчанию начальное значение выбирается случайно для каждого экземпляра
+template <typename K>
+class SeededHash {
+    uint64_t seed; // начальное значение
+
+public:
+    SeededHash() : seed(((uint64_t) std::random_device()() << 32) | std::random_device()()) {}
+    explicit SeededHash(uint64_t seed) : seed(seed) {}
+
+    uint64_t operator()(const K& key) const {
+    	if constexpr (std::is_convertible<const K&, std::string_view>::value) {
+    		std::string_view bytes = key;
+    		return HashBytes(bytes.data(), bytes.length(), seed);
+    	}
+    	else {
+    		static_assert(std::is_trivially_copyable<K>::value, "SeededHash requires string-like or trivially copyable keys");
+    		return HashBytes(&key, sizeof(key), seed);
+    	}
+    }
+};
+
+// встроенная хеш-функция для ключа заданного типа: целые числа перемешиваются, строки хешируются побайтово
+template <typename K>
+uint64_t BuiltinHash(const K& key) {
+	if constexpr (std::is_integral<K>::value || std::is_enum<K>::value) {
+		return SplitMix((uint64_t) key);
+	}
+	else if constexpr (std::is_convertible<const K&, std::string_view>::value) {
+		std::string_view bytes = key;
+		return HashBytes(bytes.data(), bytes.length());
+	}
+	else {
+		return MixHash(std::hash<K>()(key)); // остальные типы - через перемешанный стандартный хеш
+	}
+}
+
+// встроенная хеш-функция таблиц (без состояния, поэтому не увеличивает таблицу и встраивается в цикл поиска)
+template <typename K>
+struct DefaultHash {
+	uint64_t operator()(const K& key) const {
+		return BuiltinHash(key);
+	}
+};
+
+// обёртка указателя на пользовательскую функцию int (*)(K) для конструкторов таблиц из указателя
+// (таблица должна быть объявлена с Hash = FunctionHash<K>)
+template <typename K>
+class FunctionHash {
+    int (*h)(K); // указатель на пользовательскую хеш-функцию
+
+public:
+    explicit FunctionHash(int (*h)(K)) : h(h) {}
+
+    uint64_t operator()(const K& key) const {
+    	return (uint32_t) h(key); // значение пользовательской функции используется как есть
+    }
+};
+
+// разрешает поиск по ключу другого типа (например, string_view в таблице со string),
+// если и хеш-функция, и сравнение ключей объявлены прозрачными
+template <typename Hash, typename KeyEqual>
+using TransparentLookup = std::void_t<typename Hash::is_transparent, typename KeyEqual::is_transparent>;
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <iostream>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include "TableStats.hpp"
 
 /* Интерфейс хеш-таблицы */
 
@@ -17,5 +21,82 @@ public:
 	virtual bool IsEmpty() const = 0; // проверка на пустоту
 	virtual T Get(const K& key) const = 0; // получение значения по ключу
 
+	virtual T* FindPtr(const K& key) = 0; // указатель на значение по ключу (nullptr, если нет)
+	virtual const T* FindPtr(const K& key) const = 0;
+
+	virtual std::pair<T*, bool> TryEmplace(K key, T value) = 0; // добавление, если ключа нет (указатель на значение и признак вставки)
+	virtual std::pair<T*, bool> InsertOrAssign(K key, T value) = 0; // добавление или замена значения по ключу (указатель на значение и признак вставки)
+
+	// получение значения по ключу без исключения (ложь, если нет)
+	bool TryGet(const K& key, T& value) const {
+		const T *found = FindPtr(key);
+
+		if (found == nullptr)
+			return false;
+
+		value = *found;
+		return true;
+	}
+
+	// пакетные операции: для блока ключей сначала вычисляются хеши и загружаются в кеш
+	// начальные ячейки, а затем выполняется поиск, поэтому промахи кеша разных ключей
+	// перекрываются, а не следуют друг за другом
+	void FindBatch(const K* keys, int count, bool* found) const {
+		uint64_t hashes[BATCH_SIZE];
+
+		for (int start = 0; start < count; start += BATCH_SIZE) {
+			int end = std::min(start + BATCH_SIZE, count);
+
+			for (int i = start; i < end; i++)
+				hashes[i - start] = PrefetchKey(keys[i]);
+
+			for (int i = start; i < end; i++)
+				found[i] = FindHashed(keys[i], hashes[i - start]) != nullptr;
+		}
+	}
+
+	// получение значений по ключам (values[i] изменяется, только если found[i])
+	void GetBatch(const K* keys, int count, T* values, bool* found) const {
+		uint64_t hashes[BATCH_SIZE];
+
+		for (int start = 0; start < count; start += BATCH_SIZE) {
+			int end = std::min(start + BATCH_SIZE, count);
+
+			for (int i = start; i < end; i++)
+				hashes[i - start] = PrefetchKey(keys[i]);
+
+			for (int i = start; i < end; i++) {
+				const T *value = FindHashed(keys[i], hashes[i - start]);
+				found[i] = value != nullptr;
+
+				if (value != nullptr)
+					values[i] = *value;
+			}
+		}
+	}
+
+	// добавление или замена значений по ключам (вставка может перестроить таблицу, поэтому загрузка только ускоряет доступ)
+	void InsertBatch(const K* keys, const T* values, int count) {
+		for (int start = 0; start < count; start += BATCH_SIZE) {
+			int end = std::min(start + BATCH_SIZE, count);
+
+			for (int i = start; i < end; i++)
+				PrefetchKey(keys[i]);
+
+			for (int i = start; i < end; i++)
+				Insert(keys[i], values[i]);
+		}
+	}
+
+	virtual TableStats GetStats() const = 0; // статистика заполнения и длин поиска (собирается обходом ячеек)
+
 	virtual void Print() const = 0; // вывод таблицы
+
+	virtual ~HashTable() {} // виртуальный деструктор для удаления через указатель на интерфейс
+
+protected:
+	static const int BATCH_SIZE = 64; // число ключей, ячейки которых загружаются в кеш одновременно
+
+	virtual uint64_t PrefetchKey(const K& key) const { return 0; } // хеш ключа с предварительной загрузкой начальной ячейки в кеш
+	virtual const T* FindHashed(const K& key, uint64_t hash) const { return FindPtr(key); } // поиск значения по ключу с вычисленным хешем
 };
\ No newline at end of file
@@ -0,0 +1,595 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#include "CellStorage.hpp"
+#include "HashTable.h"
+#include "HashFunctions.hpp"
+
+using namespace std;
+
+/*
+	Хеш таблица на основе хешинга классиков (Hopscotch hashing)
+	Каждый ключ находится не дальше фиксированной окрестности от своей начальной
+	ячейки, а начальная ячейка хранит битовую карту окрестности: бит i означает,
+	что в ячейке, отстоящей на i от начальной, лежит ключ с этой начальной ячейкой.
+	Поиск сравнивает ключи только в отмеченных ячейках, поэтому длина поиска не
+	зависит от кластеров, образованных другими ключами. При вставке находится
+	ближайшая свободная ячейка, и, если она вне окрестности, она переносится ближе:
+	в неё перемещается элемент, окрестность которого позволяет такой перенос
+	Удаление только снимает бит карты, поэтому удалённых ячеек в таблице не бывает.
+	Если освободить ячейку в окрестности не удалось, то заполненная таблица
+	расширяется, а ключ малозаполненной таблицы (например, при плохой хеш-функции)
+	попадает в переполнение, которое просматривается только для отмеченных
+	начальных ячеек
+	Карта окрестности из 62 битов и признаки занятости ячейки и переполнения
+	хранятся в одном 64-битном слове, поэтому ячейка целых ключа и значения
+	занимает 16 байт
+*/
+
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename KeyEqual = equal_to<K>>
+class HopscotchTable final : public HashTable<K, T> {
+	const int NEIGHBORHOOD = 62; // размер окрестности (число битов карты)
+	const uint64_t BUSY = 1ull << 62; // бит занятой ячейки
+	const uint64_t OVERFLOWED = 1ull << 63; // бит начальной ячейки, часть ключей которой находится в переполнении
+	const uint64_t HOP = BUSY - 1; // биты карты окрестности
+	const double MIN_GROW_LOAD = 0.5; // коэффициент заполнения, начиная с которого нехватка места расширяет таблицу
+
+    // ключ и значение в объединениях создаются и уничтожаются явно, только пока ячейка занята
+    struct HashNode {
+    	union { K key; }; // значение ключа элемента
+    	union { T value; }; // значение элемента
+    	uint64_t info; // карта окрестности ячейки как начальной и биты BUSY и OVERFLOWED
+    };
+
+    int capacity; // ёмкость таблицы
+    int size; // число элементов в таблице
+    double maxLoadFactor; // максимальный коэффициент заполнения
+
+    HashNode *cells; // массив ячеек
+    vector<pair<K, T>> overflow; // элементы, для которых не нашлось места в окрестности
+
+    Hash hasher; // хеш-функция
+    KeyEqual keyEqual; // сравнение ключей
+
+    int Offset(int index, int offset) const; // ячейка, отстоящая от заданной на offset (с переходом через конец массива)
+    int Distance(int from, int to) const; // расстояние от ячейки from до ячейки to
+
+    template <typename Key>
+    int FindIndex(const Key& key, int home) const; // поиск ячейки с ключом в окрестности начальной ячейки (-1, если нет)
+    template <typename Key>
+    int FindOverflowed(const Key& key) const; // поиск индекса элемента в переполнении (-1, если нет)
+    template <typename Key>
+    const T* FindValue(const Key& key) const; // поиск значения в окрестности и переполнении (nullptr, если нет)
+    template <typename Key>
+    const T* FindValue(const Key& key, uint64_t hash) const;
+
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой начальной ячейки в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+
+    int FindFree(int home) const; // ближайшая свободная ячейка, начиная с начальной (-1, если нет)
+    bool MoveCloser(int& free); // перенос свободной ячейки ближе к началу (ложь, если ни один элемент нельзя переместить)
+    int TryPlace(K& key, T& value, int home); // запись элемента в окрестность начальной ячейки (-1, если нет места)
+    T* Place(K key, T value, uint64_t hash); // запись элемента в окрестность или переполнение (указатель на значение)
+    pair<T*, bool> Emplace(K key, T value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+    void Rebuild(int newCapacity); // перестроение таблицы
+    void Destroy(int index); // уничтожение элемента ячейки
+    void Release(); // уничтожение элементов и освобождение памяти
+
+public:
+    HopscotchTable(int tableSize, const Hash& hasher = Hash(), double maxLoadFactor = 0.9, const KeyEqual& keyEqual = KeyEqual()); // конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+    HopscotchTable(int tableSize, int (*h)(K), double maxLoadFactor = 0.9); // конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+    HopscotchTable(const HopscotchTable& table); // конструктор копирования
+    HopscotchTable(HopscotchTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    HopscotchTable& operator=(HopscotchTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(HopscotchTable& table) noexcept; // обмен содержимым таблиц за O(1)
+
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
+    bool Remove(const K& key); // удаление по ключу
+    bool Find(const K& key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+
+    T Get(const K& key) const; // получение значения по ключу
+
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    // поиск по ключу другого типа при прозрачных хеш-функции и сравнении ключей
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    T* FindPtr(const Key& key) { return const_cast<T*>(FindValue(key)); }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    const T* FindPtr(const Key& key) const { return FindValue(key); }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    bool Find(const Key& key) const { return FindValue(key) != nullptr; }
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Print() const; // вывод таблицы
+
+    ~HopscotchTable(); // деструктор (освобождение памяти)
+};
+
+// конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+template <typename K, typename T, typename Hash, typename KeyEqual>
+HopscotchTable<K, T, Hash, KeyEqual>::HopscotchTable(int tableSize, const Hash& hasher, double maxLoadFactor, const KeyEqual& keyEqual) : hasher(hasher), keyEqual(keyEqual) {
+	this->capacity = max(tableSize, NEIGHBORHOOD); // окрестность не должна перекрывать саму себя
+	this->size = 0; // изначально нет элементов
+	this->maxLoadFactor = maxLoadFactor;
+
+	this->cells = static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))); // выделяем память под ячейки (все ячейки сразу свободны)
+}
+
+// конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+template <typename K, typename T, typename Hash, typename KeyEqual>
+HopscotchTable<K, T, Hash, KeyEqual>::HopscotchTable(int tableSize, int (*h)(K), double maxLoadFactor) : HopscotchTable(tableSize, Hash(h), maxLoadFactor) {
+}
+
+// конструктор копирования
+template <typename K, typename T, typename Hash, typename KeyEqual>
+HopscotchTable<K, T, Hash, KeyEqual>::HopscotchTable(const HopscotchTable& table) : overflow(table.overflow), hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = table.capacity; // копируем ёмкость
+	size = table.size; // копируем количество элементов
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
+
+	cells = capacity > 0 ? static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))) : nullptr; // выделяем память под массив (у перемещённой таблицы его нет)
+
+	// проходимся по всем ячейкам таблицы и копируем их содержимое
+	for (int i = 0; i < capacity; i++) {
+		cells[i].info = table.cells[i].info;
+
+		// содержимое свободных ячеек не нужно
+		if (cells[i].info & BUSY) {
+			new (&cells[i].key) K(table.cells[i].key);
+			new (&cells[i].value) T(table.cells[i].value);
+		}
+	}
+}
+
+// конструктор перемещения: таблица забирает массивы, а перемещённой остаётся нулевая ёмкость без выделенной памяти
+// (массив выделяется при следующей вставке)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+HopscotchTable<K, T, Hash, KeyEqual>::HopscotchTable(HopscotchTable&& table) noexcept : hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = 0;
+	size = 0;
+	maxLoadFactor = table.maxLoadFactor;
+	cells = nullptr;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash, typename KeyEqual>
+HopscotchTable<K, T, Hash, KeyEqual>& HopscotchTable<K, T, Hash, KeyEqual>::operator=(HopscotchTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void HopscotchTable<K, T, Hash, KeyEqual>::Swap(HopscotchTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(size, table.size);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(cells, table.cells);
+	overflow.swap(table.overflow);
+	swap(hasher, table.hasher);
+	swap(keyEqual, table.keyEqual);
+}
+
+// ячейка, отстоящая от заданной на offset (с переходом через конец массива)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int HopscotchTable<K, T, Hash, KeyEqual>::Offset(int index, int offset) const {
+	index += offset;
+
+	return index >= capacity ? index - capacity : index;
+}
+
+// расстояние от ячейки from до ячейки to
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int HopscotchTable<K, T, Hash, KeyEqual>::Distance(int from, int to) const {
+	return to >= from ? to - from : to + capacity - from;
+}
+
+// поиск ячейки с ключом в окрестности начальной ячейки (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+int HopscotchTable<K, T, Hash, KeyEqual>::FindIndex(const Key& key, int home) const {
+	// просматриваются только ячейки с ключами этой начальной ячейки
+	for (uint64_t hop = cells[home].info & HOP; hop; hop &= hop - 1) {
+		int index = Offset(home, __builtin_ctzll(hop));
+
+		if (keyEqual(cells[index].key, key))
+			return index;
+	}
+
+	return -1;
+}
+
+// поиск индекса элемента в переполнении (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+int HopscotchTable<K, T, Hash, KeyEqual>::FindOverflowed(const Key& key) const {
+	for (size_t i = 0; i < overflow.size(); i++)
+		if (keyEqual(overflow[i].first, key))
+			return i;
+
+	return -1;
+}
+
+// поиск значения в окрестности и переполнении (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+const T* HopscotchTable<K, T, Hash, KeyEqual>::FindValue(const Key& key) const {
+	return FindValue(key, hasher(key));
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+const T* HopscotchTable<K, T, Hash, KeyEqual>::FindValue(const Key& key, uint64_t hash) const {
+	if (capacity == 0)
+		return nullptr; // у перемещённой таблицы нет массива
+
+	int home = hash % capacity; // начальная ячейка
+	int index = FindIndex(key, home);
+
+	if (index != -1)
+		return &cells[index].value;
+
+	if (!(cells[home].info & OVERFLOWED))
+		return nullptr; // переполнение не содержит ключей этой начальной ячейки
+
+	index = FindOverflowed(key);
+
+	return index == -1 ? nullptr : &overflow[index].second;
+}
+
+// хеш ключа с предварительной загрузкой начальной ячейки в кеш
+template <typename K, typename T, typename Hash, typename KeyEqual>
+uint64_t HopscotchTable<K, T, Hash, KeyEqual>::PrefetchKey(const K& key) const {
+	uint64_t hash = hasher(key);
+
+	if (capacity > 0) // у перемещённой таблицы нет массива
+		__builtin_prefetch(cells + hash % capacity);
+
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual>
+const T* HopscotchTable<K, T, Hash, KeyEqual>::FindHashed(const K& key, uint64_t hash) const {
+	return FindValue(key, hash);
+}
+
+// ближайшая свободная ячейка, начиная с начальной (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int HopscotchTable<K, T, Hash, KeyEqual>::FindFree(int home) const {
+	// при высоком заполнении кластеры могут быть длиннее тысячи ячеек, поэтому поиск не ограничивается
+	for (int offset = 0, index = home; offset < capacity; offset++, index = Offset(index, 1))
+		if (!(cells[index].info & BUSY))
+			return index;
+
+	return -1;
+}
+
+// перенос свободной ячейки ближе к началу (ложь, если ни один элемент нельзя переместить)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool HopscotchTable<K, T, Hash, KeyEqual>::MoveCloser(int& free) {
+	// начальные ячейки, окрестности которых содержат свободную ячейку, от самой дальней
+	for (int offset = NEIGHBORHOOD - 1; offset > 0; offset--) {
+		int home = Offset(free, capacity - offset);
+		uint64_t before = cells[home].info & ((1ull << offset) - 1); // ключи этой начальной ячейки, лежащие до свободной
+
+		if (!before)
+			continue;
+
+		int distance = __builtin_ctzll(before);
+		int index = Offset(home, distance);
+
+		// элемент переходит в свободную ячейку, оставаясь в окрестности своей начальной ячейки
+		new (&cells[free].key) K(move(cells[index].key));
+		new (&cells[free].value) T(move(cells[index].value));
+		cells[free].info |= BUSY;
+		cells[home].info = (cells[home].info & ~(1ull << distance)) | (1ull << offset);
+
+		Destroy(index);
+		free = index;
+		return true;
+	}
+
+	return false;
+}
+
+// запись элемента в окрестность начальной ячейки (-1, если нет места)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int HopscotchTable<K, T, Hash, KeyEqual>::TryPlace(K& key, T& value, int home) {
+	int free = FindFree(home);
+
+	if (free == -1)
+		return -1;
+
+	while (Distance(home, free) >= NEIGHBORHOOD)
+		if (!MoveCloser(free))
+			return -1;
+
+	new (&cells[free].key) K(move(key));
+
+	try {
+		new (&cells[free].value) T(move(value));
+	}
+	catch (...) {
+		cells[free].key.~K();
+		throw;
+	}
+
+	cells[free].info |= BUSY;
+	cells[home].info |= 1ull << Distance(home, free);
+
+	return free;
+}
+
+// запись элемента в окрестность или переполнение (указатель на значение)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T* HopscotchTable<K, T, Hash, KeyEqual>::Place(K key, T value, uint64_t hash) {
+	while (true) {
+		int home = hash % capacity;
+		int index = TryPlace(key, value, home);
+
+		if (index != -1)
+			return &cells[index].value;
+
+		// в малозаполненной таблице нехватку места создаёт хеш-функция, и расширение не поможет
+		if (size + 1 <= MIN_GROW_LOAD * capacity) {
+			overflow.emplace_back(move(key), move(value));
+			cells[home].info |= OVERFLOWED;
+			return &overflow.back().second;
+		}
+
+		Rebuild(capacity * 2);
+	}
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> HopscotchTable<K, T, Hash, KeyEqual>::Emplace(K key, T value, bool assign) {
+	// у перемещённой таблицы массив выделяется только при первой вставке
+	if (capacity == 0) {
+		cells = static_cast<HashNode*>(AllocateZeroed(NEIGHBORHOOD, sizeof(HashNode)));
+		capacity = NEIGHBORHOOD;
+	}
+
+	uint64_t hash = hasher(key);
+	T *found = const_cast<T*>(FindValue(key, hash));
+
+	if (found != nullptr) {
+		if (assign)
+			*found = move(value); // обновляем значение на месте
+
+		return make_pair(found, false);
+	}
+
+	// если после вставки будет превышен коэффициент заполнения, то расширяем таблицу
+	if (size + 1 > maxLoadFactor * capacity)
+		Rebuild(capacity * 2);
+
+	T *placed = Place(move(key), move(value), hash);
+	size++; // увеличиваем счётчик числа элементов
+
+	return make_pair(placed, true);
+}
+
+// перестроение таблицы
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void HopscotchTable<K, T, Hash, KeyEqual>::Rebuild(int newCapacity) {
+	HashNode *prevCells = cells; // запоминаем текущий массив
+	int prevCapacity = capacity;
+	vector<pair<K, T>> prevOverflow;
+	prevOverflow.swap(overflow);
+
+	capacity = newCapacity;
+	cells = static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))); // выделяем память под новый массив
+
+	// перемещаем все элементы в новый массив
+	for (int i = 0; i < prevCapacity; i++) {
+		if (prevCells[i].info & BUSY) {
+			uint64_t hash = hasher(prevCells[i].key); // хеш вычисляется до перемещения ключа
+			Place(move(prevCells[i].key), move(prevCells[i].value), hash);
+			prevCells[i].key.~K();
+			prevCells[i].value.~T();
+		}
+	}
+
+	for (size_t i = 0; i < prevOverflow.size(); i++) {
+		uint64_t hash = hasher(prevOverflow[i].first);
+		Place(move(prevOverflow[i].first), move(prevOverflow[i].second), hash);
+	}
+
+	free(prevCells);
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void HopscotchTable<K, T, Hash, KeyEqual>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool HopscotchTable<K, T, Hash, KeyEqual>::Remove(const K& key) {
+	if (capacity == 0)
+		return false; // у перемещённой таблицы нет элементов
+
+	int home = hasher(key) % capacity;
+	int index = FindIndex(key, home);
+
+	if (index != -1) {
+		cells[home].info &= ~(1ull << Distance(home, index)); // ячейка сразу становится свободной
+		Destroy(index);
+		size--; // уменьшаем счётчик числа элементов
+
+		return true;
+	}
+
+	index = cells[home].info & OVERFLOWED ? FindOverflowed(key) : -1;
+
+	if (index == -1)
+		return false; // не нашли, возвращаем ложь
+
+	overflow.erase(overflow.begin() + index);
+	size--;
+
+	// отметка снимается, если в переполнении не осталось ключей этой начальной ячейки
+	cells[home].info &= ~OVERFLOWED;
+
+	for (size_t i = 0; i < overflow.size(); i++) {
+		if ((int) (hasher(overflow[i].first) % capacity) == home) {
+			cells[home].info |= OVERFLOWED;
+			break;
+		}
+	}
+
+	return true;
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool HopscotchTable<K, T, Hash, KeyEqual>::Find(const K& key) const {
+	return FindValue(key) != nullptr;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void HopscotchTable<K, T, Hash, KeyEqual>::Clear() {
+	Release(); // вместо обхода ячеек массив заменяется новым обнулённым
+	cells = capacity > 0 ? static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))) : nullptr;
+
+	overflow.clear();
+	size = 0; // обнуляем счётчик числа элементов
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int HopscotchTable<K, T, Hash, KeyEqual>::GetSize() const {
+	return size; // возвращаем размер
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool HopscotchTable<K, T, Hash, KeyEqual>::IsEmpty() const {
+	return size == 0; // таблица пуста, если нет элементов
+}
+
+// получение значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T HopscotchTable<K, T, Hash, KeyEqual>::Get(const K& key) const {
+	const T *value = FindValue(key);
+
+	if (value == nullptr)
+		throw string("No value with this key"); // бросаем исключение
+
+	return *value; // возвращаем значение
+}
+
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T* HopscotchTable<K, T, Hash, KeyEqual>::FindPtr(const K& key) {
+	return const_cast<T*>(FindValue(key));
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+const T* HopscotchTable<K, T, Hash, KeyEqual>::FindPtr(const K& key) const {
+	return FindValue(key);
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> HopscotchTable<K, T, Hash, KeyEqual>::TryEmplace(K key, T value) {
+	return Emplace(move(key), move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> HopscotchTable<K, T, Hash, KeyEqual>::InsertOrAssign(K key, T value) {
+	return Emplace(move(key), move(value), true);
+}
+
+// деструктор (освобождения памяти)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+HopscotchTable<K, T, Hash, KeyEqual>::~HopscotchTable() {
+	Release(); // удаляем массив ячеек
+}
+
+// уничтожение элемента ячейки (карта окрестности ячейки не меняется)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void HopscotchTable<K, T, Hash, KeyEqual>::Destroy(int index) {
+	cells[index].key.~K();
+	cells[index].value.~T();
+	cells[index].info &= ~BUSY;
+}
+
+// уничтожение элементов и освобождение памяти
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void HopscotchTable<K, T, Hash, KeyEqual>::Release() {
+	// тривиально уничтожаемые элементы не требуют обхода массива
+	if (!is_trivially_destructible<K>::value || !is_trivially_destructible<T>::value)
+		for (int i = 0; i < capacity; i++)
+			if (cells[i].info & BUSY)
+				Destroy(i);
+
+	free(cells);
+}
+
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash, typename KeyEqual>
+TableStats HopscotchTable<K, T, Hash, KeyEqual>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.bytes = sizeof(*this) + capacity * sizeof(HashNode) + overflow.capacity() * sizeof(pair<K, T>);
+
+	for (int i = 0; i < capacity; i++) {
+		int probes = 0; // ключи окрестности сравниваются в порядке удаления от начальной ячейки
+
+		for (uint64_t hop = cells[i].info & HOP; hop; hop &= hop - 1)
+			stats.AddHit(++probes);
+
+		// неуспешный поиск сравнивает все ключи окрестности и, если ячейка отмечена, переполнения
+		stats.AddMiss(probes + (cells[i].info & OVERFLOWED ? overflow.size() : 0));
+	}
+
+	for (size_t i = 0; i < overflow.size(); i++)
+		stats.AddHit(__builtin_popcountll(cells[hasher(overflow[i].first) % capacity].info & HOP) + i + 1);
+
+	stats.AddClusters(capacity, [this](int i) { return (cells[i].info & BUSY) != 0; });
+	return stats;
+}
+
+// оператор вывода в поток
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void HopscotchTable<K, T, Hash, KeyEqual>::Print() const {
+	for (int i = 0; i < capacity; i++) {
+		if (!(cells[i].info & BUSY))
+			continue; // если ячейка не занята, то переходим к следующему элементу
+
+		cout << "[" << i << "]: "; // выводим номер ячейки
+		cout << cells[i].value << "(" << cells[i].key << ") "; // выводим содержимое ячейки
+		cout << endl; // переходим на новую строку
+	}
+
+	for (size_t i = 0; i < overflow.size(); i++)
+		cout << "[overflow " << i << "]: " << overflow[i].second << "(" << overflow[i].first << ") " << endl;
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void swap(HopscotchTable<K, T, Hash, KeyEqual>& table1, HopscotchTable<K, T, Hash, KeyEqual>& table2) {
+	table1.Swap(table2);
+}
@@ -0,0 +1,601 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "HashTable.h"
+#include "HashFunctions.hpp"
+#include "CellStorage.hpp"
+#include "LinearProbingTable.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/*
+	Хеш таблица с линейным пробированием для целых ключей
+	Состояние ячейки не хранится: свободную ячейку обозначает нулевой ключ,
+	поэтому обнулённый при выделении массив сразу состоит из свободных ячеек.
+	Элемент с самим нулевым ключом хранится отдельно, в дополнительной ячейке
+	массива значений. Удаление выполняется сдвигом назад, поэтому удалённых
+	ячеек (и второго особого значения ключа для них) нет
+	Ключи хранятся отдельно от значений и сравниваются группами по 32 байта
+	(8 ключей int или 4 ключа long long) инструкциями SSE2, а ключи совпадают,
+	только если совпадают их биты, поэтому сравнение ключей не настраивается
+	Начальная ячейка - старшие биты произведения хеша на нечётную константу
+	(фибоначчиево хеширование), поэтому хеш-функция по умолчанию (IntegerMixer)
+	почти ничего не вычисляет
+*/
+
+template <typename K, typename T, typename Hash = IntegerMixer<K>>
+class IntegerTable final : public HashTable<K, T> {
+	static_assert(is_integral<K>::value && !is_same<K, bool>::value, "IntegerTable requires integral keys");
+
+	static constexpr int GROUP_BYTES = 32; // размер группы одновременно сравниваемых ключей в байтах
+	static constexpr int GROUP_SIZE = GROUP_BYTES / sizeof(K) < 32 ? GROUP_BYTES / sizeof(K) : 32; // число ключей в группе
+	static constexpr uint64_t FIBONACCI = 0x9e3779b97f4a7c15ULL; // 2^64 / φ, множитель для вычисления начальной ячейки
+
+	const K EMPTY = 0; // ключ свободной ячейки
+
+    // группа ключей, начинающаяся с заданной ячейки
+    struct Group {
+    	const K *keys; // ключи группы
+
+    	Group(const K *keys) : keys(keys) {}
+
+    	// маска ячеек с заданным ключом
+    	unsigned Match(K key) const {
+#ifdef __SSE2__
+    		if constexpr (sizeof(K) == 4) {
+    			__m128i needle = _mm_set1_epi32((int) key);
+    			unsigned low = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) keys), needle)));
+    			unsigned high = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) keys + 1), needle)));
+
+    			return low | (high << 4);
+    		}
+    		else if constexpr (sizeof(K) == 8) {
+    			__m128i needle = _mm_set1_epi64x((long long) key);
+
+    			return Match64(keys, needle) | (Match64(keys + 2, needle) << 2);
+    		}
+#endif
+    		unsigned mask = 0;
+
+    		for (int i = 0; i < GROUP_SIZE; i++)
+    			if (keys[i] == key)
+    				mask |= 1u << i;
+
+    		return mask;
+    	}
+
+#ifdef __SSE2__
+    	// маска двух 64-битных ключей (в SSE2 нет сравнения 64-битных чисел, поэтому сравниваются половины)
+    	static unsigned Match64(const K *keys, __m128i needle) {
+    		__m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) keys), needle);
+    		equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1))); // ключ совпал, если совпали обе половины
+
+    		return _mm_movemask_pd(_mm_castsi128_pd(equal));
+    	}
+#endif
+    };
+
+    int capacity; // ёмкость таблицы (степень двойки)
+    int shift; // сдвиг произведения хеша, оставляющий номер ячейки
+    int size; // число элементов в таблице (вместе с элементом с нулевым ключом)
+    bool hasZero; // есть ли элемент с нулевым ключом
+    double maxLoadFactor; // максимальный коэффициент заполнения
+
+    K *keys; // массив ключей (с запасом на группу после последней ячейки)
+    T *values; // массив значений (ячейка capacity - значение нулевого ключа)
+
+    Hash hasher; // хеш-функция
+
+    void Allocate(int tableSize); // выделение памяти под свободные ячейки
+    int Home(uint64_t hash) const; // начальная ячейка по значению хеш-функции
+    int Lanes(int index) const; // число ячеек группы, начинающейся с ячейки index (группа не переходит через конец массива)
+    int Probe(K key, uint64_t hash, bool& found) const; // поиск ячейки с ключом или свободной ячейки, на которой поиск остановился
+    const T* FindValue(K key) const; // поиск значения по ключу (nullptr, если нет)
+    const T* FindValue(K key, uint64_t hash) const;
+
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой начальной группы в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+
+    pair<T*, bool> Emplace(K key, T value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+    void Rebuild(int newCapacity); // перестроение таблицы
+    void Release(); // уничтожение элементов и освобождение памяти
+    int GroupCount(int from, int to) const; // число групп, просматриваемых поиском от ячейки from до ячейки to
+
+public:
+    IntegerTable(int tableSize, const Hash& hasher = Hash(), double maxLoadFactor = 0.75); // конструктор из размера, хеш-функции и коэффициента заполнения
+    IntegerTable(const IntegerTable& table); // конструктор копирования
+    IntegerTable(IntegerTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    IntegerTable& operator=(IntegerTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(IntegerTable& table) noexcept; // обмен содержимым таблиц за O(1)
+
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
+    bool Remove(const K& key); // удаление по ключу
+    bool Find(const K& key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+
+    T Get(const K& key) const; // получение значения по ключу
+
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Print() const; // вывод таблицы
+
+    ~IntegerTable(); // деструктор (освобождение памяти)
+};
+
+// таблица с открытой адресацией, выбираемая по типу ключа на этапе компиляции:
+// целые ключи хранятся в IntegerTable, остальные (например, строки) - в ячейках таблицы с линейным пробированием
+template <typename K, typename T>
+using FlatTable = typename conditional<is_integral<K>::value && !is_same<K, bool>::value, IntegerTable<K, T>, LinearProbingTable<K, T>>::type;
+
+// конструктор из размера, хеш-функции и коэффициента заполнения
+template <typename K, typename T, typename Hash>
+IntegerTable<K, T, Hash>::IntegerTable(int tableSize, const Hash& hasher, double maxLoadFactor) : hasher(hasher) {
+	this->size = 0; // изначально нет элементов
+	this->hasZero = false; // и нет нулевого ключа
+	this->maxLoadFactor = maxLoadFactor;
+
+	Allocate(tableSize); // выделяем память под ячейки (все ячейки сразу свободны)
+}
+
+// конструктор копирования
+template <typename K, typename T, typename Hash>
+IntegerTable<K, T, Hash>::IntegerTable(const IntegerTable& table) : hasher(table.hasher) {
+	size = table.size; // копируем количество элементов
+	hasZero = table.hasZero;
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
+
+	// у перемещённой таблицы массивов нет, поэтому нет их и у копии
+	if (table.capacity == 0) {
+		capacity = 0;
+		shift = 0;
+		keys = nullptr;
+		values = nullptr;
+		return;
+	}
+
+	Allocate(table.capacity); // выделяем память под массивы той же ёмкости
+	memcpy(keys, table.keys, capacity * sizeof(K)); // ключи копируются вместе с признаками свободных ячеек
+
+	// значения копируются только в занятых ячейках
+	for (int i = 0; i < capacity; i++)
+		if (keys[i] != EMPTY)
+			new (values + i) T(table.values[i]);
+
+	if (hasZero)
+		new (values + capacity) T(table.values[capacity]);
+}
+
+// конструктор перемещения: таблица забирает массивы, а перемещённой остаётся нулевая ёмкость без выделенной памяти
+// (массивы выделяются при следующей вставке)
+template <typename K, typename T, typename Hash>
+IntegerTable<K, T, Hash>::IntegerTable(IntegerTable&& table) noexcept : hasher(table.hasher) {
+	capacity = 0;
+	shift = 0;
+	size = 0;
+	hasZero = false;
+	maxLoadFactor = table.maxLoadFactor;
+	keys = nullptr;
+	values = nullptr;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash>
+IntegerTable<K, T, Hash>& IntegerTable<K, T, Hash>::operator=(IntegerTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash>
+void IntegerTable<K, T, Hash>::Swap(IntegerTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(shift, table.shift);
+	swap(size, table.size);
+	swap(hasZero, table.hasZero);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(keys, table.keys);
+	swap(values, table.values);
+	swap(hasher, table.hasher);
+}
+
+// выделение памяти под свободные ячейки
+template <typename K, typename T, typename Hash>
+void IntegerTable<K, T, Hash>::Allocate(int tableSize) {
+	int newCapacity = 2 * GROUP_SIZE; // поиск останавливается на свободной ячейке, поэтому в массиве должно быть больше одной группы
+
+	while (newCapacity < tableSize)
+		newCapacity *= 2;
+
+	K *newKeys = static_cast<K*>(AllocateZeroed(newCapacity + GROUP_SIZE - 1, sizeof(K))); // последняя группа читается целиком, не выходя за массив
+	T *newValues;
+
+	// при нехватке памяти уже выделенный массив освобождается, а таблица не меняется
+	try {
+		newValues = static_cast<T*>(AllocateZeroed(newCapacity + 1, sizeof(T)));
+	}
+	catch (...) {
+		free(newKeys);
+		throw;
+	}
+
+	capacity = newCapacity;
+	shift = 64 - __builtin_ctz(capacity);
+	keys = newKeys;
+	values = newValues;
+}
+
+// начальная ячейка по значению хеш-функции
+template <typename K, typename T, typename Hash>
+int IntegerTable<K, T, Hash>::Home(uint64_t hash) const {
+	return (hash * FIBONACCI) >> shift;
+}
+
+// число ячеек группы, начинающейся с ячейки index (группа не переходит через конец массива)
+template <typename K, typename T, typename Hash>
+int IntegerTable<K, T, Hash>::Lanes(int index) const {
+	return capacity - index < GROUP_SIZE ? capacity - index : GROUP_SIZE;
+}
+
+// поиск ячейки с ключом или свободной ячейки, на которой поиск остановился (found - найден ли ключ)
+// ключ не должен быть нулевым
+template <typename K, typename T, typename Hash>
+int IntegerTable<K, T, Hash>::Probe(K key, uint64_t hash, bool& found) const {
+	int index = Home(hash); // начальная ячейка
+
+	// в массиве всегда есть свободная ячейка, поэтому цикл завершается
+	while (true) {
+		Group group(keys + index);
+		int lanes = Lanes(index);
+
+		unsigned match = group.Match(key);
+		unsigned stop = (match | group.Match(EMPTY)) & (~0u >> (32 - lanes)); // ячейки за концом массива не рассматриваются
+
+		// первая ячейка группы с ключом или свободная решает исход поиска
+		if (stop) {
+			int lane = __builtin_ctz(stop);
+			found = (match >> lane) & 1;
+
+			return index + lane;
+		}
+
+		index += lanes; // переходим к следующей группе
+		if (index == capacity)
+			index = 0;
+	}
+}
+
+// поиск значения по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash>
+const T* IntegerTable<K, T, Hash>::FindValue(K key) const {
+	return FindValue(key, hasher(key));
+}
+
+template <typename K, typename T, typename Hash>
+const T* IntegerTable<K, T, Hash>::FindValue(K key, uint64_t hash) const {
+	if (key == EMPTY)
+		return hasZero ? values + capacity : nullptr;
+
+	if (capacity == 0)
+		return nullptr; // у перемещённой таблицы нет массивов
+
+	bool found;
+	int index = Probe(key, hash, found);
+
+	return found ? values + index : nullptr;
+}
+
+// хеш ключа с предварительной загрузкой начальной группы в кеш
+template <typename K, typename T, typename Hash>
+uint64_t IntegerTable<K, T, Hash>::PrefetchKey(const K& key) const {
+	uint64_t hash = hasher(key);
+
+	if (capacity > 0) // у перемещённой таблицы нет массивов
+		__builtin_prefetch(keys + Home(hash));
+
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash>
+const T* IntegerTable<K, T, Hash>::FindHashed(const K& key, uint64_t hash) const {
+	return FindValue(key, hash);
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash>
+pair<T*, bool> IntegerTable<K, T, Hash>::Emplace(K key, T value, bool assign) {
+	// у перемещённой таблицы массивы выделяются только при первой вставке
+	if (capacity == 0)
+		Allocate(1);
+
+	// нулевой ключ обозначает свободные ячейки, поэтому его значение хранится отдельно
+	if (key == EMPTY) {
+		if (hasZero) {
+			if (assign)
+				values[capacity] = move(value); // обновляем значение на месте
+
+			return make_pair(values + capacity, false);
+		}
+
+		new (values + capacity) T(move(value));
+		hasZero = true;
+		size++;
+
+		return make_pair(values + capacity, true);
+	}
+
+	uint64_t hash = hasher(key);
+	bool found;
+	int index = Probe(key, hash, found);
+
+	if (found) {
+		if (assign)
+			values[index] = move(value); // обновляем значение на месте
+
+		return make_pair(values + index, false);
+	}
+
+	// если после вставки будет превышен коэффициент заполнения или не останется свободных ячеек, то расширяем таблицу
+	if (size + 1 > maxLoadFactor * capacity || size + 1 >= capacity) {
+		Rebuild(capacity * 2);
+		index = Probe(key, hash, found);
+	}
+
+	new (values + index) T(move(value));
+	keys[index] = key; // ячейка становится занятой
+	size++;
+
+	return make_pair(values + index, true);
+}
+
+// перестроение таблицы (значения перемещаются, а не копируются)
+template <typename K, typename T, typename Hash>
+void IntegerTable<K, T, Hash>::Rebuild(int newCapacity) {
+	int prevCapacity = capacity;
+	K *prevKeys = keys;
+	T *prevValues = values;
+
+	Allocate(newCapacity); // выделяем память под новые массивы
+
+	for (int i = 0; i < prevCapacity; i++) {
+		if (prevKeys[i] == EMPTY)
+			continue;
+
+		bool found;
+		int index = Probe(prevKeys[i], hasher(prevKeys[i]), found); // ключи различны, поэтому поиск остановится на свободной ячейке
+
+		new (values + index) T(move(prevValues[i]));
+		keys[index] = prevKeys[i];
+		prevValues[i].~T();
+	}
+
+	if (hasZero) {
+		new (values + capacity) T(move(prevValues[prevCapacity]));
+		prevValues[prevCapacity].~T();
+	}
+
+	free(prevKeys);
+	free(prevValues);
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash>
+void IntegerTable<K, T, Hash>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash>
+bool IntegerTable<K, T, Hash>::Remove(const K& key) {
+	if (key == EMPTY) {
+		if (!hasZero)
+			return false;
+
+		values[capacity].~T();
+		hasZero = false;
+		size--;
+
+		return true;
+	}
+
+	if (capacity == 0)
+		return false; // у перемещённой таблицы нет массивов
+
+	bool found;
+	int index = Probe(key, hasher(key), found);
+
+	if (!found)
+		return false; // не нашли, возвращаем ложь
+
+	values[index].~T();
+
+	int next = index; // индекс проверяемой ячейки кластера
+
+	// сдвигаем назад элементы кластера, пробная последовательность которых проходит через освободившуюся ячейку
+	while (true) {
+		next = next + 1 == capacity ? 0 : next + 1; // переходим к следующей ячейке
+
+		if (keys[next] == EMPTY)
+			break; // кластер закончился
+
+		int home = Home(hasher(keys[next])); // начальная ячейка пробной последовательности элемента
+
+		// если начальная ячейка лежит циклически в (index, next], то элемент остаётся на месте
+		if (index <= next ? (index < home && home <= next) : (index < home || home <= next))
+			continue;
+
+		// иначе сдвигаем элемент в освободившуюся ячейку
+		keys[index] = keys[next];
+		new (values + index) T(move(values[next]));
+		values[next].~T();
+		index = next;
+	}
+
+	keys[index] = EMPTY; // последняя освободившаяся ячейка становится свободной
+	size--; // уменьшаем счётчик числа элементов
+
+	return true;
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash>
+bool IntegerTable<K, T, Hash>::Find(const K& key) const {
+	return FindValue(key) != nullptr;
+}
+
+template <typename K, typename T, typename Hash>
+void IntegerTable<K, T, Hash>::Clear() {
+	Release(); // вместо обхода ячеек массивы заменяются новыми обнулёнными
+
+	if (capacity > 0) // перемещённая таблица остаётся без памяти
+		Allocate(capacity);
+
+	size = 0; // обнуляем счётчик числа элементов
+	hasZero = false;
+}
+
+template <typename K, typename T, typename Hash>
+int IntegerTable<K, T, Hash>::GetSize() const {
+	return size; // возвращаем размер
+}
+
+template <typename K, typename T, typename Hash>
+bool IntegerTable<K, T, Hash>::IsEmpty() const {
+	return size == 0; // таблица пуста, если нет элементов
+}
+
+// получение значения по ключу
+template <typename K, typename T, typename Hash>
+T IntegerTable<K, T, Hash>::Get(const K& key) const {
+	const T *value = FindValue(key);
+
+	if (value == nullptr)
+		throw string("No value with this key"); // бросаем исключение
+
+	return *value; // возвращаем значение
+}
+
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash>
+T* IntegerTable<K, T, Hash>::FindPtr(const K& key) {
+	return const_cast<T*>(FindValue(key));
+}
+
+template <typename K, typename T, typename Hash>
+const T* IntegerTable<K, T, Hash>::FindPtr(const K& key) const {
+	return FindValue(key);
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash>
+pair<T*, bool> IntegerTable<K, T, Hash>::TryEmplace(K key, T value) {
+	return Emplace(key, move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash>
+pair<T*, bool> IntegerTable<K, T, Hash>::InsertOrAssign(K key, T value) {
+	return Emplace(key, move(value), true);
+}
+
+// деструктор (освобождения памяти)
+template <typename K, typename T, typename Hash>
+IntegerTable<K, T, Hash>::~IntegerTable() {
+	Release(); // удаляем массивы
+}
+
+// уничтожение элементов и освобождение памяти
+template <typename K, typename T, typename Hash>
+void IntegerTable<K, T, Hash>::Release() {
+	// тривиально уничтожаемые значения не требуют обхода массива
+	if (!is_trivially_destructible<T>::value) {
+		for (int i = 0; i < capacity; i++)
+			if (keys[i] != EMPTY)
+				values[i].~T();
+
+		if (hasZero)
+			values[capacity].~T();
+	}
+
+	free(keys);
+	free(values);
+}
+
+// число групп, просматриваемых поиском от ячейки from до ячейки to
+template <typename K, typename T, typename Hash>
+int IntegerTable<K, T, Hash>::GroupCount(int from, int to) const {
+	// группы начинаются через GROUP_SIZE ячеек от начальной и с начала массива
+	if (to >= from)
+		return 1 + (to - from) / GROUP_SIZE;
+
+	return 1 + (capacity - 1 - from) / GROUP_SIZE + 1 + to / GROUP_SIZE;
+}
+
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash>
+TableStats IntegerTable<K, T, Hash>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.bytes = sizeof(*this) + (capacity ? (capacity + GROUP_SIZE - 1) * sizeof(K) + (capacity + 1) * sizeof(T) : 0);
+
+	StepProbes probes(capacity, 1, [this](int i) { return keys[i] == EMPTY; });
+
+	for (int i = 0; i < capacity; i++) {
+		if (keys[i] != EMPTY)
+			stats.AddHit(GroupCount(Home(hasher(keys[i])), i));
+
+		stats.AddMiss(GroupCount(i, (i + probes.Miss(i) - 1) % capacity)); // неуспешный поиск, начинающийся в ячейке i, заканчивается на свободной ячейке
+	}
+
+	stats.AddClusters(capacity, [this](int i) { return keys[i] != EMPTY; });
+
+	// нулевой ключ находится без просмотра ячеек, но занимает отдельную ячейку: одна группа и кластер из одной ячейки
+	if (hasZero) {
+		stats.AddHit(1);
+		stats.AddClusters(1, [](int i) { return true; });
+	}
+	return stats;
+}
+
+// оператор вывода в поток
+template <typename K, typename T, typename Hash>
+void IntegerTable<K, T, Hash>::Print() const {
+	if (hasZero)
+		cout << "[zero]: " << values[capacity] << "(" << EMPTY << ") " << endl;
+
+	for (int i = 0; i < capacity; i++) {
+		if (keys[i] == EMPTY)
+			continue; // если ячейка не занята, то переходим к следующему элементу
+
+		cout << "[" << i << "]: "; // выводим номер ячейки
+		cout << values[i] << "(" << keys[i] << ") "; // выводим содержимое ячейки
+		cout << endl; // переходим на новую строку
+	}
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash>
+void swap(IntegerTable<K, T, Hash>& table1, IntegerTable<K, T, Hash>& table2) {
+	table1.Swap(table2);
+}
@@ -2,39 +2,88 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <type_traits>
 #include "HashTable.h"
+#include "CellStorage.hpp"
+#include "HashFunctions.hpp"
+#include "CapacityPolicy.hpp"
+#include "Snapshot.hpp"
 
 using namespace std;
 
 /*
 	Хеш таблица на основе линейного пробирования
+	При превышении максимального коэффициента заполнения таблица расширяется,
+	причём элементы переносятся в новый массив постепенно (по несколько ячеек
+	за каждую операцию вставки и удаления)
+	Если шаг q имеет общий делитель с ёмкостью массива (например, чётный шаг
+	после удвоения), он заменяется ближайшим взаимно простым, чтобы поиск
+	обходил все ячейки
+	При шаге пробирования q = 1 можно включить удаление со сдвигом назад:
+	вместо пометки ячейки удалённой следующие за ней элементы кластера
+	сдвигаются на её место, поэтому удалённые ячейки не накапливаются
 */
 
-template <typename K, typename T>
-class LinearProbingTable : public HashTable<K, T> {
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename KeyEqual = equal_to<K>, typename Storage = NodeStorage<K, T>, typename Capacity = ModuloCapacity>
+class LinearProbingTable final : public HashTable<K, T> {
 	const int FREE = 0; // свободная ячейка
 	const int BUSY = 1; // занятая ячейка
 	const int REMOVED = 2; // удалённая ячейка
 
-    struct HashNode {
-    	K key; // значение ключа элемента
-    	T value; // значение элемента
-    	int state; // состояние ячейки
-    };
+	const int REHASH_STEP = 8; // число ячеек старого массива, переносимых за одну операцию
+	const double MAX_LOAD_FACTOR = 0.99; // наибольший коэффициент заполнения: хотя бы одна ячейка остаётся свободной
 
     int capacity; // ёмкость таблицы
     int size; // число элементов в таблице
+    int used; // число занятых и удалённых ячеек в текущем массиве
     int q; // шаг пробирования
-
-    HashNode *cells; // массив ячеек
-
-    int (*h)(K); // указатель на хеш-функцию
+    double maxLoadFactor; // максимальный коэффициент заполнения
+    bool backwardShift; // удаление со сдвигом назад вместо пометки ячеек удалёнными
+
+    Storage cells; // массив ячеек
+
+    Storage oldCells; // массив ячеек до расширения (не выделен, если перенос не выполняется)
+    int oldCapacity; // ёмкость старого массива
+    int oldSize; // число ещё не перенесённых элементов старого массива
+    int migrated; // индекс следующей переносимой ячейки старого массива
+
+    Hash hasher; // хеш-функция
+    KeyEqual keyEqual; // сравнение ключей
+
+    template <typename Key>
+    int FindIndex(const Storage& nodes, int length, const Key& key, uint64_t hash) const; // поиск индекса ячейки с ключом по значению хеш-функции (-1, если нет)
+    template <typename Key>
+    const T* FindValue(const Key& key) const; // поиск значения в текущем и старом массивах (nullptr, если нет)
+    template <typename Key>
+    const T* FindValue(const Key& key, uint64_t hash) const;
+
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой начальной ячейки в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+
+    int FindSlot(const K& key, bool& found) const; // поиск ячейки с ключом или первой незанятой ячейки для его вставки (-1, если нет)
+
+    template <typename KeyArg, typename ValueArg>
+    void Store(int index, KeyArg&& key, ValueArg&& value); // запись элемента в незанятую ячейку текущего массива
+    template <typename KeyArg, typename ValueArg>
+    int Place(KeyArg&& key, ValueArg&& value); // запись элемента в текущий массив (индекс ячейки или -1, если нет места)
+    template <typename KeyArg, typename ValueArg>
+    pair<T*, bool> Emplace(KeyArg&& key, ValueArg&& value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+    void Grow(); // начало расширения таблицы
+    void MigrateStep(); // перенос части ячеек из старого массива
+    void Rebuild(int newCapacity); // полное перестроение таблицы
+    void ShiftBack(int index); // удаление элемента текущего массива со сдвигом назад
+    void Release(Storage& nodes, int length); // уничтожение элементов массива и освобождение его памяти
 
 public:
-    LinearProbingTable(int tableSize, int (*h)(K), int q = 1); // конструктор из размера, хеш-функции и шага пробирования
+    LinearProbingTable(int tableSize, const Hash& hasher = Hash(), int q = 1, double maxLoadFactor = 0.75, bool backwardShift = false, const KeyEqual& keyEqual = KeyEqual()); // конструктор из размера, хеш-функции, шага пробирования, коэффициента заполнения, способа удаления и сравнения ключей
+    LinearProbingTable(int tableSize, int (*h)(K), int q = 1, double maxLoadFactor = 0.75, bool backwardShift = false); // конструктор из размера, указателя на хеш-функцию, шага пробирования, коэффициента заполнения и способа удаления
     LinearProbingTable(const LinearProbingTable& table); // конструктор копирования
+    LinearProbingTable(LinearProbingTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    LinearProbingTable& operator=(LinearProbingTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(LinearProbingTable& table) noexcept; // обмен содержимым таблиц за O(1)
 
-    void Insert(const K& key, const T& value); // добавление значения по ключу
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
     bool Remove(const K& key); // удаление по ключу
     bool Find(const K& key) const; // поиск по ключу
 
@@ -45,178 +94,673 @@ public:
 
     T Get(const K& key) const; // получение значения по ключу
 
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    // поиск по ключу другого типа при прозрачных хеш-функции и сравнении ключей
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    T* FindPtr(const Key& key) { return const_cast<T*>(FindValue(key)); }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    const T* FindPtr(const Key& key) const { return FindValue(key); }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    bool Find(const Key& key) const { return FindValue(key) != nullptr; }
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Save(const string& path) const; // запись снимка таблицы в файл (открывается через MappedTable)
+
     void Print() const; // вывод таблицы
 
     ~LinearProbingTable(); // деструктор (освобождение памяти)
 };
 
-// конструктор из размера, хеш-функции и шага пробирования
-template <typename K, typename T>
-LinearProbingTable<K, T>::LinearProbingTable(int tableSize, int (*h)(K), int q) {
-	this->capacity = tableSize; // запоминаем в ёмкости переданный размер
+// конструктор из размера, хеш-функции, шага пробирования, коэффициента заполнения, способа удаления и сравнения ключей
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::LinearProbingTable(int tableSize, const Hash& hasher, int q, double maxLoadFactor, bool backwardShift, const KeyEqual& keyEqual) : hasher(hasher), keyEqual(keyEqual) {
+	this->capacity = Capacity::Round(tableSize); // запоминаем в ёмкости допустимый размер, не меньший переданного
 	this->size = 0; // изначально нет элементов
+	this->used = 0; // и нет занятых ячеек
 	this->q = q;
+	this->maxLoadFactor = min(maxLoadFactor, MAX_LOAD_FACTOR); // без свободных ячеек не завершится сдвиг назад
+	this->backwardShift = backwardShift && q == 1; // сдвиг назад возможен только при единичном шаге
 
-	this->cells = new HashNode[tableSize]; // выделяем память под ячейки
+	this->cells.Allocate(capacity); // выделяем память под ячейки (все ячейки сразу свободны)
 
-	// делаем все ячейки свободными
-	for (int i = 0; i < tableSize; i++)
-		cells[i].state = FREE;
+	// переноса пока нет, старый массив не выделен
+	this->oldCapacity = 0;
+	this->oldSize = 0;
+	this->migrated = 0;
+}
 
-	this->h = h; // запоминаем указатель на функцию
+// конструктор из размера, указателя на хеш-функцию, шага пробирования, коэффициента заполнения и способа удаления
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::LinearProbingTable(int tableSize, int (*h)(K), int q, double maxLoadFactor, bool backwardShift) : LinearProbingTable(tableSize, Hash(h), q, maxLoadFactor, backwardShift) {
 }
 
 // конструктор копирования
-template <typename K, typename T>
-LinearProbingTable<K, T>::LinearProbingTable(const LinearProbingTable& table) {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::LinearProbingTable(const LinearProbingTable& table) : hasher(table.hasher), keyEqual(table.keyEqual) {
 	capacity = table.capacity; // копируем ёмкость
 	size = table.size; // копируем количество элементов
+	used = table.used; // копируем количество занятых ячеек
 	q = table.q; // копируем шаг пробирования
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
+	backwardShift = table.backwardShift; // копируем способ удаления
 
-	cells = new HashNode[capacity]; // выделяем память под массив
-
-	h = table.h; // копируем указатель на функцию
+	if (capacity > 0)
+		cells.Allocate(capacity); // выделяем память под массив (у перемещённой таблицы его нет)
 
 	// проходимся по всем ячейкам таблицы и копируем их содержимое
 	for (int i = 0; i < capacity; i++) {
-		cells[i].value = table.cells[i].value;
-		cells[i].key = table.cells[i].key;
-		cells[i].state = table.cells[i].state;
+		cells.SetState(i, table.cells.GetState(i));
+
+		// содержимое свободных и удалённых ячеек не нужно
+		if (table.cells.GetState(i) == BUSY) {
+			cells.Construct(i, table.cells.Key(i), table.cells.Value(i));
+		}
 	}
+
+	oldCapacity = table.oldCapacity;
+	oldSize = table.oldSize;
+	migrated = table.migrated;
+
+	// если у копируемой таблицы идёт перенос, то копируем и старый массив
+	if (table.oldCells.IsAllocated()) {
+		oldCells.Allocate(oldCapacity);
+
+		for (int i = 0; i < oldCapacity; i++) {
+			oldCells.SetState(i, table.oldCells.GetState(i));
+
+			// содержимое свободных и удалённых ячеек не нужно
+			if (table.oldCells.GetState(i) == BUSY) {
+				oldCells.Construct(i, table.oldCells.Key(i), table.oldCells.Value(i));
+			}
+		}
+	}
+}
+
+// конструктор перемещения: таблица забирает массивы, а перемещённой остаётся нулевая ёмкость без выделенной памяти
+// (массив выделяется при следующей вставке)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::LinearProbingTable(LinearProbingTable&& table) noexcept : hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = 0;
+	size = 0;
+	used = 0;
+	q = table.q;
+	maxLoadFactor = table.maxLoadFactor;
+	backwardShift = table.backwardShift;
+
+	oldCapacity = 0;
+	oldSize = 0;
+	migrated = 0;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>& LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::operator=(LinearProbingTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Swap(LinearProbingTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(size, table.size);
+	swap(used, table.used);
+	swap(q, table.q);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(backwardShift, table.backwardShift);
+	swap(cells, table.cells);
+	swap(oldCells, table.oldCells);
+	swap(oldCapacity, table.oldCapacity);
+	swap(oldSize, table.oldSize);
+	swap(migrated, table.migrated);
+	swap(hasher, table.hasher);
+	swap(keyEqual, table.keyEqual);
 }
 
-// добавление значения по ключу
-template <typename K, typename T>
-void LinearProbingTable<K, T>::Insert(const K& key, const T& value) {
+// поиск индекса ячейки с ключом (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename Key>
+int LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindIndex(const Storage& nodes, int length, const Key& key, uint64_t hash) const {
+	if (length == 0)
+		return -1; // у перемещённой таблицы нет массива
+
 	int sequenceLength = 0; // начальная длина пробной последовательности равна нулю
-	int hash = h(key); // получаем хеш от ключа
+	int step = CoprimeStep(q, length); // шаг пробирования внутри массива, обходящий все ячейки
+	int index = Capacity::Index(hash, length); // начальная ячейка
 
-	while (sequenceLength < capacity) {
-		int index = (hash + sequenceLength * q) % capacity;
+	while (sequenceLength < length) {
+		// если нашли занятую клетку с нужным ключом
+		if (nodes.GetState(index) == BUSY && keyEqual(nodes.Key(index), key))
+			return index; // значит нашли
 
-		if (cells[index].state != BUSY) { // если нашли незанятую ячейку
-			cells[index].key = key; // сохраняем ключ
-			cells[index].value = value; // сохраняем значение
-			cells[index].state = BUSY; // ячейка становится занятой
+		// если нашли свободную ячейку
+		if (nodes.GetState(index) == FREE)
+			return -1; // значит нет элемента
 
-			size++; // увеличиваем счётчик числа элементов
-			return; // выходим
-		}
+		index += step; // переходим к следующей ячейке без деления
+		if (index >= length)
+			index -= length;
 
 		sequenceLength++; // увеличиваем длину пробной последовательности
 	}
 
-	// прошли всю таблицу
-	throw string("Unable to insert value with this key"); // бросаем исключение
+	return -1; // не нашли во всей таблице
 }
 
-// удаление по ключу
-template <typename K, typename T>
-bool LinearProbingTable<K, T>::Remove(const K& key) {
-	int sequenceLength = 0; // начальная длина пробной последовательности равна нулю
-	int hash = h(key); // получаем хеш от ключа
+// поиск значения в текущем и старом массивах (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename Key>
+const T* LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindValue(const Key& key) const {
+	return FindValue(key, hasher(key));
+}
 
-	while (sequenceLength < capacity) {
-		int index = (hash + sequenceLength * q) % capacity;
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename Key>
+const T* LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindValue(const Key& key, uint64_t hash) const {
+	int index = FindIndex(cells, capacity, key, hash); // ищем элемент в текущем массиве
+
+	if (index != -1)
+		return &cells.Value(index); // значит нашли
+
+	// если идёт перенос, то ищем элемент в старом массиве
+	if (oldCells.IsAllocated() && (index = FindIndex(oldCells, oldCapacity, key, hash)) != -1)
+		return &oldCells.Value(index);
+
+	return nullptr; // не нашли
+}
+
+// хеш ключа с предварительной загрузкой начальной ячейки в кеш
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+uint64_t LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::PrefetchKey(const K& key) const {
+	uint64_t hash = hasher(key);
 
-		// если нашли занятую нужным ключом ячейку
-		if (cells[index].state == BUSY && cells[index].key == key) {
-			cells[index].state = REMOVED; // помечаем её как удалённую
-			size--; // уменьшаем счётчик числа элементов
+	if (capacity > 0) // у перемещённой таблицы нет массива
+		cells.Prefetch(Capacity::Index(hash, capacity));
 
-			return true; // возвращаем истину
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+const T* LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindHashed(const K& key, uint64_t hash) const {
+	return FindValue(key, hash);
+}
+
+// поиск ячейки с ключом или первой незанятой ячейки для его вставки (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+int LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindSlot(const K& key, bool& found) const {
+	int sequenceLength = 0; // начальная длина пробной последовательности равна нулю
+	int step = CoprimeStep(q, capacity); // шаг пробирования внутри массива, обходящий все ячейки
+	int index = Capacity::Index(hasher(key), capacity); // начальная ячейка
+	int slot = -1; // первая удалённая ячейка пробной последовательности
+
+	found = false;
+
+	while (sequenceLength < capacity) {
+		if (cells.GetState(index) == BUSY) {
+			// если нашли занятую клетку с нужным ключом
+			if (keyEqual(cells.Key(index), key)) {
+				found = true;
+				return index; // значит нашли
+			}
+		}
+		else if (cells.GetState(index) == FREE) {
+			return slot == -1 ? index : slot; // ключа нет: вставляем в первую удалённую ячейку или в эту свободную
+		}
+		else if (slot == -1) {
+			slot = index; // запоминаем первую удалённую ячейку
 		}
 
-		// если нашли свободную ячейку
-		if (cells[index].state == FREE)
-			return false; // возвращаем ложь
+		index += step; // переходим к следующей ячейке без деления
+		if (index >= capacity)
+			index -= capacity;
 
 		sequenceLength++; // увеличиваем длину пробной последовательности
 	}
 
-	return false; // не нашли во всей таблице, возвращаем ложь
+	return slot; // прошли всю пробную последовательность
 }
 
-// поиск по ключу
-template <typename K, typename T>
-bool LinearProbingTable<K, T>::Find(const K& key) const {
+// запись элемента в незанятую ячейку текущего массива
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename KeyArg, typename ValueArg>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Store(int index, KeyArg&& key, ValueArg&& value) {
+	if (cells.GetState(index) == FREE)
+		used++; // свободная ячейка становится использованной
+
+	cells.Construct(index, forward<KeyArg>(key), forward<ValueArg>(value)); // создаём ключ и значение в ячейке
+	cells.SetState(index, BUSY); // ячейка становится занятой
+}
+
+// запись элемента в текущий массив (индекс ячейки или -1, если нет места)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename KeyArg, typename ValueArg>
+int LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Place(KeyArg&& key, ValueArg&& value) {
 	int sequenceLength = 0; // начальная длина пробной последовательности равна нулю
-	int hash = h(key); // получаем хеш от ключа
+	int step = CoprimeStep(q, capacity); // шаг пробирования внутри массива, обходящий все ячейки
+	int index = Capacity::Index(hasher(key), capacity); // начальная ячейка
 
 	while (sequenceLength < capacity) {
-		int index = (hash + sequenceLength * q) % capacity; // ищем индекс элемента
-
-		// если нашли занятую клетку с нужным ключом
-		if (cells[index].state == BUSY && cells[index].key == key)
-			return true; // значит нашли
+		if (cells.GetState(index) != BUSY) { // если нашли незанятую ячейку
+			Store(index, forward<KeyArg>(key), forward<ValueArg>(value));
+			return index; // выходим
+		}
 
-		// если нашли свободную ячейку
-		if (cells[index].state == FREE)
-			return false; // значит нет элемента
+		index += step; // переходим к следующей ячейке без деления
+		if (index >= capacity)
+			index -= capacity;
 
 		sequenceLength++; // увеличиваем длину пробной последовательности
 	}
 
-	return false; // не нашли во всей таблице
+	return -1; // прошли всю пробную последовательность
 }
 
-template <typename K, typename T>
-void LinearProbingTable<K, T>::Clear() {
-	for (int i = 0; i < capacity; i++)
-		cells[i].state = FREE;
+// начало расширения таблицы
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Grow() {
+	// если предыдущий перенос не завершён, то перестраиваем таблицу целиком
+	if (oldCells.IsAllocated()) {
+		Rebuild(capacity * 2);
+		return;
+	}
+
+	// если ячейки заняты в основном удалёнными элементами, то достаточно избавиться от них
+	int newCapacity = size * 2 > maxLoadFactor * capacity ? Capacity::Round(capacity * 2ll) : capacity;
+
+	oldCells = cells; // текущий массив становится старым
+	oldCapacity = capacity;
+	oldSize = size;
+	migrated = 0;
+
+	capacity = newCapacity;
+	used = 0;
+	cells.Allocate(capacity); // выделяем память под новый массив
+}
+
+// перенос части ячеек из старого массива
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::MigrateStep() {
+	if (!oldCells.IsAllocated())
+		return; // переноса нет
+
+	for (int i = 0; i < REHASH_STEP && migrated < oldCapacity && oldSize > 0; i++, migrated++) {
+		if (oldCells.GetState(migrated) != BUSY)
+			continue; // свободные и удалённые ячейки не переносим
+
+		if (Place(move(oldCells.Key(migrated)), move(oldCells.Value(migrated))) == -1) {
+			Rebuild(capacity * 2); // не удалось разместить элемент, перестраиваем таблицу целиком
+			return;
+		}
+
+		oldCells.Destroy(migrated); // перемещённый элемент больше не нужен
+		oldCells.SetState(migrated, REMOVED); // не разрываем пробные последовательности старого массива
+		oldSize--;
+	}
+
+	// если все элементы перенесены, то освобождаем старый массив
+	if (migrated == oldCapacity || oldSize == 0) {
+		oldCells.Free();
+	}
+}
+
+// полное перестроение таблицы (элементы перемещаются, а не копируются)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Rebuild(int newCapacity) {
+	vector<pair<Storage, int>> sources = { make_pair(cells, capacity) }; // массивы с ещё не перенесёнными элементами
+
+	if (oldCells.IsAllocated())
+		sources.push_back(make_pair(oldCells, oldCapacity));
+
+	oldCells = Storage(); // старый массив освобождается вместе с остальными исходными
+	oldSize = 0;
+	capacity = Capacity::Round(newCapacity);
+
+	while (true) {
+		used = 0;
+		cells.Allocate(capacity); // выделяем память под новый массив
+
+		bool placed = true;
+
+		for (size_t s = 0; s < sources.size() && placed; s++) {
+			Storage& source = sources[s].first;
+
+			for (int i = 0; i < sources[s].second && placed; i++) {
+				if (source.GetState(i) != BUSY)
+					continue;
+
+				placed = Place(move(source.Key(i)), move(source.Value(i))) != -1; // при неудаче элемент не изменяется
+
+				if (placed) {
+					source.Destroy(i);
+					source.SetState(i, FREE); // перемещённый элемент больше не принадлежит исходному массиву
+				}
+			}
+		}
+
+		if (placed)
+			break;
+
+		// уже перемещённые элементы остались в новом массиве, поэтому он тоже становится исходным для массива большей ёмкости
+		sources.push_back(make_pair(cells, capacity));
+		capacity = Capacity::Round(capacity * 2ll);
+	}
+
+	for (size_t s = 0; s < sources.size(); s++)
+		sources[s].first.Free();
+}
+
+// удаление элемента текущего массива со сдвигом назад
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::ShiftBack(int index) {
+	int next = index; // индекс проверяемой ячейки кластера
+
+	while (true) {
+		next = next + 1 == capacity ? 0 : next + 1; // переходим к следующей ячейке
+
+		if (cells.GetState(next) == FREE)
+			break; // кластер закончился
+
+		int home = Capacity::Index(hasher(cells.Key(next)), capacity); // начальная ячейка пробной последовательности элемента
+
+		// если начальная ячейка лежит циклически в (index, next], то элемент остаётся на месте
+		if (index <= next ? (index < home && home <= next) : (index < home || home <= next))
+			continue;
+
+		// иначе сдвигаем элемент в освободившуюся ячейку
+		cells.Key(index) = move(cells.Key(next));
+		cells.Value(index) = move(cells.Value(next));
+		index = next; // и освобождаем его прежнюю ячейку
+	}
+
+	cells.Destroy(index); // в последней ячейке остался перемещённый или удаляемый элемент
+	cells.SetState(index, FREE); // последняя освободившаяся ячейка становится свободной
+	used--; // уменьшаем счётчик занятых ячеек
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename KeyArg, typename ValueArg>
+pair<T*, bool> LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Emplace(KeyArg&& key, ValueArg&& value, bool assign) {
+	// у перемещённой таблицы массив выделяется только при первой вставке
+	if (capacity == 0) {
+		cells.Allocate(Capacity::Round(1));
+		capacity = Capacity::Round(1);
+	}
+
+	MigrateStep(); // переносим очередную часть старого массива
+
+	int index;
+
+	// если идёт перенос, то ключ может находиться в старом массиве
+	if (oldCells.IsAllocated() && (index = FindIndex(oldCells, oldCapacity, key, hasher(key))) != -1) {
+		if (assign)
+			oldCells.Value(index) = forward<ValueArg>(value); // обновляем значение на месте
+
+		return make_pair(&oldCells.Value(index), false);
+	}
+
+	bool found;
+	index = FindSlot(key, found); // за один проход ищем ключ и запоминаем место для вставки
+
+	if (found) {
+		if (assign)
+			cells.Value(index) = forward<ValueArg>(value); // обновляем значение на месте
+
+		return make_pair(&cells.Value(index), false);
+	}
+
+	// удалённая ячейка используется повторно без расширения, свободная - если не будет превышен коэффициент заполнения
+	if (index != -1 && (cells.GetState(index) == REMOVED || used + 1 <= maxLoadFactor * capacity)) {
+		Store(index, forward<KeyArg>(key), forward<ValueArg>(value));
+	}
+	else {
+		// если после вставки будет превышен коэффициент заполнения, то расширяем таблицу
+		if (used + 1 > maxLoadFactor * capacity)
+			Grow();
+
+		// если пробная последовательность не содержит незанятых ячеек, то перестраиваем таблицу
+		// (при неудаче Place не забирает ключ и значение, поэтому повторная попытка безопасна)
+		while ((index = Place(forward<KeyArg>(key), forward<ValueArg>(value))) == -1)
+			Rebuild(capacity * 2);
+	}
+
+	size++; // увеличиваем счётчик числа элементов
+
+	return make_pair(&cells.Value(index), true);
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+bool LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Remove(const K& key) {
+	MigrateStep(); // переносим очередную часть старого массива
+
+	int index = FindIndex(cells, capacity, key, hasher(key)); // ищем элемент в текущем массиве
+
+	// если нашли занятую нужным ключом ячейку
+	if (index != -1) {
+		if (backwardShift) {
+			ShiftBack(index); // сдвигаем следующие элементы кластера назад
+		}
+		else {
+			cells.Destroy(index); // уничтожаем элемент
+			cells.SetState(index, REMOVED); // и помечаем ячейку как удалённую
+		}
+
+		size--; // уменьшаем счётчик числа элементов
+
+		return true; // возвращаем истину
+	}
+
+	// если идёт перенос, то ищем элемент в старом массиве
+	if (oldCells.IsAllocated() && (index = FindIndex(oldCells, oldCapacity, key, hasher(key))) != -1) {
+		oldCells.Destroy(index); // уничтожаем элемент
+		oldCells.SetState(index, REMOVED); // и помечаем ячейку как удалённую
+		oldSize--; // уменьшаем счётчик не перенесённых элементов
+		size--; // уменьшаем счётчик числа элементов
+
+		return true; // возвращаем истину
+	}
+
+	return false; // не нашли, возвращаем ложь
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+bool LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Find(const K& key) const {
+	return FindValue(key) != nullptr;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Clear() {
+	Release(cells, capacity); // вместо обхода ячеек массив заменяется новым обнулённым
+	Release(oldCells, oldCapacity); // старый массив больше не нужен
+
+	if (capacity > 0)
+		cells.Allocate(capacity);
+	oldSize = 0;
 
 	size = 0; // обнуляем счётчик числа элементов
+	used = 0; // и счётчик занятых ячеек
 }
 
-template <typename K, typename T>
-int LinearProbingTable<K, T>::GetSize() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+int LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::GetSize() const {
 	return size; // возвращаем размер
 }
 
-template <typename K, typename T>
-bool LinearProbingTable<K, T>::IsEmpty() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+bool LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::IsEmpty() const {
 	return size == 0; // таблица пуста, если нет элементов
 }
 
 // получение значения по ключу
-template <typename K, typename T>
-T LinearProbingTable<K, T>::Get(const K& key) const {
-	int sequenceLength = 0;
-	int hash = h(key); // получаем хеш от ключа
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+T LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Get(const K& key) const {
+	const T *value = FindValue(key);
 
-	while (sequenceLength < capacity) {
-		int index = (hash + sequenceLength * q) % capacity; // ищем индекс элемента
+	if (value == nullptr)
+		throw string("No value with this key"); // бросаем исключение
 
-		// если нашли занятую клетку с нужным ключом
-		if (cells[index].state == BUSY && cells[index].key == key)
-			return cells[index].value; // значит нашли
+	return *value; // возвращаем значение
+}
 
-		// если нашли свободную ячейку, значит нет такого элемента
-		if (cells[index].state == FREE)
-			throw string("No value with this key"); // бросаем исключение
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+T* LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindPtr(const K& key) {
+	return const_cast<T*>(FindValue(key));
+}
 
-		sequenceLength++; // увеличиваем длину пробной последовательности
-	}
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+const T* LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindPtr(const K& key) const {
+	return FindValue(key);
+}
 
-	// обошли всю таблицу
-	throw string("No value with this key"); // бросаем исключение
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+pair<T*, bool> LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::TryEmplace(K key, T value) {
+	return Emplace(move(key), move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+pair<T*, bool> LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::InsertOrAssign(K key, T value) {
+	return Emplace(move(key), move(value), true);
 }
 
 // деструктор (освобождения памяти)
-template <typename K, typename T>
-LinearProbingTable<K, T>::~LinearProbingTable() {
-	delete[] cells; // удаляем массив ячеек
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::~LinearProbingTable() {
+	Release(cells, capacity); // удаляем массив ячеек
+	Release(oldCells, oldCapacity); // и старый массив, если он есть
+}
+
+// уничтожение элементов массива и освобождение его памяти
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Release(Storage& nodes, int length) {
+	if (!nodes.IsAllocated())
+		return;
+
+	// тривиально уничтожаемые элементы не требуют обхода массива
+	if (!is_trivially_destructible<K>::value || !is_trivially_destructible<T>::value)
+		for (int i = 0; i < length; i++)
+			if (nodes.GetState(i) == BUSY)
+				nodes.Destroy(i);
+
+	nodes.Free();
+}
+
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+TableStats LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.migrating = oldCells.IsAllocated();
+	stats.bytes = sizeof(*this) + Storage::Bytes(capacity) + (oldCells.IsAllocated() ? Storage::Bytes(oldCapacity) : 0);
+
+	// длины поиска вычисляются одним проходом по массиву, а не поиском из каждой ячейки
+	StepProbes probes(capacity, CoprimeStep(q, capacity), [this](int i) { return cells.GetState(i) == FREE; });
+
+	for (int i = 0; i < capacity; i++) {
+		if (cells.GetState(i) == REMOVED)
+			stats.tombstones++;
+		else if (cells.GetState(i) == BUSY)
+			stats.AddHit(probes.Hit(Capacity::Index(hasher(cells.Key(i)), capacity), i));
+
+		stats.AddMiss(probes.Miss(i)); // неуспешный поиск, начинающийся в ячейке i
+	}
+
+	// ещё не перенесённые элементы ищутся сначала в текущем массиве, а затем в старом
+	if (oldCells.IsAllocated()) {
+		StepProbes oldProbes(oldCapacity, CoprimeStep(q, oldCapacity), [this](int i) { return oldCells.GetState(i) == FREE; });
+
+		for (int i = 0; i < oldCapacity; i++) {
+			if (oldCells.GetState(i) == REMOVED) {
+				stats.tombstones++;
+			}
+			else if (oldCells.GetState(i) == BUSY) {
+				uint64_t hash = hasher(oldCells.Key(i));
+				stats.AddHit(probes.Miss(Capacity::Index(hash, capacity)) + oldProbes.Hit(Capacity::Index(hash, oldCapacity), i));
+			}
+		}
+	}
+
+	stats.AddClusters(capacity, [this](int i) { return cells.GetState(i) != FREE; });
+	return stats;
 }
 
 // оператор вывода в поток
-template <typename K, typename T>
-void LinearProbingTable<K, T>::Print() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Print() const {
     for (int i = 0; i < capacity; i++) {
-		if (cells[i].state != BUSY)
+		if (cells.GetState(i) != BUSY)
 			continue; // если ячейка не занята, то переходим к следующему элементу
 
 		cout << "[" << i << "]: "; // выводим номер ячейки
-		cout << cells[i].value << "(" << cells[i].key << ") "; // выводим содержимое ячейки
+		cout << cells.Value(i) << "(" << cells.Key(i) << ") "; // выводим содержимое ячейки
 		cout << endl; // переходим на новую строку
 	}
+
+	// выводим ещё не перенесённые элементы старого массива
+	for (int i = 0; oldCells.IsAllocated() && i < oldCapacity; i++) {
+		if (oldCells.GetState(i) != BUSY)
+			continue;
+
+		cout << "[old " << i << "]: "; // выводим номер ячейки старого массива
+		cout << oldCells.Value(i) << "(" << oldCells.Key(i) << ") ";
+		cout << endl;
+	}
+}
+
+// запись снимка таблицы в файл: ячейки записываются на своих местах, поэтому открытой таблице не нужно перестроение
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Save(const string& path) const {
+	// снимок содержит один массив, поэтому незавершённый перенос сначала завершается в копии таблицы
+	if (oldCells.IsAllocated()) {
+		LinearProbingTable table(*this);
+		table.Rebuild(table.capacity);
+		table.Save(path);
+		return;
+	}
+
+	// у перемещённой таблицы нет массива, поэтому записывается пустая таблица минимальной ёмкости
+	if (capacity == 0) {
+		LinearProbingTable(1, hasher, q, maxLoadFactor, backwardShift, keyEqual).Save(path);
+		return;
+	}
+
+	SnapshotWriter<K, T> writer(capacity, size, q, Capacity::Index(SNAPSHOT_INDEX_PROBE, capacity));
+
+	for (int i = 0; i < capacity; i++) {
+		if (cells.GetState(i) == BUSY)
+			writer.Add(cells.Key(i), cells.Value(i));
+		else
+			writer.Add(cells.GetState(i));
+	}
+
+	writer.Write(path);
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void swap(LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>& table1, LinearProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>& table2) {
+	table1.Swap(table2);
 }
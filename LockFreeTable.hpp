@@ -0,0 +1,657 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include "HashFunctions.hpp"
+#include "CapacityPolicy.hpp"
+#include "TableStats.hpp"
+
+using namespace std;
+
+/*
+	Неблокирующая хеш таблица с линейным пробированием для целых ключей и значений
+	Ячейка - пара атомарных слов: ключ (0 - свободная ячейка) и значение с флагами.
+	Ключ занимает ячейку через CAS и больше её не покидает, удаление лишь помечает
+	значение удалённым, поэтому пробная последовательность ключа не прерывается, как и при
+	пометке удалённых ячеек в LinearProbingTable. Поиск выполняет только чтения.
+	При превышении коэффициента заполнения создаётся новый массив, и все пишущие
+	потоки помогают переносу: ячейки старого массива замораживаются (после этого
+	их нельзя изменить), копируются в новый массив, после чего новый массив
+	становится текущим. Читатели продолжают работать со старым массивом, пока
+	перенос не завершён, поэтому снятый массив попадает в список и освобождается,
+	когда завершены все операции, которые могли его получить. Для этого каждый поток
+	записывает в собственную запись (OperationEpochs) эпоху начала операции и
+	обнуляет её по завершении: поиск только пишет в свою строку кэша, без атомарных
+	операций чтения-изменения-записи над общими счётчиками. Снятый массив помечается
+	эпохой снятия и освобождается первой пишущей операцией (или сбором статистики),
+	завершившейся после всех операций, начатых до снятия, поэтому новые операции,
+	сколько бы их ни пересекалось, освобождение не задерживают
+*/
+
+// эпохи операций неблокирующих таблиц: поток публикует эпоху начала выполняемой операции в собственной записи
+class OperationEpochs {
+public:
+	// запись потока (занимает свою строку кэша, поэтому публикации разных потоков не мешают друг другу)
+	struct alignas(64) Record {
+		atomic<uint64_t> epoch; // эпоха начала выполняемой операции (0 - поток вне операций)
+		atomic<bool> owned; // запись принадлежит работающему потоку
+		Record *next; // следующая запись в списке всех записей
+	};
+
+	static Record* ThreadRecord(); // запись текущего потока
+	static uint64_t Current(); // текущая эпоха
+	static uint64_t Advance(); // переход к следующей эпохе (возвращает прежнюю)
+	static uint64_t Oldest(); // наименьшая эпоха выполняемых операций (UINT64_MAX, если операций нет)
+
+private:
+	// владение записью: поток занимает запись при первой операции и возвращает при завершении
+	struct Owner {
+		Record *record;
+
+		Owner() : record(Acquire()) {}
+		~Owner() { record->owned.store(false, memory_order_release); }
+	};
+
+	static inline atomic<uint64_t> epoch{1}; // эпохи начинаются с единицы, ноль означает отсутствие операции
+	static inline atomic<Record *> records{nullptr}; // записи потоков (не освобождаются и переиспользуются новыми потоками)
+
+	static Record* Acquire(); // поиск свободной записи или добавление новой
+};
+
+// запись текущего потока
+inline OperationEpochs::Record* OperationEpochs::ThreadRecord() {
+	thread_local Owner owner;
+
+	return owner.record;
+}
+
+// текущая эпоха
+inline uint64_t OperationEpochs::Current() {
+	return epoch.load();
+}
+
+// переход к следующей эпохе (возвращает прежнюю)
+inline uint64_t OperationEpochs::Advance() {
+	return epoch.fetch_add(1);
+}
+
+// наименьшая эпоха выполняемых операций (UINT64_MAX, если операций нет)
+inline uint64_t OperationEpochs::Oldest() {
+	uint64_t oldest = UINT64_MAX;
+
+	for (Record *record = records.load(); record != nullptr; record = record->next) {
+		uint64_t value = record->epoch.load();
+
+		if (value != 0 && value < oldest)
+			oldest = value;
+	}
+
+	return oldest;
+}
+
+// поиск свободной записи или добавление новой
+inline OperationEpochs::Record* OperationEpochs::Acquire() {
+	for (Record *record = records.load(); record != nullptr; record = record->next) {
+		bool owned = false;
+
+		if (!record->owned.load(memory_order_relaxed) && record->owned.compare_exchange_strong(owned, true))
+			return record;
+	}
+
+	Record *record = new Record;
+	record->epoch.store(0, memory_order_relaxed);
+	record->owned.store(true, memory_order_relaxed);
+	record->next = records.load();
+
+	while (!records.compare_exchange_weak(record->next, record))
+		;
+
+	return record;
+}
+
+template <typename Hash = DefaultHash<int>>
+class LockFreeTable {
+	static const uint64_t PRESENT = 1ull << 32; // в ячейке есть значение (для слова ключа - ячейка занята)
+	static const uint64_t SEALED = 1ull << 33; // ячейка заморожена для переноса
+	static const uint64_t COPIED = 1ull << 34; // значение замороженной ячейки уже скопировано в новый массив
+	static const uint64_t REMOVED = 1ull << 35; // значение удалено (в отличие от нуля - в ячейку уже писали)
+
+	static const int MIGRATE_CHUNK = 256; // число ячеек, переносимых потоком за раз
+
+    // ячейка: слово ключа и слово значения
+    struct Slot {
+    	atomic<uint64_t> key;
+    	atomic<uint64_t> value;
+    };
+
+    // массив ячеек
+    struct Array {
+    	int capacity; // ёмкость массива (степень двойки)
+    	Slot *slots; // ячейки
+    	atomic<int> used; // число занятых ключами ячеек
+
+    	atomic<Array *> next; // массив, в который выполняется перенос (nullptr, если переноса нет)
+    	atomic<int> claimed; // начало следующего блока ячеек для переноса
+    	atomic<int> migrated; // число перенесённых ячеек
+    	atomic<bool> done; // все ячейки перенесены
+
+    	atomic<Array *> retired; // следующий массив в списке снятых
+    	uint64_t epoch; // эпоха снятия: массив могут использовать только операции, начатые не позже неё
+
+    	Array(int capacity) : capacity(capacity), slots(new Slot[capacity]), used(0), next(nullptr), claimed(0), migrated(0), done(false), retired(nullptr), epoch(0) {
+    		for (int i = 0; i < capacity; i++) {
+    			slots[i].key.store(0, memory_order_relaxed);
+    			slots[i].value.store(0, memory_order_relaxed);
+    		}
+    	}
+
+    	~Array() {
+    		delete[] slots;
+    	}
+    };
+
+    atomic<Array *> current; // текущий массив
+    mutable atomic<Array *> retired; // снятые с текущего, но ещё не освобождённые массивы
+    atomic<int> size; // число элементов в таблице
+    double maxLoadFactor; // максимальный коэффициент заполнения
+    Hash hasher; // хеш-функция
+
+    // выполняемая операция: пока она не завершена, массивы, снятые после её начала, не освобождаются
+    struct Operation {
+    	const LockFreeTable *table;
+    	OperationEpochs::Record *record; // запись потока
+    	bool outer; // операция не вложена в другую операцию потока (например, через хеш-функцию)
+    	bool reclaim; // освобождать снятые массивы по завершении
+
+    	// публикация эпохи упорядочена перед чтением текущего массива; вложенная операция покрыта более ранней эпохой внешней
+    	Operation(const LockFreeTable *table, bool reclaim) : table(table), record(OperationEpochs::ThreadRecord()), outer(record->epoch.load(memory_order_relaxed) == 0), reclaim(reclaim) {
+    		if (outer)
+    			record->epoch.store(OperationEpochs::Current());
+    	}
+
+    	~Operation() {
+    		if (!outer)
+    			return;
+
+    		record->epoch.store(0, memory_order_release);
+
+    		if (reclaim)
+    			table->Reclaim();
+    	}
+    };
+
+    static uint64_t KeyWord(int key) { return PRESENT | (uint32_t) key; } // слово занятой ключом ячейки
+    static uint64_t ValueWord(int value) { return PRESENT | (uint32_t) value; } // слово значения
+    static int Value(uint64_t word) { return (int) (uint32_t) word; } // значение из слова
+
+    bool Lookup(int key, int& value) const; // поиск значения по ключу (ложь, если нет)
+    template <typename Change>
+    uint64_t Write(int key, bool claim, Change change); // изменение слова значения ключа (возвращает прежнее слово)
+
+    void StartResize(Array *array); // создание нового массива и перенос
+    void Migrate(Array *array); // помощь в переносе и продвижение текущего массива
+    void MigrateSlot(Array *array, Array *next, int index); // заморозка и копирование ячейки
+    void Copy(Array *array, int key, uint64_t value); // добавление элемента при переносе (если ключа ещё нет)
+    void Retire(Array *first, Array *last) const; // добавление цепочки массивов в список снятых
+    void Reclaim() const; // освобождение снятых массивов, если их больше никто не использует
+    void Free(); // освобождение всех массивов
+
+public:
+    LockFreeTable(int tableSize, const Hash& hasher = Hash(), double maxLoadFactor = 0.75); // конструктор из размера, хеш-функции и коэффициента заполнения
+    LockFreeTable(int tableSize, int (*h)(int), double maxLoadFactor = 0.75); // конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+    LockFreeTable(const LockFreeTable& table) = delete;
+    LockFreeTable& operator=(const LockFreeTable& table) = delete;
+
+    void Insert(int key, int value); // добавление или замена значения по ключу
+    bool TryEmplace(int key, int value); // добавление, если ключа нет (истина, если добавили)
+    int Add(int key, int delta); // прибавление к значению (отсутствующее значение считается нулём), возвращает новое значение
+    bool Remove(int key); // удаление по ключу
+    bool Find(int key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы (без одновременных операций других потоков)
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+    int GetCapacity() const; // получение ёмкости текущего массива
+
+    int Get(int key) const; // получение значения по ключу
+    bool TryGet(int key, int& value) const; // получение значения по ключу без исключения (ложь, если нет)
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска (при одновременных изменениях - приблизительная)
+
+    void Print() const; // вывод таблицы (без одновременных операций других потоков)
+
+    ~LockFreeTable(); // деструктор (освобождение памяти)
+};
+
+// конструктор из размера, хеш-функции и коэффициента заполнения
+template <typename Hash>
+LockFreeTable<Hash>::LockFreeTable(int tableSize, const Hash& hasher, double maxLoadFactor) : retired(nullptr), size(0), hasher(hasher) {
+	this->maxLoadFactor = maxLoadFactor;
+
+	current.store(new Array(PowerOfTwoCapacity::Round(max(2, tableSize))));
+}
+
+// конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+template <typename Hash>
+LockFreeTable<Hash>::LockFreeTable(int tableSize, int (*h)(int), double maxLoadFactor) : LockFreeTable(tableSize, Hash(h), maxLoadFactor) {
+}
+
+// поиск значения по ключу (ложь, если нет)
+template <typename Hash>
+bool LockFreeTable<Hash>::Lookup(int key, int& value) const {
+	Operation operation(this, false); // поиск только публикует эпоху, освобождением занимаются пишущие операции
+	uint64_t hash = hasher(key);
+	uint64_t keyWord = KeyWord(key);
+	Array *array = current.load(); // загрузка упорядочена после публикации эпохи
+
+	while (true) {
+		int mask = array->capacity - 1;
+		int index = PowerOfTwoCapacity::Index(hash, array->capacity);
+		uint64_t word = SEALED; // просмотр всего массива без результата равносилен замороженной ячейке
+
+		for (int i = 0; i < array->capacity; i++) {
+			Slot& slot = array->slots[index];
+			uint64_t k = slot.key.load(memory_order_acquire);
+
+			// значение свободной ячейки может принадлежать ключу, занявшему её после чтения, поэтому берём только флаг заморозки
+			if (k == 0) {
+				word = slot.value.load(memory_order_acquire) & SEALED;
+				break;
+			}
+
+			if (k == keyWord) {
+				word = slot.value.load(memory_order_acquire);
+				break;
+			}
+
+			index = (index + 1) & mask;
+		}
+
+		// пока перенос не завершён, в новый массив пишут только переносящие потоки, и замороженное значение актуально
+		if ((word & SEALED) && array->done.load(memory_order_acquire)) {
+			array = array->next.load(memory_order_acquire);
+			continue;
+		}
+
+		if (!(word & PRESENT))
+			return false;
+
+		value = Value(word);
+		return true;
+	}
+}
+
+// изменение слова значения ключа (возвращает прежнее слово)
+template <typename Hash>
+template <typename Change>
+uint64_t LockFreeTable<Hash>::Write(int key, bool claim, Change change) {
+	Operation operation(this, true);
+	uint64_t hash = hasher(key);
+	uint64_t keyWord = KeyWord(key);
+
+	while (true) {
+		Array *array = current.load();
+
+		// во время переноса сначала помогаем его завершить
+		if (array->next.load(memory_order_acquire) != nullptr) {
+			Migrate(array);
+			continue;
+		}
+
+		int mask = array->capacity - 1;
+		int index = PowerOfTwoCapacity::Index(hash, array->capacity);
+		Slot *slot = nullptr;
+
+		for (int i = 0; i < array->capacity && slot == nullptr; i++) {
+			Slot& candidate = array->slots[index];
+			uint64_t k = candidate.key.load(memory_order_acquire);
+
+			if (k == 0) {
+				if (!claim)
+					return 0; // ключа нет, а добавлять его не нужно
+
+				// занимаем свободную ячейку; если её занял другой поток тем же ключом, то используем её
+				if (candidate.key.compare_exchange_strong(k, keyWord, memory_order_acq_rel, memory_order_acquire)) {
+					if (array->used.fetch_add(1, memory_order_relaxed) + 1 > maxLoadFactor * array->capacity)
+						StartResize(array);
+
+					k = keyWord;
+				}
+			}
+
+			if (k == keyWord)
+				slot = &candidate;
+			else
+				index = (index + 1) & mask;
+		}
+
+		if (slot == nullptr) {
+			if (!claim)
+				return 0;
+
+			StartResize(array); // свободных ячеек нет
+			continue;
+		}
+
+		uint64_t word = slot->value.load(memory_order_acquire);
+
+		while (!(word & SEALED)) {
+			uint64_t next = change(word);
+
+			if (next == word || slot->value.compare_exchange_weak(word, next, memory_order_acq_rel, memory_order_acquire)) {
+				if (!(word & PRESENT) && (next & PRESENT))
+					size.fetch_add(1, memory_order_relaxed);
+				else if ((word & PRESENT) && !(next & PRESENT))
+					size.fetch_sub(1, memory_order_relaxed);
+
+				return word;
+			}
+		}
+
+		Migrate(array); // ячейка заморожена: завершаем перенос и повторяем операцию в новом массиве
+	}
+}
+
+// создание нового массива и перенос
+template <typename Hash>
+void LockFreeTable<Hash>::StartResize(Array *array) {
+	if (array->next.load(memory_order_acquire) == nullptr) {
+		// если ячейки заняты в основном удалёнными ключами, то ёмкость не меняется
+		int capacity = size.load(memory_order_relaxed) * 2 >= maxLoadFactor * array->capacity ? array->capacity * 2 : array->capacity;
+		Array *next = new Array(capacity);
+		Array *expected = nullptr;
+
+		if (!array->next.compare_exchange_strong(expected, next, memory_order_acq_rel))
+			delete next; // перенос уже начал другой поток
+	}
+
+	Migrate(array);
+}
+
+// помощь в переносе и продвижение текущего массива
+template <typename Hash>
+void LockFreeTable<Hash>::Migrate(Array *array) {
+	Array *next = array->next.load(memory_order_acquire);
+
+	// переносим свободные блоки ячеек
+	while (!array->done.load(memory_order_acquire)) {
+		int start = array->claimed.fetch_add(MIGRATE_CHUNK, memory_order_relaxed);
+
+		if (start >= array->capacity)
+			break;
+
+		int end = min(start + MIGRATE_CHUNK, array->capacity);
+
+		for (int i = start; i < end; i++)
+			MigrateSlot(array, next, i);
+
+		if (array->migrated.fetch_add(end - start, memory_order_acq_rel) + end - start == array->capacity)
+			array->done.store(true, memory_order_release);
+	}
+
+	// блоки разобраны, но ещё переносятся другими потоками: не ждём их, а переносим все ячейки сами (перенос ячейки идемпотентен)
+	if (!array->done.load(memory_order_acquire)) {
+		for (int i = 0; i < array->capacity; i++)
+			MigrateSlot(array, next, i);
+
+		array->done.store(true, memory_order_release);
+	}
+
+	Array *expected = array;
+
+	// старый массив может читаться другими потоками: эпоха снятия берётся после замены текущего массива
+	if (current.compare_exchange_strong(expected, next)) {
+		array->epoch = OperationEpochs::Advance();
+		Retire(array, array);
+	}
+}
+
+// заморозка и копирование ячейки
+template <typename Hash>
+void LockFreeTable<Hash>::MigrateSlot(Array *array, Array *next, int index) {
+	Slot& slot = array->slots[index];
+	uint64_t word = slot.value.load(memory_order_acquire);
+
+	while (!(word & SEALED) && !slot.value.compare_exchange_weak(word, word | SEALED, memory_order_acq_rel, memory_order_acquire))
+		;
+
+	if ((word & PRESENT) && !(word & COPIED)) {
+		// после заморозки значение не меняется, поэтому все копирующие потоки записывают одно и то же
+		Copy(next, Value(slot.key.load(memory_order_acquire)), word & ~(SEALED | COPIED));
+		slot.value.store(word | SEALED | COPIED, memory_order_release);
+	}
+}
+
+// добавление элемента при переносе (если ключа ещё нет)
+template <typename Hash>
+void LockFreeTable<Hash>::Copy(Array *array, int key, uint64_t value) {
+	uint64_t keyWord = KeyWord(key);
+	int mask = array->capacity - 1;
+	int index = PowerOfTwoCapacity::Index(hasher(key), array->capacity);
+
+	while (true) {
+		Slot& slot = array->slots[index];
+		uint64_t k = slot.key.load(memory_order_acquire);
+
+		if (k == 0 && slot.key.compare_exchange_strong(k, keyWord, memory_order_acq_rel, memory_order_acquire)) {
+			array->used.fetch_add(1, memory_order_relaxed);
+			k = keyWord;
+		}
+
+		if (k == keyWord) {
+			// запись только в ячейку, значение которой ещё не писалось: опоздавший поток не должен вернуть удалённый элемент
+			uint64_t expected = 0;
+			slot.value.compare_exchange_strong(expected, value, memory_order_acq_rel);
+			return;
+		}
+
+		index = (index + 1) & mask;
+	}
+}
+
+// добавление цепочки массивов в список снятых
+template <typename Hash>
+void LockFreeTable<Hash>::Retire(Array *first, Array *last) const {
+	Array *head = retired.load();
+
+	do {
+		last->retired.store(head, memory_order_relaxed);
+	} while (!retired.compare_exchange_weak(head, first));
+}
+
+// освобождение снятых массивов, если их больше никто не использует
+template <typename Hash>
+void LockFreeTable<Hash>::Reclaim() const {
+	if (retired.load(memory_order_relaxed) == nullptr)
+		return;
+
+	Array *array = retired.exchange(nullptr);
+
+	if (array == nullptr)
+		return;
+
+	// снятый массив мог получить только поток, опубликовавший эпоху не позже эпохи снятия
+	uint64_t oldest = OperationEpochs::Oldest();
+	Array *first = nullptr; // массивы, которые ещё могут использоваться
+	Array *last = nullptr;
+
+	while (array != nullptr) {
+		Array *next = array->retired.load(memory_order_relaxed);
+
+		if (array->epoch < oldest) {
+			delete array;
+		}
+		else {
+			array->retired.store(first, memory_order_relaxed);
+			first = array;
+
+			if (last == nullptr)
+				last = array;
+		}
+
+		array = next;
+	}
+
+	if (first != nullptr)
+		Retire(first, last); // возвращаем их в список
+}
+
+// освобождение всех массивов
+template <typename Hash>
+void LockFreeTable<Hash>::Free() {
+	Array *array = current.load();
+
+	// новый массив, созданный для незавершённого переноса, ещё не стал текущим
+	if (array->next.load() != nullptr)
+		delete array->next.load();
+
+	delete array;
+	array = retired.exchange(nullptr);
+
+	while (array != nullptr) {
+		Array *next = array->retired.load();
+		delete array;
+		array = next;
+	}
+}
+
+// добавление или замена значения по ключу
+template <typename Hash>
+void LockFreeTable<Hash>::Insert(int key, int value) {
+	Write(key, true, [value](uint64_t) { return ValueWord(value); });
+}
+
+// добавление, если ключа нет (истина, если добавили)
+template <typename Hash>
+bool LockFreeTable<Hash>::TryEmplace(int key, int value) {
+	return !(Write(key, true, [value](uint64_t word) { return (word & PRESENT) ? word : ValueWord(value); }) & PRESENT);
+}
+
+// прибавление к значению (отсутствующее значение считается нулём), возвращает новое значение
+template <typename Hash>
+int LockFreeTable<Hash>::Add(int key, int delta) {
+	uint64_t word = Write(key, true, [delta](uint64_t word) { return ValueWord(((word & PRESENT) ? Value(word) : 0) + delta); });
+
+	return ((word & PRESENT) ? Value(word) : 0) + delta;
+}
+
+// удаление по ключу
+template <typename Hash>
+bool LockFreeTable<Hash>::Remove(int key) {
+	return Write(key, false, [](uint64_t word) { return (word & PRESENT) ? REMOVED : word; }) & PRESENT;
+}
+
+// поиск по ключу
+template <typename Hash>
+bool LockFreeTable<Hash>::Find(int key) const {
+	int value;
+
+	return Lookup(key, value);
+}
+
+// очистка таблицы (без одновременных операций других потоков)
+template <typename Hash>
+void LockFreeTable<Hash>::Clear() {
+	int capacity = current.load()->capacity;
+
+	Free();
+	current.store(new Array(capacity));
+	size.store(0);
+}
+
+template <typename Hash>
+int LockFreeTable<Hash>::GetSize() const {
+	return size.load(memory_order_relaxed); // возвращаем размер
+}
+
+template <typename Hash>
+bool LockFreeTable<Hash>::IsEmpty() const {
+	return GetSize() == 0; // таблица пуста, если нет элементов
+}
+
+template <typename Hash>
+int LockFreeTable<Hash>::GetCapacity() const {
+	return current.load(memory_order_acquire)->capacity;
+}
+
+// получение значения по ключу
+template <typename Hash>
+int LockFreeTable<Hash>::Get(int key) const {
+	int value;
+
+	if (!Lookup(key, value))
+		throw string("No value with this key"); // бросаем исключение
+
+	return value;
+}
+
+// получение значения по ключу без исключения (ложь, если нет)
+template <typename Hash>
+bool LockFreeTable<Hash>::TryGet(int key, int& value) const {
+	return Lookup(key, value);
+}
+
+// статистика заполнения и длин поиска текущего массива (при одновременных изменениях - приблизительная)
+template <typename Hash>
+TableStats LockFreeTable<Hash>::GetStats() const {
+	Reclaim(); // статистика показывает память после освобождения снятых массивов, которые уже никто не использует
+
+	Operation operation(this, false);
+	Array *array = current.load();
+	int mask = array->capacity - 1;
+
+	TableStats stats;
+	stats.size = size.load(memory_order_relaxed);
+	stats.capacity = array->capacity;
+	stats.migrating = array->next.load(memory_order_acquire) != nullptr;
+	stats.bytes = sizeof(*this);
+
+	stats.bytes += sizeof(Array) + array->capacity * sizeof(Slot);
+
+	// снятые, но ещё не освобождённые массивы тоже занимают память
+	for (Array *old = retired.load(); old != nullptr; old = old->retired.load())
+		stats.bytes += sizeof(Array) + old->capacity * sizeof(Slot);
+
+	// неуспешный поиск из ячейки идёт до первой свободной ячейки
+	StepProbes probes(array->capacity, 1, [array](int i) { return array->slots[i].key.load(memory_order_relaxed) == 0; });
+
+	for (int i = 0; i < array->capacity; i++) {
+		uint64_t k = array->slots[i].key.load(memory_order_acquire);
+
+		if (k != 0) {
+			// ключ удалённого элемента продолжает занимать ячейку
+			if (array->slots[i].value.load(memory_order_acquire) & PRESENT)
+				stats.AddHit(((i - PowerOfTwoCapacity::Index(hasher(Value(k)), array->capacity)) & mask) + 1);
+			else
+				stats.tombstones++;
+		}
+
+		stats.AddMiss(probes.Miss(i));
+	}
+
+	stats.AddClusters(array->capacity, [array](int i) { return array->slots[i].key.load(memory_order_relaxed) != 0; });
+	return stats;
+}
+
+// вывод таблицы (без одновременных операций других потоков)
+template <typename Hash>
+void LockFreeTable<Hash>::Print() const {
+	Array *array = current.load();
+
+	for (int i = 0; i < array->capacity; i++) {
+		uint64_t key = array->slots[i].key.load();
+		uint64_t value = array->slots[i].value.load();
+
+		if (key != 0 && (value & PRESENT))
+			cout << "[" << i << "]: " << Value(value) << "(" << Value(key) << ")" << endl;
+	}
+}
+
+// деструктор (освобождение памяти)
+template <typename Hash>
+LockFreeTable<Hash>::~LockFreeTable() {
+	Free();
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Snapshot.hpp"
+#include "HashFunctions.hpp"
+#include "CapacityPolicy.hpp"
+#include "TableStats.hpp"
+
+using namespace std;
+
+/*
+	Хеш таблица только для чтения, открытая из снимка таблицы с линейным
+	пробированием (LinearProbingTable::Save)
+	Файл отображается в память через mmap, и поиск выполняется прямо по ячейкам
+	файла тем же линейным пробированием, поэтому при открытии элементы не
+	вставляются и не копируются, а страницы файла загружаются при первом
+	обращении. Хеш-функция и способ выбора ёмкости должны совпадать с
+	использованными при записи снимка: это проверяется по нескольким ключам
+	при открытии. Ключи сравниваются оператором ==
+*/
+
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename Capacity = ModuloCapacity>
+class MappedTable {
+	typedef SnapshotCell<K, T> Cell;
+	typedef SnapshotCodec<K> KeyCodec;
+	typedef SnapshotCodec<T> ValueCodec;
+
+	static const int HASH_CHECKS = 16; // число ключей, по которым проверяется хеш-функция при открытии
+
+    void *data; // отображённый в память файл
+    size_t length; // длина файла
+
+    int capacity; // ёмкость таблицы
+    int size; // число элементов в таблице
+    int q; // шаг пробирования
+
+    const Cell *cells; // массив ячеек (в отображённом файле)
+    const char *heap; // куча строк (в отображённом файле)
+    uint64_t heapSize; // размер кучи строк
+
+    Hash hasher; // хеш-функция
+
+    void Validate(bool verify); // проверка заголовка, хеш-функции и (при verify) контрольной суммы
+    int FindIndex(const K& key) const; // поиск индекса ячейки с ключом (-1, если нет)
+
+public:
+    MappedTable(const string& path, const Hash& hasher = Hash(), bool verify = true); // открытие снимка с хеш-функцией (verify - проверять контрольную сумму)
+    MappedTable(const string& path, int (*h)(K), bool verify = true); // открытие снимка с указателем на хеш-функцию
+    MappedTable(const MappedTable& table) = delete;
+    MappedTable& operator=(const MappedTable& table) = delete;
+
+    bool Find(const K& key) const; // поиск по ключу
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+    int GetCapacity() const; // получение ёмкости
+
+    T Get(const K& key) const; // получение значения по ключу
+    bool TryGet(const K& key, T& value) const; // получение значения по ключу без исключения (ложь, если нет)
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Print() const; // вывод таблицы
+
+    ~MappedTable(); // деструктор (закрытие отображения)
+};
+
+// открытие снимка с хеш-функцией
+template <typename K, typename T, typename Hash, typename Capacity>
+MappedTable<K, T, Hash, Capacity>::MappedTable(const string& path, const Hash& hasher, bool verify) : hasher(hasher) {
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd == -1)
+		throw string("Unable to open file '") + path + "'";
+
+	struct stat info;
+
+	if (fstat(fd, &info) == -1 || (size_t) info.st_size < sizeof(SnapshotHeader)) {
+		close(fd);
+		throw string("File '") + path + "' is not a table snapshot";
+	}
+
+	length = info.st_size;
+	data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // отображение остаётся действительным после закрытия файла
+
+	if (data == MAP_FAILED)
+		throw string("Unable to map file '") + path + "'";
+
+	try {
+		Validate(verify);
+	}
+	catch (...) {
+		munmap(data, length);
+		throw;
+	}
+}
+
+// открытие снимка с указателем на хеш-функцию
+template <typename K, typename T, typename Hash, typename Capacity>
+MappedTable<K, T, Hash, Capacity>::MappedTable(const string& path, int (*h)(K), bool verify) : MappedTable(path, Hash(h), verify) {
+}
+
+// проверка заголовка, хеш-функции и (при verify) контрольной суммы
+template <typename K, typename T, typename Hash, typename Capacity>
+void MappedTable<K, T, Hash, Capacity>::Validate(bool verify) {
+	const SnapshotHeader *header = (const SnapshotHeader *) data;
+
+	if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+		throw string("File is not a table snapshot");
+
+	if (header->version != SNAPSHOT_VERSION || header->endian != SNAPSHOT_ENDIAN)
+		throw string("Unsupported snapshot version or byte order");
+
+	if (header->cellSize != sizeof(Cell) || header->keySize != sizeof(typename KeyCodec::Stored) || header->valueSize != sizeof(typename ValueCodec::Stored))
+		throw string("Snapshot key or value types do not match the table");
+
+	// отрицательный шаг вывел бы индекс пробирования за начало массива
+	if (header->capacity <= 0 || header->size < 0 || header->size > header->capacity || header->q <= 0 || header->cellsOffset % alignof(Cell) != 0)
+		throw string("Snapshot header is corrupted");
+
+	// секции должны лежать внутри файла
+	if (header->cellsOffset > length || (length - header->cellsOffset) / sizeof(Cell) < (size_t) header->capacity || header->heapOffset != header->cellsOffset + header->capacity * sizeof(Cell) || header->heapSize > length - header->heapOffset)
+		throw string("Snapshot is truncated");
+
+	if (header->indexCheck != Capacity::Index(SNAPSHOT_INDEX_PROBE, header->capacity))
+		throw string("Snapshot was saved with a different capacity policy");
+
+	capacity = header->capacity;
+	size = header->size;
+	q = header->q;
+	cells = (const Cell *) ((const char *) data + header->cellsOffset);
+	heap = (const char *) data + header->heapOffset;
+	heapSize = header->heapSize;
+
+	if (verify && header->checksum != SnapshotChecksum(*header, cells, capacity * sizeof(Cell), heap, heapSize))
+		throw string("Snapshot checksum mismatch");
+
+	// несколько первых ключей должны находиться поиском на своих местах
+	for (int i = 0, checked = 0; i < capacity && checked < HASH_CHECKS; i++) {
+		if (cells[i].state != SNAPSHOT_BUSY)
+			continue;
+
+		if (FindIndex(KeyCodec::Decode(cells[i].key, heap, heapSize)) != i)
+			throw string("Snapshot was saved with a different hash function");
+
+		checked++;
+	}
+}
+
+// поиск индекса ячейки с ключом (-1, если нет)
+template <typename K, typename T, typename Hash, typename Capacity>
+int MappedTable<K, T, Hash, Capacity>::FindIndex(const K& key) const {
+	int step = CoprimeStep(q, capacity); // шаг пробирования внутри массива, обходящий все ячейки
+	int index = Capacity::Index(hasher(key), capacity); // начальная ячейка
+
+	for (int sequenceLength = 0; sequenceLength < capacity; sequenceLength++) {
+		// если нашли свободную ячейку, то элемента нет
+		if (cells[index].state == SNAPSHOT_FREE)
+			return -1;
+
+		if (cells[index].state == SNAPSHOT_BUSY && KeyCodec::Equal(cells[index].key, heap, heapSize, key))
+			return index; // нашли элемент
+
+		index += step; // переходим к следующей ячейке без деления
+		if (index >= capacity)
+			index -= capacity;
+	}
+
+	return -1; // не нашли во всей таблице
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename Capacity>
+bool MappedTable<K, T, Hash, Capacity>::Find(const K& key) const {
+	return FindIndex(key) != -1;
+}
+
+template <typename K, typename T, typename Hash, typename Capacity>
+int MappedTable<K, T, Hash, Capacity>::GetSize() const {
+	return size; // возвращаем размер
+}
+
+template <typename K, typename T, typename Hash, typename Capacity>
+bool MappedTable<K, T, Hash, Capacity>::IsEmpty() const {
+	return size == 0; // таблица пуста, если нет элементов
+}
+
+template <typename K, typename T, typename Hash, typename Capacity>
+int MappedTable<K, T, Hash, Capacity>::GetCapacity() const {
+	return capacity; // возвращаем ёмкость
+}
+
+// получение значения по ключу
+template <typename K, typename T, typename Hash, typename Capacity>
+T MappedTable<K, T, Hash, Capacity>::Get(const K& key) const {
+	int index = FindIndex(key);
+
+	if (index == -1)
+		throw string("No value with this key"); // бросаем исключение
+
+	return ValueCodec::Decode(cells[index].value, heap, heapSize); // возвращаем значение
+}
+
+// получение значения по ключу без исключения (ложь, если нет)
+template <typename K, typename T, typename Hash, typename Capacity>
+bool MappedTable<K, T, Hash, Capacity>::TryGet(const K& key, T& value) const {
+	int index = FindIndex(key);
+
+	if (index == -1)
+		return false;
+
+	value = ValueCodec::Decode(cells[index].value, heap, heapSize);
+	return true;
+}
+
+// деструктор (закрытие отображения)
+template <typename K, typename T, typename Hash, typename Capacity>
+MappedTable<K, T, Hash, Capacity>::~MappedTable() {
+	munmap(data, length);
+}
+
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash, typename Capacity>
+TableStats MappedTable<K, T, Hash, Capacity>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.bytes = length; // отображённый файл
+
+	StepProbes probes(capacity, CoprimeStep(q, capacity), [this](int i) { return cells[i].state == SNAPSHOT_FREE; });
+
+	for (int i = 0; i < capacity; i++) {
+		if (cells[i].state == SNAPSHOT_REMOVED)
+			stats.tombstones++;
+		else if (cells[i].state == SNAPSHOT_BUSY)
+			stats.AddHit(probes.Hit(Capacity::Index(hasher(KeyCodec::Decode(cells[i].key, heap, heapSize)), capacity), i));
+
+		stats.AddMiss(probes.Miss(i)); // неуспешный поиск, начинающийся в ячейке i
+	}
+
+	stats.AddClusters(capacity, [this](int i) { return cells[i].state != SNAPSHOT_FREE; });
+	return stats;
+}
+
+// вывод таблицы
+template <typename K, typename T, typename Hash, typename Capacity>
+void MappedTable<K, T, Hash, Capacity>::Print() const {
+	for (int i = 0; i < capacity; i++) {
+		if (cells[i].state != SNAPSHOT_BUSY)
+			continue; // если ячейка не занята, то переходим к следующему элементу
+
+		cout << "[" << i << "]: "; // выводим номер ячейки
+		cout << ValueCodec::Decode(cells[i].value, heap, heapSize) << "(" << KeyCodec::Decode(cells[i].key, heap, heapSize) << ") "; // выводим содержимое ячейки
+		cout << endl; // переходим на новую строку
+	}
+}
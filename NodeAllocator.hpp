@@ -0,0 +1,127 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+/*
+	Способы выделения памяти под узлы списков таблицы с цепочками
+	Allocate возвращает память под один узел (без вызова конструктора),
+	Deallocate возвращает её обратно, Release освобождает память всех узлов
+	сразу (если CAN_RELEASE, иначе узлы нужно возвращать по одному)
+	Bytes - объём памяти, занятой пулом при заданном числе выданных узлов
+	Память берётся у стандартного аллокатора Allocator
+*/
+
+// каждый узел выделяется отдельно
+template <typename Node, typename Allocator>
+class HeapNodes {
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using Traits = std::allocator_traits<NodeAllocator>;
+
+    NodeAllocator allocator; // аллокатор узлов
+
+public:
+    static const bool CAN_RELEASE = false;
+
+    HeapNodes(const Allocator& allocator = Allocator()) : allocator(allocator) {}
+
+    Node* Allocate() { return Traits::allocate(allocator, 1); } // память под узел
+    void Deallocate(Node *node) { Traits::deallocate(allocator, node, 1); } // возврат памяти узла
+    void Release() {} // узлы освобождаются по одному
+    size_t Bytes(int count) const { return count * sizeof(Node); } // объём памяти узлов (без служебных данных аллокатора)
+    void Swap(HeapNodes& pool) noexcept { std::swap(allocator, pool.allocator); } // обмен с другим пулом
+};
+
+// узлы выделяются блоками (slab), освобождённые узлы переиспользуются через список свободных
+template <typename Node, typename Allocator>
+class PooledNodes {
+	static const int SLAB_SIZE = 256; // число узлов в блоке
+
+    // ячейка блока: память под узел или указатель на следующую свободную ячейку
+    union Cell {
+    	Cell *next;
+    	alignas(Node) unsigned char memory[sizeof(Node)];
+    };
+
+    struct Slab {
+    	Slab *next; // предыдущий выделенный блок
+    	Cell cells[SLAB_SIZE]; // ячейки блока
+    };
+
+    using SlabAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slab>;
+    using Traits = std::allocator_traits<SlabAllocator>;
+
+    SlabAllocator allocator; // аллокатор блоков
+
+    Slab *slabs; // список выделенных блоков (последний выделенный - первый)
+    Cell *freeCells; // список освобождённых ячеек
+    int used; // число выданных ячеек последнего блока
+
+public:
+    static const bool CAN_RELEASE = true;
+
+    PooledNodes(const Allocator& allocator = Allocator()) : allocator(allocator), slabs(nullptr), freeCells(nullptr), used(SLAB_SIZE) {}
+    PooledNodes(const PooledNodes& pool) : PooledNodes(pool.allocator) {} // копия - пустой пул с тем же аллокатором
+    PooledNodes& operator=(const PooledNodes&) = delete;
+
+    // память под узел
+    Node* Allocate() {
+    	// в первую очередь используем освобождённые ячейки
+    	if (freeCells != nullptr) {
+    		Cell *cell = freeCells;
+    		freeCells = cell->next;
+    		return (Node *) cell->memory;
+    	}
+
+    	// если последний блок заполнен, то выделяем новый
+    	if (used == SLAB_SIZE) {
+    		Slab *slab = Traits::allocate(allocator, 1);
+    		slab->next = slabs;
+    		slabs = slab;
+    		used = 0;
+    	}
+
+    	return (Node *) slabs->cells[used++].memory;
+    }
+
+    // возврат памяти узла в список свободных
+    void Deallocate(Node *node) {
+    	Cell *cell = (Cell *) node;
+    	cell->next = freeCells;
+    	freeCells = cell;
+    }
+
+    // обмен блоками с другим пулом (узлы остаются на месте, меняется только владелец)
+    void Swap(PooledNodes& pool) noexcept {
+    	std::swap(allocator, pool.allocator);
+    	std::swap(slabs, pool.slabs);
+    	std::swap(freeCells, pool.freeCells);
+    	std::swap(used, pool.used);
+    }
+
+    // объём памяти выделенных блоков (не зависит от числа выданных узлов)
+    size_t Bytes(int count) const {
+    	size_t bytes = 0;
+
+    	for (Slab *slab = slabs; slab != nullptr; slab = slab->next)
+    		bytes += sizeof(Slab);
+
+    	return bytes;
+    }
+
+    // освобождение всех блоков за O(число блоков)
+    void Release() {
+    	while (slabs != nullptr) {
+    		Slab *slab = slabs;
+    		slabs = slabs->next;
+    		Traits::deallocate(allocator, slab, 1);
+    	}
+
+    	freeCells = nullptr;
+    	used = SLAB_SIZE;
+    }
+
+    ~PooledNodes() {
+    	Release();
+    }
+};
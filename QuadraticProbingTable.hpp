@@ -2,37 +2,81 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <type_traits>
 #include "HashTable.h"
+#include "CellStorage.hpp"
+#include "HashFunctions.hpp"
+#include "CapacityPolicy.hpp"
 
 using namespace std;
 
 /*
 	Хеш таблица на основе квадратичного пробирования
+	Смещения от начальной ячейки - треугольные числа i(i + 1) / 2, которые
+	при ёмкости, равной степени двойки, обходят все ячейки таблицы
+	При превышении максимального коэффициента заполнения таблица расширяется,
+	причём элементы переносятся в новый массив постепенно (по несколько ячеек
+	за каждую операцию вставки и удаления)
 */
 
-template <typename K, typename T>
-class QuadraticProbingTable : public HashTable<K, T> {
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename KeyEqual = equal_to<K>, typename Storage = NodeStorage<K, T>, typename Capacity = ModuloCapacity>
+class QuadraticProbingTable final : public HashTable<K, T> {
 	const int FREE = 0; // свободная ячейка
 	const int BUSY = 1; // занятая ячейка
 	const int REMOVED = 2; // удалённая ячейка
 
-    struct HashNode {
-    	K key; // значение ключа элемента
-    	T value; // значение элемента
-    	int state; // состояние ячейки
-    };
+	const int REHASH_STEP = 8; // число ячеек старого массива, переносимых за одну операцию
 
     int capacity; // ёмкость таблицы
     int size; // число элементов в таблице
-    HashNode *cells; // массив ячеек
-
-    int (*h)(K); // указатель на хеш-функцию
+    int used; // число занятых и удалённых ячеек в текущем массиве
+    double maxLoadFactor; // максимальный коэффициент заполнения
+
+    Storage cells; // массив ячеек
+
+    Storage oldCells; // массив ячеек до расширения (не выделен, если перенос не выполняется)
+    int oldCapacity; // ёмкость старого массива
+    int oldSize; // число ещё не перенесённых элементов старого массива
+    int migrated; // индекс следующей переносимой ячейки старого массива
+
+    Hash hasher; // хеш-функция
+    KeyEqual keyEqual; // сравнение ключей
+
+    template <typename Key>
+    int FindIndex(const Storage& nodes, int length, const Key& key, uint64_t hash) const; // поиск индекса ячейки с ключом по значению хеш-функции (-1, если нет)
+    template <typename Key>
+    const T* FindValue(const Key& key) const; // поиск значения в текущем и старом массивах (nullptr, если нет)
+    template <typename Key>
+    const T* FindValue(const Key& key, uint64_t hash) const;
+
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой начальной ячейки в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+
+    int FindSlot(const K& key, bool& found) const; // поиск ячейки с ключом или первой незанятой ячейки для его вставки (-1, если нет)
+
+    template <typename KeyArg, typename ValueArg>
+    void Store(int index, KeyArg&& key, ValueArg&& value); // запись элемента в незанятую ячейку текущего массива
+    template <typename KeyArg, typename ValueArg>
+    int Place(KeyArg&& key, ValueArg&& value); // запись элемента в текущий массив (индекс ячейки или -1, если нет места)
+    template <typename KeyArg, typename ValueArg>
+    pair<T*, bool> Emplace(KeyArg&& key, ValueArg&& value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+    void Grow(); // начало расширения таблицы
+    void MigrateStep(); // перенос части ячеек из старого массива
+    void Rebuild(int newCapacity); // полное перестроение таблицы
+    int RebuildCapacity() const; // ёмкость перестроения после неудачного размещения
+    void Release(Storage& nodes, int length); // уничтожение элементов массива и освобождение его памяти
+    int ProbeLength(const Storage& nodes, int length, int index, int target) const; // число ячеек, просматриваемых поиском от начальной до целевой (или до свободной при target = -1)
 
 public:
-    QuadraticProbingTable(int tableSize, int (*h)(K)); // конструктор из размера и хеш-функции
+    QuadraticProbingTable(int tableSize, const Hash& hasher = Hash(), double maxLoadFactor = 0.5, const KeyEqual& keyEqual = KeyEqual()); // конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+    QuadraticProbingTable(int tableSize, int (*h)(K), double maxLoadFactor = 0.5); // конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
     QuadraticProbingTable(const QuadraticProbingTable& table); // конструктор копирования
+    QuadraticProbingTable(QuadraticProbingTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    QuadraticProbingTable& operator=(QuadraticProbingTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(QuadraticProbingTable& table) noexcept; // обмен содержимым таблиц за O(1)
 
-    void Insert(const K& key, const T& value); // добавление значения по ключу
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
     bool Remove(const K& key); // удаление по ключу
     bool Find(const K& key) const; // поиск по ключу
 
@@ -43,178 +87,614 @@ public:
 
     T Get(const K& key) const; // получение значения по ключу
 
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    // поиск по ключу другого типа при прозрачных хеш-функции и сравнении ключей
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    T* FindPtr(const Key& key) { return const_cast<T*>(FindValue(key)); }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    const T* FindPtr(const Key& key) const { return FindValue(key); }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    bool Find(const Key& key) const { return FindValue(key) != nullptr; }
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
     void Print() const; // вывод таблицы
 
     ~QuadraticProbingTable(); // деструктор (освобождение памяти)
 };
 
-// конструктор из размера и хеш-функции
-template <typename K, typename T>
-QuadraticProbingTable<K, T>::QuadraticProbingTable(int tableSize, int (*h)(K)) {
-	this->capacity = tableSize; // запоминаем в ёмкости переданный размер
+// конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::QuadraticProbingTable(int tableSize, const Hash& hasher, double maxLoadFactor, const KeyEqual& keyEqual) : hasher(hasher), keyEqual(keyEqual) {
+	this->capacity = Capacity::Round(tableSize); // запоминаем в ёмкости допустимый размер, не меньший переданного
 	this->size = 0; // изначально нет элементов
-	this->cells = new HashNode[tableSize]; // выделяем память под ячейки
+	this->used = 0; // и нет занятых ячеек
+	this->maxLoadFactor = maxLoadFactor;
 
-	// делаем все ячейки свободными
-	for (int i = 0; i < tableSize; i++)
-		cells[i].state = FREE;
+	this->cells.Allocate(capacity); // выделяем память под ячейки (все ячейки сразу свободны)
 
-	this->h = h; // запоминаем указатель на функцию
+	// переноса пока нет, старый массив не выделен
+	this->oldCapacity = 0;
+	this->oldSize = 0;
+	this->migrated = 0;
+}
+
+// конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::QuadraticProbingTable(int tableSize, int (*h)(K), double maxLoadFactor) : QuadraticProbingTable(tableSize, Hash(h), maxLoadFactor) {
 }
 
 // конструктор копирования
-template <typename K, typename T>
-QuadraticProbingTable<K, T>::QuadraticProbingTable(const QuadraticProbingTable& table) {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::QuadraticProbingTable(const QuadraticProbingTable& table) : hasher(table.hasher), keyEqual(table.keyEqual) {
 	capacity = table.capacity; // копируем ёмкость
 	size = table.size; // копируем количество элементов
-	cells = new HashNode[capacity]; // выделяем память под массив
+	used = table.used; // копируем количество занятых ячеек
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
 
-	h = table.h; // копируем указатель на функцию
+	if (capacity > 0)
+		cells.Allocate(capacity); // выделяем память под массив (у перемещённой таблицы его нет)
 
 	// проходимся по всем ячейкам таблицы и копируем их содержимое
 	for (int i = 0; i < capacity; i++) {
-		cells[i].value = table.cells[i].value;
-		cells[i].key = table.cells[i].key;
-		cells[i].state = table.cells[i].state;
+		cells.SetState(i, table.cells.GetState(i));
+
+		// содержимое свободных и удалённых ячеек не нужно
+		if (table.cells.GetState(i) == BUSY) {
+			cells.Construct(i, table.cells.Key(i), table.cells.Value(i));
+		}
+	}
+
+	oldCapacity = table.oldCapacity;
+	oldSize = table.oldSize;
+	migrated = table.migrated;
+
+	// если у копируемой таблицы идёт перенос, то копируем и старый массив
+	if (table.oldCells.IsAllocated()) {
+		oldCells.Allocate(oldCapacity);
+
+		for (int i = 0; i < oldCapacity; i++) {
+			oldCells.SetState(i, table.oldCells.GetState(i));
+
+			// содержимое свободных и удалённых ячеек не нужно
+			if (table.oldCells.GetState(i) == BUSY) {
+				oldCells.Construct(i, table.oldCells.Key(i), table.oldCells.Value(i));
+			}
+		}
 	}
 }
 
-// добавление значения по ключу
-template <typename K, typename T>
-void QuadraticProbingTable<K, T>::Insert(const K& key, const T& value) {
+// конструктор перемещения: таблица забирает массивы, а перемещённой остаётся нулевая ёмкость без выделенной памяти
+// (массив выделяется при следующей вставке)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::QuadraticProbingTable(QuadraticProbingTable&& table) noexcept : hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = 0;
+	size = 0;
+	used = 0;
+	maxLoadFactor = table.maxLoadFactor;
+
+	oldCapacity = 0;
+	oldSize = 0;
+	migrated = 0;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>& QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::operator=(QuadraticProbingTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Swap(QuadraticProbingTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(size, table.size);
+	swap(used, table.used);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(cells, table.cells);
+	swap(oldCells, table.oldCells);
+	swap(oldCapacity, table.oldCapacity);
+	swap(oldSize, table.oldSize);
+	swap(migrated, table.migrated);
+	swap(hasher, table.hasher);
+	swap(keyEqual, table.keyEqual);
+}
+
+// поиск индекса ячейки с ключом (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename Key>
+int QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindIndex(const Storage& nodes, int length, const Key& key, uint64_t hash) const {
+	if (length == 0)
+		return -1; // у перемещённой таблицы нет массива
+
 	int sequenceLength = 0; // начальная длина пробной последовательности равна нулю
-	int hash = h(key); // получаем хеш от ключа
+	int index = Capacity::Index(hash, length); // начальная ячейка
 
-	while (sequenceLength < capacity) {
-		int q = sequenceLength * sequenceLength;
-		int index = (hash + q) % capacity;
+	while (sequenceLength < length) {
+		// если нашли занятую клетку с нужным ключом
+		if (nodes.GetState(index) == BUSY && keyEqual(nodes.Key(index), key))
+			return index; // значит нашли
+
+		// если нашли свободную ячейку
+		if (nodes.GetState(index) == FREE)
+			return -1; // значит нет элемента
+
+		sequenceLength++; // увеличиваем длину пробной последовательности
+
+		index += sequenceLength; // смещение от начальной ячейки - треугольное число, вычисляем его без деления
+		if (index >= length)
+			index -= length;
+	}
+
+	return -1; // не нашли во всей таблице
+}
+
+// поиск значения в текущем и старом массивах (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename Key>
+const T* QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindValue(const Key& key) const {
+	return FindValue(key, hasher(key));
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename Key>
+const T* QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindValue(const Key& key, uint64_t hash) const {
+	int index = FindIndex(cells, capacity, key, hash); // ищем элемент в текущем массиве
+
+	if (index != -1)
+		return &cells.Value(index); // значит нашли
 
-		if (cells[index].state != BUSY) { // если нашли незанятую ячейку
-			cells[index].key = key; // сохраняем ключ
-			cells[index].value = value; // сохраняем значение
-			cells[index].state = BUSY; // ячейка становится занятой
+	// если идёт перенос, то ищем элемент в старом массиве
+	if (oldCells.IsAllocated() && (index = FindIndex(oldCells, oldCapacity, key, hash)) != -1)
+		return &oldCells.Value(index);
 
-			size++; // увеличиваем счётчик числа элементов
-			return; // выходим
+	return nullptr; // не нашли
+}
+
+// хеш ключа с предварительной загрузкой начальной ячейки в кеш
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+uint64_t QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::PrefetchKey(const K& key) const {
+	uint64_t hash = hasher(key);
+
+	if (capacity > 0) // у перемещённой таблицы нет массива
+		cells.Prefetch(Capacity::Index(hash, capacity));
+
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+const T* QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindHashed(const K& key, uint64_t hash) const {
+	return FindValue(key, hash);
+}
+
+// поиск ячейки с ключом или первой незанятой ячейки для его вставки (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+int QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindSlot(const K& key, bool& found) const {
+	int sequenceLength = 0; // начальная длина пробной последовательности равна нулю
+	int index = Capacity::Index(hasher(key), capacity); // начальная ячейка
+	int slot = -1; // первая удалённая ячейка пробной последовательности
+
+	found = false;
+
+	while (sequenceLength < capacity) {
+		if (cells.GetState(index) == BUSY) {
+			// если нашли занятую клетку с нужным ключом
+			if (keyEqual(cells.Key(index), key)) {
+				found = true;
+				return index; // значит нашли
+			}
+		}
+		else if (cells.GetState(index) == FREE) {
+			return slot == -1 ? index : slot; // ключа нет: вставляем в первую удалённую ячейку или в эту свободную
+		}
+		else if (slot == -1) {
+			slot = index; // запоминаем первую удалённую ячейку
 		}
 
 		sequenceLength++; // увеличиваем длину пробной последовательности
+
+		index += sequenceLength; // смещение от начальной ячейки - треугольное число, вычисляем его без деления
+		if (index >= capacity)
+			index -= capacity;
 	}
 
-	// прошли всю таблицу
-	throw string("Unable to insert value with this key"); // бросаем исключение
+	return slot; // прошли всю пробную последовательность
 }
 
-// удаление по ключу
-template <typename K, typename T>
-bool QuadraticProbingTable<K, T>::Remove(const K& key) {
+// запись элемента в незанятую ячейку текущего массива
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename KeyArg, typename ValueArg>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Store(int index, KeyArg&& key, ValueArg&& value) {
+	if (cells.GetState(index) == FREE)
+		used++; // свободная ячейка становится использованной
+
+	cells.Construct(index, forward<KeyArg>(key), forward<ValueArg>(value)); // создаём ключ и значение в ячейке
+	cells.SetState(index, BUSY); // ячейка становится занятой
+}
+
+// запись элемента в текущий массив (индекс ячейки или -1, если нет места)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename KeyArg, typename ValueArg>
+int QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Place(KeyArg&& key, ValueArg&& value) {
 	int sequenceLength = 0; // начальная длина пробной последовательности равна нулю
-	int hash = h(key); // получаем хеш от ключа
+	int index = Capacity::Index(hasher(key), capacity); // начальная ячейка
 
 	while (sequenceLength < capacity) {
-		int q = sequenceLength * sequenceLength;
-		int index = (hash + q) % capacity;
+		if (cells.GetState(index) != BUSY) { // если нашли незанятую ячейку
+			Store(index, forward<KeyArg>(key), forward<ValueArg>(value));
+			return index; // выходим
+		}
 
-		// если нашли занятую нужным ключом ячейку
-		if (cells[index].state == BUSY && cells[index].key == key) {
-			cells[index].state = REMOVED; // помечаем её как удалённую
-			size--; // уменьшаем счётчик числа элементов
+		sequenceLength++; // увеличиваем длину пробной последовательности
+
+		index += sequenceLength; // смещение от начальной ячейки - треугольное число, вычисляем его без деления
+		if (index >= capacity)
+			index -= capacity;
+	}
+
+	return -1; // прошли всю пробную последовательность
+}
+
+// начало расширения таблицы
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Grow() {
+	// если предыдущий перенос не завершён, то перестраиваем таблицу целиком
+	if (oldCells.IsAllocated()) {
+		Rebuild(RebuildCapacity());
+		return;
+	}
+
+	// если ячейки заняты в основном удалёнными элементами, то достаточно избавиться от них
+	int newCapacity = size * 2 > maxLoadFactor * capacity ? Capacity::Round(capacity * 2ll) : capacity;
+
+	oldCells = cells; // текущий массив становится старым
+	oldCapacity = capacity;
+	oldSize = size;
+	migrated = 0;
+
+	capacity = newCapacity;
+	used = 0;
+	cells.Allocate(capacity); // выделяем память под новый массив
+}
+
+// перенос части ячеек из старого массива
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::MigrateStep() {
+	if (!oldCells.IsAllocated())
+		return; // переноса нет
+
+	for (int i = 0; i < REHASH_STEP && migrated < oldCapacity && oldSize > 0; i++, migrated++) {
+		if (oldCells.GetState(migrated) != BUSY)
+			continue; // свободные и удалённые ячейки не переносим
 
-			return true; // возвращаем истину
+		if (Place(move(oldCells.Key(migrated)), move(oldCells.Value(migrated))) == -1) {
+			Rebuild(RebuildCapacity()); // не удалось разместить элемент, перестраиваем таблицу целиком
+			return;
 		}
 
-		// если нашли свободную ячейку
-		if (cells[index].state == FREE)
-			return false; // возвращаем ложь
+		oldCells.Destroy(migrated); // перемещённый элемент больше не нужен
+		oldCells.SetState(migrated, REMOVED); // не разрываем пробные последовательности старого массива
+		oldSize--;
+	}
 
-		sequenceLength++; // увеличиваем длину пробной последовательности
+	// если все элементы перенесены, то освобождаем старый массив
+	if (migrated == oldCapacity || oldSize == 0) {
+		oldCells.Free();
 	}
+}
 
-	return false; // не нашли во всей таблице, возвращаем ложь
+// ёмкость перестроения после неудачного размещения: степень двойки, при которой
+// треугольные смещения обходят все ячейки (если её допускает способ выбора ёмкости)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+int QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::RebuildCapacity() const {
+	return Capacity::Round(PowerOfTwoCapacity::Round(capacity * 2ll));
 }
 
-// поиск по ключу
-template <typename K, typename T>
-bool QuadraticProbingTable<K, T>::Find(const K& key) const {
-	int sequenceLength = 0; // начальная длина пробной последовательности равна нулю
-	int hash = h(key); // получаем хеш от ключа
+// полное перестроение таблицы (элементы перемещаются, а не копируются)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Rebuild(int newCapacity) {
+	vector<pair<Storage, int>> sources = { make_pair(cells, capacity) }; // массивы с ещё не перенесёнными элементами
 
-	while (sequenceLength < capacity) {
-		int q = sequenceLength * sequenceLength;
-		int index = (hash + q) % capacity; // ищем индекс элемента
+	if (oldCells.IsAllocated())
+		sources.push_back(make_pair(oldCells, oldCapacity));
 
-		// если нашли занятую клетку с нужным ключом
-		if (cells[index].state == BUSY && cells[index].key == key)
-			return true; // значит нашли
+	oldCells = Storage(); // старый массив освобождается вместе с остальными исходными
+	oldSize = 0;
+	capacity = Capacity::Round(newCapacity);
 
-		// если нашли свободную ячейку
-		if (cells[index].state == FREE)
-			return false; // значит нет элемента
+	while (true) {
+		used = 0;
+		cells.Allocate(capacity); // выделяем память под новый массив
 
-		sequenceLength++; // увеличиваем длину пробной последовательности
+		bool placed = true;
+
+		for (size_t s = 0; s < sources.size() && placed; s++) {
+			Storage& source = sources[s].first;
+
+			for (int i = 0; i < sources[s].second && placed; i++) {
+				if (source.GetState(i) != BUSY)
+					continue;
+
+				placed = Place(move(source.Key(i)), move(source.Value(i))) != -1; // при неудаче элемент не изменяется
+
+				if (placed) {
+					source.Destroy(i);
+					source.SetState(i, FREE); // перемещённый элемент больше не принадлежит исходному массиву
+				}
+			}
+		}
+
+		if (placed)
+			break;
+
+		// уже перемещённые элементы остались в новом массиве, поэтому он тоже становится исходным для массива большей ёмкости
+		sources.push_back(make_pair(cells, capacity));
+		capacity = Capacity::Round(capacity * 2ll);
+	}
+
+	for (size_t s = 0; s < sources.size(); s++)
+		sources[s].first.Free();
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+template <typename KeyArg, typename ValueArg>
+pair<T*, bool> QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Emplace(KeyArg&& key, ValueArg&& value, bool assign) {
+	// у перемещённой таблицы массив выделяется только при первой вставке
+	if (capacity == 0) {
+		cells.Allocate(Capacity::Round(1));
+		capacity = Capacity::Round(1);
+	}
+
+	MigrateStep(); // переносим очередную часть старого массива
+
+	int index;
+
+	// если идёт перенос, то ключ может находиться в старом массиве
+	if (oldCells.IsAllocated() && (index = FindIndex(oldCells, oldCapacity, key, hasher(key))) != -1) {
+		if (assign)
+			oldCells.Value(index) = forward<ValueArg>(value); // обновляем значение на месте
+
+		return make_pair(&oldCells.Value(index), false);
+	}
+
+	bool found;
+	index = FindSlot(key, found); // за один проход ищем ключ и запоминаем место для вставки
+
+	if (found) {
+		if (assign)
+			cells.Value(index) = forward<ValueArg>(value); // обновляем значение на месте
+
+		return make_pair(&cells.Value(index), false);
+	}
+
+	// удалённая ячейка используется повторно без расширения, свободная - если не будет превышен коэффициент заполнения
+	if (index != -1 && (cells.GetState(index) == REMOVED || used + 1 <= maxLoadFactor * capacity)) {
+		Store(index, forward<KeyArg>(key), forward<ValueArg>(value));
 	}
+	else {
+		// если после вставки будет превышен коэффициент заполнения, то расширяем таблицу
+		if (used + 1 > maxLoadFactor * capacity)
+			Grow();
+
+		// если пробная последовательность не содержит незанятых ячеек, то перестраиваем таблицу
+		// (при неудаче Place не забирает ключ и значение, поэтому повторная попытка безопасна)
+		while ((index = Place(forward<KeyArg>(key), forward<ValueArg>(value))) == -1)
+			Rebuild(RebuildCapacity());
+	}
+
+	size++; // увеличиваем счётчик числа элементов
 
-	return false; // не нашли во всей таблице
+	return make_pair(&cells.Value(index), true);
 }
 
-template <typename K, typename T>
-void QuadraticProbingTable<K, T>::Clear() {
-	for (int i = 0; i < capacity; i++)
-		cells[i].state = FREE;
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+bool QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Remove(const K& key) {
+	MigrateStep(); // переносим очередную часть старого массива
+
+	int index = FindIndex(cells, capacity, key, hasher(key)); // ищем элемент в текущем массиве
+
+	// если нашли занятую нужным ключом ячейку
+	if (index != -1) {
+		cells.Destroy(index); // уничтожаем элемент
+		cells.SetState(index, REMOVED); // и помечаем ячейку как удалённую
+		size--; // уменьшаем счётчик числа элементов
+
+		return true; // возвращаем истину
+	}
+
+	// если идёт перенос, то ищем элемент в старом массиве
+	if (oldCells.IsAllocated() && (index = FindIndex(oldCells, oldCapacity, key, hasher(key))) != -1) {
+		oldCells.Destroy(index); // уничтожаем элемент
+		oldCells.SetState(index, REMOVED); // и помечаем ячейку как удалённую
+		oldSize--; // уменьшаем счётчик не перенесённых элементов
+		size--; // уменьшаем счётчик числа элементов
+
+		return true; // возвращаем истину
+	}
+
+	return false; // не нашли, возвращаем ложь
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+bool QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Find(const K& key) const {
+	return FindValue(key) != nullptr;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Clear() {
+	Release(cells, capacity); // вместо обхода ячеек массив заменяется новым обнулённым
+	Release(oldCells, oldCapacity); // старый массив больше не нужен
+
+	if (capacity > 0)
+		cells.Allocate(capacity);
+	oldSize = 0;
 
 	size = 0; // обнуляем счётчик числа элементов
+	used = 0; // и счётчик занятых ячеек
 }
 
-template <typename K, typename T>
-int QuadraticProbingTable<K, T>::GetSize() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+int QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::GetSize() const {
 	return size; // возвращаем размер
 }
 
-template <typename K, typename T>
-bool QuadraticProbingTable<K, T>::IsEmpty() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+bool QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::IsEmpty() const {
 	return size == 0; // таблица пуста, если нет элементов
 }
 
 // получение значения по ключу
-template <typename K, typename T>
-T QuadraticProbingTable<K, T>::Get(const K& key) const {
-	int sequenceLength = 0;
-	int hash = h(key); // получаем хеш от ключа
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+T QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Get(const K& key) const {
+	const T *value = FindValue(key);
 
-	while (sequenceLength < capacity) {
-		int q = sequenceLength * sequenceLength;
-		int index = (hash + q) % capacity;
+	if (value == nullptr)
+		throw string("No value with this key"); // бросаем исключение
 
-		// если нашли занятую клетку с нужным ключом
-		if (cells[index].state == BUSY && cells[index].key == key)
-			return cells[index].value; // значит нашли
+	return *value; // возвращаем значение
+}
 
-		// если нашли свободную ячейку, значит нет такого элемента
-		if (cells[index].state == FREE)
-			throw string("No value with this key"); // бросаем исключение
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+T* QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindPtr(const K& key) {
+	return const_cast<T*>(FindValue(key));
+}
 
-		sequenceLength++; // увеличиваем длину пробной последовательности
-	}
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+const T* QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::FindPtr(const K& key) const {
+	return FindValue(key);
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+pair<T*, bool> QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::TryEmplace(K key, T value) {
+	return Emplace(move(key), move(value), false);
+}
 
-	// обошли всю таблицу
-	throw string("No value with this key"); // бросаем исключение
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+pair<T*, bool> QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::InsertOrAssign(K key, T value) {
+	return Emplace(move(key), move(value), true);
 }
 
 // деструктор (освобождения памяти)
-template <typename K, typename T>
-QuadraticProbingTable<K, T>::~QuadraticProbingTable() {
-	delete[] cells; // удаляем массив ячеек
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::~QuadraticProbingTable() {
+	Release(cells, capacity); // удаляем массив ячеек
+	Release(oldCells, oldCapacity); // и старый массив, если он есть
+}
+
+// уничтожение элементов массива и освобождение его памяти
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Release(Storage& nodes, int length) {
+	if (!nodes.IsAllocated())
+		return;
+
+	// тривиально уничтожаемые элементы не требуют обхода массива
+	if (!is_trivially_destructible<K>::value || !is_trivially_destructible<T>::value)
+		for (int i = 0; i < length; i++)
+			if (nodes.GetState(i) == BUSY)
+				nodes.Destroy(i);
+
+	nodes.Free();
+}
+
+// число ячеек, просматриваемых поиском от начальной до целевой (или до свободной при target = -1)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+int QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::ProbeLength(const Storage& nodes, int length, int index, int target) const {
+	int probes = 1;
+
+	while (probes < length && index != target && nodes.GetState(index) != FREE) {
+		index += probes; // смещение от начальной ячейки - треугольное число
+		if (index >= length)
+			index -= length;
+
+		probes++;
+	}
+
+	return probes;
+}
+
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+TableStats QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.migrating = oldCells.IsAllocated();
+	stats.bytes = sizeof(*this) + Storage::Bytes(capacity) + (oldCells.IsAllocated() ? Storage::Bytes(oldCapacity) : 0);
+
+	for (int i = 0; i < capacity; i++) {
+		if (cells.GetState(i) == REMOVED)
+			stats.tombstones++;
+		else if (cells.GetState(i) == BUSY)
+			stats.AddHit(ProbeLength(cells, capacity, Capacity::Index(hasher(cells.Key(i)), capacity), i));
+	}
+
+	// неуспешный поиск запускается из выборки начальных ячеек, чтобы длинные кластеры не делали обход квадратичным
+	stats.AddSampledMisses(capacity, [this](int i) { return ProbeLength(cells, capacity, i, -1); });
+
+	// ещё не перенесённые элементы ищутся сначала в текущем массиве, а затем в старом
+	for (int i = 0; oldCells.IsAllocated() && i < oldCapacity; i++) {
+		if (oldCells.GetState(i) == REMOVED) {
+			stats.tombstones++;
+		}
+		else if (oldCells.GetState(i) == BUSY) {
+			uint64_t hash = hasher(oldCells.Key(i));
+			stats.AddHit(ProbeLength(cells, capacity, Capacity::Index(hash, capacity), -1) + ProbeLength(oldCells, oldCapacity, Capacity::Index(hash, oldCapacity), i));
+		}
+	}
+
+	stats.AddClusters(capacity, [this](int i) { return cells.GetState(i) != FREE; });
+	return stats;
 }
 
 // оператор вывода в поток
-template <typename K, typename T>
-void QuadraticProbingTable<K, T>::Print() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>::Print() const {
     for (int i = 0; i < capacity; i++) {
-		if (cells[i].state != BUSY)
+		if (cells.GetState(i) != BUSY)
 			continue; // если ячейка не занята, то переходим к следующему элементу
 
 		cout << "[" << i << "]: "; // выводим номер ячейки
-		cout << cells[i].value << "(" << cells[i].key << ") "; // выводим содержимое ячейки
+		cout << cells.Value(i) << "(" << cells.Key(i) << ") "; // выводим содержимое ячейки
 		cout << endl; // переходим на новую строку
 	}
+
+	// выводим ещё не перенесённые элементы старого массива
+	for (int i = 0; oldCells.IsAllocated() && i < oldCapacity; i++) {
+		if (oldCells.GetState(i) != BUSY)
+			continue;
+
+		cout << "[old " << i << "]: "; // выводим номер ячейки старого массива
+		cout << oldCells.Value(i) << "(" << oldCells.Key(i) << ") ";
+		cout << endl;
+	}
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Storage, typename Capacity>
+void swap(QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>& table1, QuadraticProbingTable<K, T, Hash, KeyEqual, Storage, Capacity>& table2) {
+	table1.Swap(table2);
 }
@@ -0,0 +1,486 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include "CellStorage.hpp"
+#include "HashTable.h"
+#include "HashFunctions.hpp"
+#include "CapacityPolicy.hpp"
+
+using namespace std;
+
+/*
+	Хеш таблица на основе линейного пробирования с вытеснением (Robin Hood hashing)
+	При вставке элемент, ушедший от своей начальной ячейки дальше, чем элемент
+	в текущей ячейке, занимает его место, а вытесненный элемент вставляется дальше.
+	Поиск прекращается, как только встречен элемент, расположенный ближе к своей
+	начальной ячейке, чем искомый, а удаление выполняется сдвигом назад, поэтому
+	удалённых ячеек в таблице не бывает. При превышении максимального коэффициента
+	заполнения таблица перестраивается с удвоенной ёмкостью. Способ выбора ёмкости
+	и начальной ячейки задаётся параметром Capacity (см. CapacityPolicy.hpp)
+	Расстояние в ячейке хранится увеличенным на единицу, чтобы нулевое значение
+	означало свободную ячейку: массив выделяется обнулённым и не обходится при
+	создании, а ключи и значения создаются только в занятых ячейках
+*/
+
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename KeyEqual = equal_to<K>, typename Capacity = ModuloCapacity>
+class RobinHoodTable final : public HashTable<K, T> {
+	const int FREE = 0; // расстояние свободной ячейки
+
+    // ключ и значение в объединениях создаются и уничтожаются явно, только пока ячейка занята
+    struct HashNode {
+    	union { K key; }; // значение ключа элемента
+    	union { T value; }; // значение элемента
+    	int distance; // расстояние от начальной ячейки плюс один (FREE для свободной ячейки)
+    };
+
+    int capacity; // ёмкость таблицы
+    int size; // число элементов в таблице
+    double maxLoadFactor; // максимальный коэффициент заполнения
+
+    HashNode *cells; // массив ячеек
+
+    Hash hasher; // хеш-функция
+    KeyEqual keyEqual; // сравнение ключей
+
+    template <typename Key>
+    int FindIndex(const Key& key) const; // поиск индекса ячейки с ключом (-1, если нет)
+    template <typename Key>
+    int FindIndex(const Key& key, uint64_t hash) const; // поиск индекса ячейки с ключом по значению хеш-функции (-1, если нет)
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой начальной ячейки в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+    int Displace(int index, int distance, K key, T value); // запись элемента с вытеснением, начиная с заданной ячейки (индекс ячейки элемента)
+    int Place(K key, T value); // запись элемента с вытеснением (индекс ячейки элемента)
+    pair<T*, bool> Emplace(K key, T value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+    void Rebuild(int newCapacity); // перестроение таблицы
+    void Destroy(int index); // уничтожение элемента ячейки
+    void Release(); // уничтожение элементов и освобождение памяти
+
+public:
+    RobinHoodTable(int tableSize, const Hash& hasher = Hash(), double maxLoadFactor = 0.9, const KeyEqual& keyEqual = KeyEqual()); // конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+    RobinHoodTable(int tableSize, int (*h)(K), double maxLoadFactor = 0.9); // конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+    RobinHoodTable(const RobinHoodTable& table); // конструктор копирования
+    RobinHoodTable(RobinHoodTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    RobinHoodTable& operator=(RobinHoodTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(RobinHoodTable& table) noexcept; // обмен содержимым таблиц за O(1)
+
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
+    bool Remove(const K& key); // удаление по ключу
+    bool Find(const K& key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+
+    T Get(const K& key) const; // получение значения по ключу
+
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    // поиск по ключу другого типа при прозрачных хеш-функции и сравнении ключей
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    T* FindPtr(const Key& key) { int index = FindIndex(key); return index == -1 ? nullptr : &cells[index].value; }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    const T* FindPtr(const Key& key) const { int index = FindIndex(key); return index == -1 ? nullptr : &cells[index].value; }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    bool Find(const Key& key) const { return FindIndex(key) != -1; }
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Print() const; // вывод таблицы
+
+    ~RobinHoodTable(); // деструктор (освобождение памяти)
+};
+
+// конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::RobinHoodTable(int tableSize, const Hash& hasher, double maxLoadFactor, const KeyEqual& keyEqual) : hasher(hasher), keyEqual(keyEqual) {
+	this->capacity = Capacity::Round(tableSize); // запоминаем в ёмкости допустимый размер, не меньший переданного
+	this->size = 0; // изначально нет элементов
+	this->maxLoadFactor = maxLoadFactor;
+
+	this->cells = static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))); // выделяем память под ячейки (все ячейки сразу свободны)
+}
+
+// конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::RobinHoodTable(int tableSize, int (*h)(K), double maxLoadFactor) : RobinHoodTable(tableSize, Hash(h), maxLoadFactor) {
+}
+
+// конструктор копирования
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::RobinHoodTable(const RobinHoodTable& table) : hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = table.capacity; // копируем ёмкость
+	size = table.size; // копируем количество элементов
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
+
+	cells = capacity > 0 ? static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))) : nullptr; // выделяем память под массив (у перемещённой таблицы его нет)
+
+	// проходимся по всем ячейкам таблицы и копируем их содержимое
+	for (int i = 0; i < capacity; i++) {
+		cells[i].distance = table.cells[i].distance;
+
+		// содержимое свободных ячеек не нужно
+		if (cells[i].distance != FREE) {
+			new (&cells[i].key) K(table.cells[i].key);
+			new (&cells[i].value) T(table.cells[i].value);
+		}
+	}
+}
+
+// конструктор перемещения: таблица забирает массив, а перемещённой остаётся нулевая ёмкость без выделенной памяти
+// (массив выделяется при следующей вставке)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::RobinHoodTable(RobinHoodTable&& table) noexcept : hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = 0;
+	size = 0;
+	maxLoadFactor = table.maxLoadFactor;
+	cells = nullptr;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+RobinHoodTable<K, T, Hash, KeyEqual, Capacity>& RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::operator=(RobinHoodTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+void RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Swap(RobinHoodTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(size, table.size);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(cells, table.cells);
+	swap(hasher, table.hasher);
+	swap(keyEqual, table.keyEqual);
+}
+
+// поиск индекса ячейки с ключом (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+template <typename Key>
+int RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::FindIndex(const Key& key) const {
+	return FindIndex(key, hasher(key));
+}
+
+// поиск индекса ячейки с ключом по значению хеш-функции (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+template <typename Key>
+int RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::FindIndex(const Key& key, uint64_t hash) const {
+	if (capacity == 0)
+		return -1; // у перемещённой таблицы нет массива
+
+	int index = Capacity::Index(hash, capacity); // начальная ячейка
+
+	for (int distance = 1; distance <= capacity; distance++) {
+		// если ячейка свободна или её элемент ближе к своей начальной ячейке, то ключа нет
+		if (cells[index].distance < distance)
+			return -1;
+
+		if (cells[index].distance == distance && keyEqual(cells[index].key, key))
+			return index; // нашли элемент
+
+		index++; // переходим к следующей ячейке без деления
+		if (index >= capacity)
+			index -= capacity;
+	}
+
+	return -1; // не нашли во всей таблице
+}
+
+// хеш ключа с предварительной загрузкой начальной ячейки в кеш
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+uint64_t RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::PrefetchKey(const K& key) const {
+	uint64_t hash = hasher(key);
+
+	if (capacity > 0) // у перемещённой таблицы нет массива
+		__builtin_prefetch(cells + Capacity::Index(hash, capacity));
+
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+const T* RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::FindHashed(const K& key, uint64_t hash) const {
+	int index = FindIndex(key, hash);
+
+	return index == -1 ? nullptr : &cells[index].value;
+}
+
+// запись элемента с вытеснением, начиная с заданной ячейки (индекс ячейки элемента)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+int RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Displace(int index, int distance, K key, T value) {
+	int placed = -1; // ячейка, в которую попал записываемый элемент
+
+	while (cells[index].distance != FREE) {
+		// если элемент в ячейке ближе к своей начальной ячейке, то вытесняем его
+		if (cells[index].distance < distance) {
+			if (placed == -1)
+				placed = index; // дальше перемещаются только вытесненные элементы
+
+			swap(key, cells[index].key);
+			swap(value, cells[index].value);
+			swap(distance, cells[index].distance);
+		}
+
+		index++; // переходим к следующей ячейке без деления
+		if (index >= capacity)
+			index -= capacity;
+		distance++;
+	}
+
+	new (&cells[index].key) K(move(key)); // создаём ключ в свободной ячейке
+	new (&cells[index].value) T(move(value)); // и значение
+	cells[index].distance = distance; // запоминаем расстояние
+
+	return placed == -1 ? index : placed;
+}
+
+// запись элемента с вытеснением (индекс ячейки элемента)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+int RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Place(K key, T value) {
+	return Displace(Capacity::Index(hasher(key), capacity), 1, move(key), move(value)); // начинаем с начальной ячейки
+}
+
+// перестроение таблицы
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+void RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Rebuild(int newCapacity) {
+	HashNode *prevCells = cells; // запоминаем текущий массив
+	int prevCapacity = capacity;
+
+	capacity = newCapacity;
+	cells = static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))); // выделяем память под новый массив
+
+	// перемещаем все элементы в новый массив
+	for (int i = 0; i < prevCapacity; i++) {
+		if (prevCells[i].distance != FREE) {
+			Place(move(prevCells[i].key), move(prevCells[i].value));
+			prevCells[i].key.~K();
+			prevCells[i].value.~T();
+		}
+	}
+
+	free(prevCells);
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+pair<T*, bool> RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Emplace(K key, T value, bool assign) {
+	// у перемещённой таблицы массив выделяется только при первой вставке
+	if (capacity == 0) {
+		cells = static_cast<HashNode*>(AllocateZeroed(Capacity::Round(1), sizeof(HashNode)));
+		capacity = Capacity::Round(1);
+	}
+
+	int index = Capacity::Index(hasher(key), capacity); // начальная ячейка
+	int distance = 1; // расстояние от начальной ячейки плюс один
+
+	// за один проход ищем ключ вплоть до ячейки, с которой элемент будет вставлен
+	while (cells[index].distance >= distance) {
+		if (cells[index].distance == distance && keyEqual(cells[index].key, key)) {
+			if (assign)
+				cells[index].value = move(value); // обновляем значение на месте
+
+			return make_pair(&cells[index].value, false);
+		}
+
+		index++; // переходим к следующей ячейке без деления
+		if (index >= capacity)
+			index -= capacity;
+		distance++;
+	}
+
+	// если после вставки будет превышен коэффициент заполнения или не останется свободных ячеек, то расширяем таблицу
+	if (size + 1 > maxLoadFactor * capacity || size + 1 >= capacity) {
+		Rebuild(Capacity::Round(capacity * 2ll));
+		index = Place(move(key), move(value));
+	}
+	else {
+		index = Displace(index, distance, move(key), move(value)); // вставляем с найденной ячейки
+	}
+
+	size++; // увеличиваем счётчик числа элементов
+
+	return make_pair(&cells[index].value, true);
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+void RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+bool RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Remove(const K& key) {
+	int index = FindIndex(key);
+
+	if (index == -1)
+		return false; // не нашли, возвращаем ложь
+
+	int next = index + 1 == capacity ? 0 : index + 1;
+
+	// сдвигаем назад элементы, стоящие не в своей начальной ячейке
+	while (cells[next].distance > 1) {
+		cells[index].key = move(cells[next].key);
+		cells[index].value = move(cells[next].value);
+		cells[index].distance = cells[next].distance - 1;
+
+		index = next;
+		next++; // переходим к следующей ячейке без деления
+		if (next >= capacity)
+			next -= capacity;
+	}
+
+	Destroy(index); // последняя ячейка становится свободной
+	size--; // уменьшаем счётчик числа элементов
+
+	return true; // возвращаем истину
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+bool RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Find(const K& key) const {
+	return FindIndex(key) != -1;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+void RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Clear() {
+	Release(); // вместо обхода ячеек массив заменяется новым обнулённым
+	cells = capacity > 0 ? static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))) : nullptr;
+
+	size = 0; // обнуляем счётчик числа элементов
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+int RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::GetSize() const {
+	return size; // возвращаем размер
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+bool RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::IsEmpty() const {
+	return size == 0; // таблица пуста, если нет элементов
+}
+
+// получение значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+T RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Get(const K& key) const {
+	int index = FindIndex(key);
+
+	if (index == -1)
+		throw string("No value with this key"); // бросаем исключение
+
+	return cells[index].value; // возвращаем значение
+}
+
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+T* RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::FindPtr(const K& key) {
+	int index = FindIndex(key);
+
+	return index == -1 ? nullptr : &cells[index].value;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+const T* RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::FindPtr(const K& key) const {
+	int index = FindIndex(key);
+
+	return index == -1 ? nullptr : &cells[index].value;
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+pair<T*, bool> RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::TryEmplace(K key, T value) {
+	return Emplace(move(key), move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+pair<T*, bool> RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::InsertOrAssign(K key, T value) {
+	return Emplace(move(key), move(value), true);
+}
+
+// деструктор (освобождения памяти)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::~RobinHoodTable() {
+	Release(); // удаляем массив ячеек
+}
+
+// уничтожение элемента ячейки
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+void RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Destroy(int index) {
+	cells[index].key.~K();
+	cells[index].value.~T();
+	cells[index].distance = FREE;
+}
+
+// уничтожение элементов и освобождение памяти
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+void RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Release() {
+	// тривиально уничтожаемые элементы не требуют обхода массива
+	if (!is_trivially_destructible<K>::value || !is_trivially_destructible<T>::value)
+		for (int i = 0; i < capacity; i++)
+			if (cells[i].distance != FREE)
+				Destroy(i);
+
+	free(cells);
+}
+
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+TableStats RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.bytes = sizeof(*this) + capacity * sizeof(HashNode);
+
+	for (int i = 0; i < capacity; i++) {
+		if (cells[i].distance != FREE)
+			stats.AddHit(cells[i].distance);
+
+		// неуспешный поиск из ячейки i останавливается на ячейке, элемент которой ближе к своей начальной ячейке
+		int index = i;
+		int distance = 1;
+
+		while (distance < capacity && cells[index].distance >= distance) {
+			index++;
+			if (index >= capacity)
+				index -= capacity;
+
+			distance++;
+		}
+
+		stats.AddMiss(distance);
+	}
+
+	stats.AddClusters(capacity, [this](int i) { return cells[i].distance != FREE; });
+	return stats;
+}
+
+// оператор вывода в поток
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+void RobinHoodTable<K, T, Hash, KeyEqual, Capacity>::Print() const {
+    for (int i = 0; i < capacity; i++) {
+		if (cells[i].distance == FREE)
+			continue; // если ячейка не занята, то переходим к следующему элементу
+
+		cout << "[" << i << "]: "; // выводим номер ячейки
+		cout << cells[i].value << "(" << cells[i].key << ") "; // выводим содержимое ячейки
+		cout << endl; // переходим на новую строку
+	}
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Capacity>
+void swap(RobinHoodTable<K, T, Hash, KeyEqual, Capacity>& table1, RobinHoodTable<K, T, Hash, KeyEqual, Capacity>& table2) {
+	table1.Swap(table2);
+}
@@ -3,15 +3,21 @@
 #include <iostream>
 #include <string>
 #include "HashTable.h"
+#include "HashFunctions.hpp"
+#include "NodeAllocator.hpp"
 
 using namespace std;
 
 /*
 	Хеш таблица на основе метода цепочек
+	Память под узлы списков выделяется политикой Nodes поверх стандартного
+	аллокатора Allocator: по умолчанию узлы берутся из пула блоков, поэтому
+	очистка таблицы с тривиально разрушаемыми ключами и значениями
+	освобождает память целыми блоками, не обходя списки
 */
 
-template <typename K, typename T>
-class SeparateChainingTable : public HashTable<K, T> {
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename KeyEqual = equal_to<K>, typename Allocator = allocator<char>, template <typename, typename> class Nodes = PooledNodes>
+class SeparateChainingTable final : public HashTable<K, T> {
     struct Node {
     	K key; // значение ключа элемента
     	T value; // значение элемента
@@ -22,14 +28,33 @@ class SeparateChainingTable : public HashTable<K, T> {
     int size; // число элементов в таблице
 
     Node **cells; // массив ячеек (списков)
+    Nodes<Node, Allocator> nodes; // память под узлы
 
-    int (*h)(K); // указатель на хеш-функцию
+    Hash hasher; // хеш-функция
+    KeyEqual keyEqual; // сравнение ключей
+
+    template <typename KeyArg, typename ValueArg>
+    Node* CreateNode(KeyArg&& key, ValueArg&& value, Node *next); // создание узла
+    void DestroyNode(Node *node); // удаление узла
+
+    template <typename Key>
+    Node* FindNode(const Key& key) const; // поиск элемента с ключом (nullptr, если нет)
+    template <typename Key>
+    Node* FindNode(const Key& key, uint64_t hash) const; // поиск элемента с ключом по значению хеш-функции (nullptr, если нет)
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой ячейки списка в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+    template <typename KeyArg, typename ValueArg>
+    pair<T*, bool> Emplace(KeyArg&& key, ValueArg&& value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
 
 public:
-    SeparateChainingTable(int tableSize, int (*h)(K)); // конструктор из размера и хеш-функции
+    SeparateChainingTable(int tableSize, const Hash& hasher = Hash(), const KeyEqual& keyEqual = KeyEqual(), const Allocator& allocator = Allocator()); // конструктор из размера, хеш-функции, сравнения ключей и аллокатора
+    SeparateChainingTable(int tableSize, int (*h)(K)); // конструктор из размера и указателя на хеш-функцию
     SeparateChainingTable(const SeparateChainingTable& table); // конструктор копирования
+    SeparateChainingTable(SeparateChainingTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    SeparateChainingTable& operator=(SeparateChainingTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(SeparateChainingTable& table) noexcept; // обмен содержимым таблиц за O(1)
 
-    void Insert(const K& key, const T& value); // добавление значения по ключу
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
     bool Remove(const K& key); // удаление по ключу
     bool Find(const K& key) const; // поиск по ключу
 
@@ -40,14 +65,32 @@ public:
 
     T Get(const K& key) const; // получение значения по ключу
 
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    // поиск по ключу другого типа при прозрачных хеш-функции и сравнении ключей
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    T* FindPtr(const Key& key) { Node *node = FindNode(key); return node ? &node->value : nullptr; }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    const T* FindPtr(const Key& key) const { Node *node = FindNode(key); return node ? &node->value : nullptr; }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    bool Find(const Key& key) const { return FindNode(key) != nullptr; }
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
     void Print() const; // вывод таблицы
 
     ~SeparateChainingTable(); // деструктор (освобождение памяти)
 };
 
-// конструктор из размера и хеш-функции
-template <typename K, typename T>
-SeparateChainingTable<K, T>::SeparateChainingTable(int tableSize, int (*h)(K)) {
+// конструктор из размера, хеш-функции, сравнения ключей и аллокатора
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::SeparateChainingTable(int tableSize, const Hash& hasher, const KeyEqual& keyEqual, const Allocator& allocator) : nodes(allocator), hasher(hasher), keyEqual(keyEqual) {
 	this->capacity = tableSize; // запоминаем в ёмкости переданный размер
 	this->size = 0; // изначально нет элементов
 
@@ -56,30 +99,29 @@ SeparateChainingTable<K, T>::SeparateChainingTable(int tableSize, int (*h)(K)) {
 	// обнуляем все списки
 	for (int i = 0; i < tableSize; i++)
 		cells[i] = nullptr;
+}
 
-	this->h = h; // запоминаем указатель на хеш-функцию
+// конструктор из размера и указателя на хеш-функцию
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::SeparateChainingTable(int tableSize, int (*h)(K)) : SeparateChainingTable(tableSize, Hash(h)) {
 }
 
 // конструктор копирования
-template <typename K, typename T>
-SeparateChainingTable<K, T>::SeparateChainingTable(const SeparateChainingTable& table) {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::SeparateChainingTable(const SeparateChainingTable& table) : nodes(table.nodes), hasher(table.hasher), keyEqual(table.keyEqual) {
 	capacity = table.capacity; // копируем ёмкость
 	size = table.size; // копируем количество элементов
-	cells = new Node*[capacity]; // выделяем память под ячейки
-
-	h = table.h; // копируем указатель на функцию
+	cells = capacity > 0 ? new Node*[capacity] : nullptr; // выделяем память под ячейки (у перемещённой таблицы их нет)
 
 	// проходимся по всем ячейкам таблицы
 	for (int i = 0; i < capacity; i++) {
 		Node *prev = nullptr;
 
+		cells[i] = nullptr; // пустые списки копируемой таблицы остаются пустыми
+
 		// проходимся по всему списку каждой ячейки
 		for (Node *elem = table.cells[i]; elem != nullptr; elem = elem->next) {
-			Node *node = new Node; // создаём новый элемент
-
-			node->key = elem->key; // сохраняем ключ
-			node->value = elem->value; // сохраняем значение
-			node->next = nullptr;
+			Node *node = CreateNode(elem->key, elem->value, nullptr); // создаём новый элемент
 
 			if (prev == nullptr) { // если нет предыдущего
 				cells[i] = node; // то этот элемент первый в списке
@@ -93,32 +135,143 @@ SeparateChainingTable<K, T>::SeparateChainingTable(const SeparateChainingTable&
 	}
 }
 
-// // добавление значения по ключу
-template <typename K, typename T>
-void SeparateChainingTable<K, T>::Insert(const K& key, const T& value) {
-	int index = h(key) % capacity; // получаем индекс для вставки
+// конструктор перемещения: таблица забирает массив и узлы, а перемещённой остаётся нулевая ёмкость без выделенной памяти
+// (массив из одного списка выделяется при следующей вставке)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::SeparateChainingTable(SeparateChainingTable&& table) noexcept : nodes(table.nodes), hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = 0;
+	size = 0;
+	cells = nullptr;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>& SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::operator=(SeparateChainingTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+void SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Swap(SeparateChainingTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(size, table.size);
+	swap(cells, table.cells);
+	nodes.Swap(table.nodes); // узлы остаются на месте, меняется только владелец памяти
+	swap(hasher, table.hasher);
+	swap(keyEqual, table.keyEqual);
+}
+
+// создание узла
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+template <typename KeyArg, typename ValueArg>
+typename SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Node* SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::CreateNode(KeyArg&& key, ValueArg&& value, Node *next) {
+	return new (nodes.Allocate()) Node { forward<KeyArg>(key), forward<ValueArg>(value), next }; // конструируем узел в выделенной памяти
+}
+
+// удаление узла
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+void SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::DestroyNode(Node *node) {
+	node->~Node();
+	nodes.Deallocate(node);
+}
+
+// поиск элемента с ключом (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+template <typename Key>
+typename SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Node* SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::FindNode(const Key& key) const {
+	return FindNode(key, hasher(key));
+}
+
+// поиск элемента с ключом по значению хеш-функции (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+template <typename Key>
+typename SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Node* SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::FindNode(const Key& key, uint64_t hash) const {
+	if (capacity == 0)
+		return nullptr; // у перемещённой таблицы нет списков
+
+	int index = hash % capacity; // получаем индекс ячейки по хешу
+
+	Node *node = cells[index]; // запоминаем элемент списка
+
+	// ищем элемент
+	while (node && !keyEqual(node->key, key))
+		node = node->next;
+
+	return node; // если не дошли до конца, значит нашли, иначе нет
+}
+
+// хеш ключа с предварительной загрузкой ячейки списка в кеш
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+uint64_t SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::PrefetchKey(const K& key) const {
+	uint64_t hash = hasher(key);
+
+	if (capacity > 0) // у перемещённой таблицы нет списков
+		__builtin_prefetch(cells + hash % capacity);
+
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+const T* SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::FindHashed(const K& key, uint64_t hash) const {
+	Node *node = FindNode(key, hash);
+
+	return node ? &node->value : nullptr;
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+template <typename KeyArg, typename ValueArg>
+pair<T*, bool> SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Emplace(KeyArg&& key, ValueArg&& value, bool assign) {
+	// у перемещённой таблицы массив выделяется только при первой вставке
+	if (capacity == 0) {
+		cells = new Node*[1] { nullptr };
+		capacity = 1;
+	}
+
+	int index = hasher(key) % capacity; // получаем индекс списка по ключу
+
+	// ищем элемент с таким ключом в списке
+	for (Node *node = cells[index]; node != nullptr; node = node->next) {
+		if (keyEqual(node->key, key)) {
+			if (assign)
+				node->value = forward<ValueArg>(value); // обновляем значение на месте
 
-	Node *node = new Node; // создаём новый элемент
+			return make_pair(&node->value, false);
+		}
+	}
 
-	node->key = key; // сохраняем ключ
-	node->value = value; // сохраняем значение
-	node->next = cells[index]; // следующий элемент будет первый в списке
+	Node *node = CreateNode(forward<KeyArg>(key), forward<ValueArg>(value), cells[index]); // следующий элемент будет первый в списке
 
 	cells[index] = node; // вставляем в начало списка для быстродействия
 
 	size++; // увеличиваем счётчик числа элементов
+
+	return make_pair(&node->value, true);
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+void SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
 }
 
 // удаление по ключу
-template <typename K, typename T>
-bool SeparateChainingTable<K, T>::Remove(const K& key) {
-	int index = h(key) % capacity; // получаем индекс списка по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+bool SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Remove(const K& key) {
+	if (capacity == 0)
+		return false; // у перемещённой таблицы нет элементов
+
+	int index = hasher(key) % capacity; // получаем индекс списка по ключу
 
 	Node *node = cells[index]; // первый элемент списка
 	Node *prev = nullptr; // предыдущий элемент
 
 	// ищем элемент в списке
-	while (node && node->key != key) {
+	while (node && !keyEqual(node->key, key)) {
 		prev = node; // запоминаем предыдущий
 		node = node->next; // переходим на следующий
 	}
@@ -135,7 +288,7 @@ bool SeparateChainingTable<K, T>::Remove(const K& key) {
 		prev->next = node->next; // иначе перебрасываем указатель предыдущего на следующий
 	}
 
-	delete node; // удаляем элемент списка из памяти
+	DestroyNode(node); // удаляем элемент списка из памяти
 
 	size--; // уменьшаем счётчик числа элементов
 
@@ -143,27 +296,28 @@ bool SeparateChainingTable<K, T>::Remove(const K& key) {
 }
 
 // поиск по ключу
-template <typename K, typename T>
-bool SeparateChainingTable<K, T>::Find(const K& key) const {
-	int index = h(key) % capacity; // получаем индекс ячейки по ключу
-
-	Node *node = cells[index]; // запоминаем элемент списка
-
-	// ищем элемент
-	while (node && node->key != key)
-		node = node->next;
-
-	return node != nullptr; // если не дошли до конца, значит нашли, иначе нет
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+bool SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Find(const K& key) const {
+	return FindNode(key) != nullptr;
 }
 
-template <typename K, typename T>
-void SeparateChainingTable<K, T>::Clear() {
-	for (int i = 0; i < capacity; i++) {
-		while (cells[i]) {
-			Node *node = cells[i]; // запоминаем текущий элемент
-			cells[i] = cells[i]->next; // переходим на следующий
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+void SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Clear() {
+	// если узлам не нужны деструкторы, то освобождаем память целыми блоками, не обходя списки
+	if constexpr (Nodes<Node, Allocator>::CAN_RELEASE && is_trivially_destructible<Node>::value) {
+		nodes.Release();
+
+		for (int i = 0; i < capacity; i++)
+			cells[i] = nullptr;
+	}
+	else {
+		for (int i = 0; i < capacity; i++) {
+			while (cells[i]) {
+				Node *node = cells[i]; // запоминаем текущий элемент
+				cells[i] = cells[i]->next; // переходим на следующий
 
-			delete node; // удаляем элемент
+				DestroyNode(node); // удаляем элемент
+			}
 		}
 	}
 
@@ -171,27 +325,21 @@ void SeparateChainingTable<K, T>::Clear() {
 }
 
 // получение размера
-template <typename K, typename T>
-int SeparateChainingTable<K, T>::GetSize() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+int SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::GetSize() const {
 	return size; // возвращаем размер
 }
 
 // проверка на пустоту
-template <typename K, typename T>
-bool SeparateChainingTable<K, T>::IsEmpty() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+bool SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::IsEmpty() const {
 	return size == 0; // таблица пуста, если нет элементов
 }
 
 // получение значения по ключу
-template <typename K, typename T>
-T SeparateChainingTable<K, T>::Get(const K& key) const {
-	int index = h(key) % capacity; // получаем индекс по ключу
-
-	Node *node = cells[index];
-
-	// ищем элемент с таким ключом
-	while (node && node->key != key)
-		node = node->next;
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+T SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Get(const K& key) const {
+	Node *node = FindNode(key); // ищем элемент с таким ключом
 
 	// если не нашли элемент с таким ключом
 	if (node == nullptr)
@@ -200,17 +348,65 @@ T SeparateChainingTable<K, T>::Get(const K& key) const {
 	return node->value; // возвращаем значение
 }
 
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+T* SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::FindPtr(const K& key) {
+	Node *node = FindNode(key);
+
+	return node ? &node->value : nullptr;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+const T* SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::FindPtr(const K& key) const {
+	Node *node = FindNode(key);
+
+	return node ? &node->value : nullptr;
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+pair<T*, bool> SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::TryEmplace(K key, T value) {
+	return Emplace(move(key), move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+pair<T*, bool> SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::InsertOrAssign(K key, T value) {
+	return Emplace(move(key), move(value), true);
+}
+
 // деструктор (освобождения памяти)
-template <typename K, typename T>
-SeparateChainingTable<K, T>::~SeparateChainingTable() {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::~SeparateChainingTable() {
 	Clear(); // удаляем все элементы
 
 	delete[] cells; // удаляем массив ячеек
 }
 
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+TableStats SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.bytes = sizeof(*this) + capacity * sizeof(Node*) + nodes.Bytes(size);
+
+	for (int i = 0; i < capacity; i++) {
+		int length = 0; // длина цепочки
+
+		for (Node *node = cells[i]; node; node = node->next)
+			stats.AddHit(++length); // элемент находится после сравнения со всеми предыдущими
+
+		stats.AddChain(length);
+		stats.AddMiss(length); // неуспешный поиск проходит всю цепочку
+	}
+
+	return stats;
+}
+
 // оператор вывода в поток
-template <typename K, typename T>
-void SeparateChainingTable<K, T>::Print() const {
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+void SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>::Print() const {
     for (int i = 0; i < capacity; i++) {
 		if (cells[i] == nullptr)
 			continue; // если нет списка, то переходим к следующему элементу
@@ -228,3 +424,9 @@ void SeparateChainingTable<K, T>::Print() const {
 		cout << endl;
 	}
 }
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash, typename KeyEqual, typename Allocator, template <typename, typename> class Nodes>
+void swap(SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>& table1, SeparateChainingTable<K, T, Hash, KeyEqual, Allocator, Nodes>& table2) {
+	table1.Swap(table2);
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include "HashFunctions.hpp"
+#include "LinearProbingTable.hpp"
+
+using namespace std;
+
+/*
+	Потокобезопасная хеш таблица с разделением на сегменты (lock striping)
+	Ключи распределяются по независимым таблицам-сегментам по старшим битам
+	перемешанного хеша (младшие биты использует сама таблица-сегмент), у каждого
+	сегмента свой shared_mutex: чтения одного сегмента идут параллельно, а
+	изменения блокируют только свой сегмент. Указатели на значения наружу
+	не выдаются, так как после снятия блокировки они могут стать недействительными
+*/
+
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename Table = LinearProbingTable<K, T, Hash>>
+class ShardedTable {
+    // сегмент занимает отдельные линии кеша, чтобы блокировки соседних сегментов не мешали друг другу
+    struct alignas(64) Shard {
+    	mutable shared_mutex mutex; // блокировка сегмента
+    	Table table; // таблица сегмента
+
+    	Shard(int tableSize, const Hash& hasher) : table(tableSize, hasher) {}
+    };
+
+    int bits; // число бит хеша, задающих сегмент
+    vector<unique_ptr<Shard>> shards; // сегменты
+    Hash hasher; // хеш-функция
+
+    Shard& GetShard(const K& key) const; // сегмент, хранящий ключ
+
+public:
+    ShardedTable(int tableSize, const Hash& hasher = Hash(), int shardCount = 16); // конструктор из размера, хеш-функции и числа сегментов (округляется вверх до степени двойки)
+    ShardedTable(int tableSize, int (*h)(K), int shardCount = 16); // конструктор из размера, указателя на хеш-функцию и числа сегментов
+    ShardedTable(const ShardedTable& table) = delete;
+    ShardedTable& operator=(const ShardedTable& table) = delete;
+
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
+    bool Remove(const K& key); // удаление по ключу
+    bool Find(const K& key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы
+
+    int GetSize() const; // получение размера (при одновременных изменениях - приблизительного)
+    bool IsEmpty() const; // проверка на пустоту
+    int GetShardCount() const; // получение числа сегментов
+
+    T Get(const K& key) const; // получение значения по ключу
+    bool TryGet(const K& key, T& value) const; // получение значения по ключу без исключения (ложь, если нет)
+
+    bool TryEmplace(const K& key, const T& value); // добавление, если ключа нет (истина, если добавили)
+    bool InsertOrAssign(const K& key, const T& value); // добавление или замена значения по ключу (истина, если добавили)
+
+    template <typename Updater>
+    bool Update(const K& key, Updater update); // изменение значения на месте под блокировкой сегмента (ложь, если ключа нет)
+
+    TableStats GetStats() const; // суммарная статистика сегментов
+
+    void Print() const; // вывод таблицы
+};
+
+// конструктор из размера, хеш-функции и числа сегментов
+template <typename K, typename T, typename Hash, typename Table>
+ShardedTable<K, T, Hash, Table>::ShardedTable(int tableSize, const Hash& hasher, int shardCount) : hasher(hasher) {
+	bits = 0;
+
+	while ((1 << bits) < shardCount)
+		bits++;
+
+	int shardSize = max(1, tableSize >> bits); // начальный размер таблицы каждого сегмента
+
+	for (int i = 0; i < (1 << bits); i++)
+		shards.emplace_back(new Shard(shardSize, hasher));
+}
+
+// конструктор из размера, указателя на хеш-функцию и числа сегментов
+template <typename K, typename T, typename Hash, typename Table>
+ShardedTable<K, T, Hash, Table>::ShardedTable(int tableSize, int (*h)(K), int shardCount) : ShardedTable(tableSize, Hash(h), shardCount) {
+}
+
+// сегмент, хранящий ключ
+template <typename K, typename T, typename Hash, typename Table>
+typename ShardedTable<K, T, Hash, Table>::Shard& ShardedTable<K, T, Hash, Table>::GetShard(const K& key) const {
+	if (bits == 0)
+		return *shards[0];
+
+	// хеш перемешивается, чтобы старшие биты зависели от всех битов ключа даже для простых хеш-функций
+	return *shards[MixHash(hasher(key)) >> (64 - bits)];
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename Table>
+void ShardedTable<K, T, Hash, Table>::Insert(const K& key, const T& value) {
+	Shard& shard = GetShard(key);
+	unique_lock<shared_mutex> lock(shard.mutex);
+
+	shard.table.Insert(key, value);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash, typename Table>
+bool ShardedTable<K, T, Hash, Table>::Remove(const K& key) {
+	Shard& shard = GetShard(key);
+	unique_lock<shared_mutex> lock(shard.mutex);
+
+	return shard.table.Remove(key);
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename Table>
+bool ShardedTable<K, T, Hash, Table>::Find(const K& key) const {
+	Shard& shard = GetShard(key);
+	shared_lock<shared_mutex> lock(shard.mutex);
+
+	return shard.table.Find(key);
+}
+
+// очистка таблицы
+template <typename K, typename T, typename Hash, typename Table>
+void ShardedTable<K, T, Hash, Table>::Clear() {
+	for (size_t i = 0; i < shards.size(); i++) {
+		unique_lock<shared_mutex> lock(shards[i]->mutex);
+		shards[i]->table.Clear();
+	}
+}
+
+// получение размера
+template <typename K, typename T, typename Hash, typename Table>
+int ShardedTable<K, T, Hash, Table>::GetSize() const {
+	int size = 0;
+
+	for (size_t i = 0; i < shards.size(); i++) {
+		shared_lock<shared_mutex> lock(shards[i]->mutex);
+		size += shards[i]->table.GetSize();
+	}
+
+	return size;
+}
+
+// проверка на пустоту
+template <typename K, typename T, typename Hash, typename Table>
+bool ShardedTable<K, T, Hash, Table>::IsEmpty() const {
+	return GetSize() == 0;
+}
+
+// получение числа сегментов
+template <typename K, typename T, typename Hash, typename Table>
+int ShardedTable<K, T, Hash, Table>::GetShardCount() const {
+	return shards.size();
+}
+
+// получение значения по ключу
+template <typename K, typename T, typename Hash, typename Table>
+T ShardedTable<K, T, Hash, Table>::Get(const K& key) const {
+	Shard& shard = GetShard(key);
+	shared_lock<shared_mutex> lock(shard.mutex);
+
+	return shard.table.Get(key); // копия значения делается под блокировкой
+}
+
+// получение значения по ключу без исключения (ложь, если нет)
+template <typename K, typename T, typename Hash, typename Table>
+bool ShardedTable<K, T, Hash, Table>::TryGet(const K& key, T& value) const {
+	Shard& shard = GetShard(key);
+	shared_lock<shared_mutex> lock(shard.mutex);
+
+	return shard.table.TryGet(key, value);
+}
+
+// добавление, если ключа нет (истина, если добавили)
+template <typename K, typename T, typename Hash, typename Table>
+bool ShardedTable<K, T, Hash, Table>::TryEmplace(const K& key, const T& value) {
+	Shard& shard = GetShard(key);
+	unique_lock<shared_mutex> lock(shard.mutex);
+
+	return shard.table.TryEmplace(key, value).second;
+}
+
+// добавление или замена значения по ключу (истина, если добавили)
+template <typename K, typename T, typename Hash, typename Table>
+bool ShardedTable<K, T, Hash, Table>::InsertOrAssign(const K& key, const T& value) {
+	Shard& shard = GetShard(key);
+	unique_lock<shared_mutex> lock(shard.mutex);
+
+	return shard.table.InsertOrAssign(key, value).second;
+}
+
+// изменение значения на месте под блокировкой сегмента (ложь, если ключа нет)
+template <typename K, typename T, typename Hash, typename Table>
+template <typename Updater>
+bool ShardedTable<K, T, Hash, Table>::Update(const K& key, Updater update) {
+	Shard& shard = GetShard(key);
+	unique_lock<shared_mutex> lock(shard.mutex);
+	T *value = shard.table.FindPtr(key);
+
+	if (value == nullptr)
+		return false;
+
+	update(*value);
+	return true;
+}
+
+// суммарная статистика сегментов
+template <typename K, typename T, typename Hash, typename Table>
+TableStats ShardedTable<K, T, Hash, Table>::GetStats() const {
+	TableStats stats;
+
+	for (size_t i = 0; i < shards.size(); i++) {
+		shared_lock<shared_mutex> lock(shards[i]->mutex);
+		stats += shards[i]->table.GetStats();
+	}
+
+	return stats;
+}
+
+// вывод таблицы
+template <typename K, typename T, typename Hash, typename Table>
+void ShardedTable<K, T, Hash, Table>::Print() const {
+	for (size_t i = 0; i < shards.size(); i++) {
+		shared_lock<shared_mutex> lock(shards[i]->mutex);
+
+		cout << "Shard " << i << ":" << endl;
+		shards[i]->table.Print();
+	}
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "HashFunctions.hpp"
+
+/*
+	Формат снимка таблицы с открытой адресацией
+	Файл состоит из заголовка, массива ячеек и кучи строк. Ячейки записываются
+	в том же порядке и с тем же расположением полей, что и в памяти таблицы
+	(ключ, значение, состояние), поэтому открытая через mmap таблица (MappedTable)
+	отвечает на запросы сразу, без перестроения и разбора. Тривиально копируемые
+	ключи и значения хранятся в ячейке как есть, а строки - в куче, причём ячейка
+	хранит смещение и длину строки. Заголовок содержит версию формата, размеры
+	полей для проверки совместимости и контрольную сумму ячеек и кучи
+*/
+
+const char SNAPSHOT_MAGIC[8] = { 'H', 'T', 'S', 'N', 'A', 'P', 'S', 'H' }; // сигнатура файла
+const uint32_t SNAPSHOT_VERSION = 1; // версия формата
+const uint32_t SNAPSHOT_ENDIAN = 0x01020304; // порядок байтов записавшей машины
+const uint64_t SNAPSHOT_INDEX_PROBE = 0x9E3779B97F4A7C15ull; // хеш, индекс которого проверяет способ выбора ёмкости
+
+// состояния ячеек снимка (совпадают с состояниями ячеек таблиц с пробированием)
+const int SNAPSHOT_FREE = 0;
+const int SNAPSHOT_BUSY = 1;
+const int SNAPSHOT_REMOVED = 2;
+
+// заголовок снимка
+struct SnapshotHeader {
+	char magic[8]; // сигнатура файла
+	uint32_t version; // версия формата
+	uint32_t endian; // SNAPSHOT_ENDIAN в порядке байтов записавшей машины
+	uint32_t cellSize; // размер ячейки
+	uint32_t keySize; // размер представления ключа
+	uint32_t valueSize; // размер представления значения
+	int32_t capacity; // ёмкость таблицы
+	int32_t size; // число элементов
+	int32_t q; // шаг пробирования
+	int32_t indexCheck; // начальная ячейка хеша SNAPSHOT_INDEX_PROBE
+	uint32_t reserved; // выравнивание (всегда 0)
+	uint64_t cellsOffset; // смещение массива ячеек от начала файла
+	uint64_t heapOffset; // смещение кучи строк от начала файла
+	uint64_t heapSize; // размер кучи строк
+	uint64_t checksum; // контрольная сумма заголовка (с нулевым полем суммы), ячеек и кучи
+};
+
+// представление типа в ячейке снимка: тривиально копируемые типы хранятся как есть
+template <typename X>
+struct SnapshotCodec {
+	static_assert(std::is_trivially_copyable<X>::value, "snapshot supports trivially copyable types and strings");
+
+	typedef X Stored;
+
+	static Stored Encode(const X& value, std::vector<char>& heap) { return value; }
+	static X Decode(const Stored& stored, const char *heap, uint64_t heapSize) { return stored; }
+	static bool Equal(const Stored& stored, const char *heap, uint64_t heapSize, const X& value) { return stored == value; }
+};
+
+// строки хранятся в куче, а ячейка содержит их положение
+template <>
+struct SnapshotCodec<std::string> {
+	struct Stored {
+		uint32_t offset; // смещение строки в куче
+		uint32_t length; // длина строки
+	};
+
+	static Stored Encode(const std::string& value, std::vector<char>& heap) {
+		if (heap.size() + value.length() > UINT32_MAX)
+			throw std::string("String heap of snapshot is too large");
+
+		Stored stored = { (uint32_t) heap.size(), (uint32_t) value.length() };
+		heap.insert(heap.end(), value.begin(), value.end());
+		return stored;
+	}
+
+	// положение строки проверяется при каждом обращении: повреждённый снимок не должен приводить к чтению за пределами кучи
+	static bool InHeap(const Stored& stored, uint64_t heapSize) {
+		return (uint64_t) stored.offset + stored.length <= heapSize;
+	}
+
+	static std::string Decode(const Stored& stored, const char *heap, uint64_t heapSize) {
+		if (!InHeap(stored, heapSize))
+			throw std::string("Snapshot string is out of heap bounds");
+
+		return std::string(heap + stored.offset, stored.length);
+	}
+
+	static bool Equal(const Stored& stored, const char *heap, uint64_t heapSize, const std::string& value) {
+		return stored.length == value.length() && InHeap(stored, heapSize) && memcmp(heap + stored.offset, value.data(), stored.length) == 0;
+	}
+};
+
+// ячейка снимка
+template <typename K, typename T>
+struct SnapshotCell {
+	typename SnapshotCodec<K>::Stored key; // представление ключа
+	typename SnapshotCodec<T>::Stored value; // представление значения
+	int32_t state; // состояние ячейки
+};
+
+// контрольная сумма снимка
+inline uint64_t SnapshotChecksum(SnapshotHeader header, const void *cells, size_t cellsSize, const void *heap, size_t heapSize) {
+	header.checksum = 0;
+
+	uint64_t checksum = HashBytes(&header, sizeof(header));
+	checksum = HashBytes(cells, cellsSize, checksum);
+	return HashBytes(heap, heapSize, checksum);
+}
+
+// построение снимка: ячейки добавляются по порядку, а затем снимок записывается в файл
+template <typename K, typename T>
+class SnapshotWriter {
+    typedef SnapshotCell<K, T> Cell;
+
+    SnapshotHeader header; // заголовок
+    std::vector<Cell> cells; // ячейки
+    std::vector<char> heap; // куча строк
+
+public:
+    SnapshotWriter(int capacity, int size, int q, int indexCheck);
+
+    void Add(int state); // добавление свободной или удалённой ячейки
+    void Add(const K& key, const T& value); // добавление занятой ячейки
+
+    void Write(const std::string& path); // запись снимка в файл
+};
+
+template <typename K, typename T>
+SnapshotWriter<K, T>::SnapshotWriter(int capacity, int size, int q, int indexCheck) {
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+
+	header.version = SNAPSHOT_VERSION;
+	header.endian = SNAPSHOT_ENDIAN;
+	header.cellSize = sizeof(Cell);
+	header.keySize = sizeof(typename SnapshotCodec<K>::Stored);
+	header.valueSize = sizeof(typename SnapshotCodec<T>::Stored);
+	header.capacity = capacity;
+	header.size = size;
+	header.q = q;
+	header.indexCheck = indexCheck;
+
+	cells.reserve(capacity);
+}
+
+// добавление свободной или удалённой ячейки
+template <typename K, typename T>
+void SnapshotWriter<K, T>::Add(int state) {
+	Cell cell;
+	memset(&cell, 0, sizeof(cell)); // байты выравнивания тоже нулевые, поэтому контрольная сумма воспроизводима
+	cell.state = state;
+	cells.push_back(cell);
+}
+
+// добавление занятой ячейки
+template <typename K, typename T>
+void SnapshotWriter<K, T>::Add(const K& key, const T& value) {
+	Cell cell;
+	memset(&cell, 0, sizeof(cell));
+	cell.key = SnapshotCodec<K>::Encode(key, heap);
+	cell.value = SnapshotCodec<T>::Encode(value, heap);
+	cell.state = SNAPSHOT_BUSY;
+	cells.push_back(cell);
+}
+
+// запись снимка в файл: массив ячеек выравнивается по 64 байтам
+template <typename K, typename T>
+void SnapshotWriter<K, T>::Write(const std::string& path) {
+	size_t cellsSize = cells.size() * sizeof(Cell);
+
+	header.cellsOffset = (sizeof(header) + 63) / 64 * 64;
+	header.heapOffset = header.cellsOffset + cellsSize;
+	header.heapSize = heap.size();
+	header.checksum = SnapshotChecksum(header, cells.data(), cellsSize, heap.data(), heap.size());
+
+	std::ofstream f(path, std::ios::binary);
+
+	if (!f)
+		throw std::string("Unable to open file '") + path + "'";
+
+	std::vector<char> padding(header.cellsOffset - sizeof(header), 0);
+
+	f.write((const char *) &header, sizeof(header));
+	f.write(padding.data(), padding.size());
+	f.write((const char *) cells.data(), cellsSize);
+	f.write(heap.data(), heap.size());
+
+	if (!f)
+		throw std::string("Unable to write file '") + path + "'";
+}
@@ -0,0 +1,570 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "HashTable.h"
+#include "HashFunctions.hpp"
+#include "CellStorage.hpp"
+
+using namespace std;
+
+/*
+	Хеш таблица с линейным пробированием для строковых ключей
+	Ячейка ключа хранит полный 64-битный хеш и длину ключа, а байты ключа
+	сравниваются только при совпадении хеша и длины, поэтому поиск почти
+	никогда не сравнивает строки, отличные от искомой. Нулевой хеш обозначает
+	свободную ячейку (хеш, равный нулю, хранится как 1), поэтому обнулённый при
+	выделении массив сразу состоит из свободных ячеек
+	Короткие ключи (до 20 байт) хранятся прямо в ячейке, а длинные - в общей
+	арене, и ячейка хранит их смещение: ключи не выделяют память по отдельности.
+	Ключи удалённых элементов остаются в арене, пока их суммарная длина не
+	превысит половину арены, после чего арена уплотняется
+	Удаление выполняется сдвигом назад и перемещает ячейки целиком, не пересчитывая
+	хеши. Хеш-функция принимает string_view, поэтому ключи не копируются ни при
+	хешировании, ни при поиске по string_view и const char*
+*/
+
+template <typename T, typename Hash = StringHash>
+class StringTable final : public HashTable<string, T> {
+	static constexpr int INLINE_SIZE = 20; // наибольшая длина ключа, хранящегося в ячейке
+	static constexpr size_t MIN_COMPACT_SIZE = 4096; // размер арены, начиная с которого она уплотняется
+	static constexpr uint64_t FIBONACCI = 0x9e3779b97f4a7c15ULL; // 2^64 / φ, множитель для вычисления начальной ячейки
+
+    // ключ элемента (32 байта)
+    struct Slot {
+    	uint64_t hash; // хеш ключа (0 - свободная ячейка)
+    	uint32_t length; // длина ключа
+    	char bytes[INLINE_SIZE]; // байты короткого ключа или смещение длинного ключа в арене
+    };
+
+    int capacity; // ёмкость таблицы (степень двойки)
+    int shift; // сдвиг произведения хеша, оставляющий номер ячейки
+    int size; // число элементов в таблице
+    double maxLoadFactor; // максимальный коэффициент заполнения
+
+    Slot *slots; // массив ключей
+    T *values; // массив значений
+
+    vector<char> arena; // байты длинных ключей
+    size_t garbage; // суммарная длина ключей удалённых элементов в арене
+
+    Hash hasher; // хеш-функция
+
+    void Allocate(int tableSize); // выделение памяти под свободные ячейки
+    uint64_t KeyHash(string_view key) const; // хеш ключа в виде, хранимом в ячейке (не равен нулю)
+    int Home(uint64_t hash) const; // начальная ячейка по хешу ключа
+    const char* KeyData(const Slot& slot) const; // байты ключа ячейки
+    int Probe(string_view key, uint64_t hash, bool& found) const; // поиск ячейки с ключом или свободной ячейки, на которой поиск остановился
+    const T* FindValue(string_view key) const; // поиск значения по ключу (nullptr, если нет)
+    const T* FindValue(string_view key, uint64_t hash) const;
+
+    uint64_t PrefetchKey(const string& key) const; // хеш ключа с предварительной загрузкой начальной ячейки в кеш
+    const T* FindHashed(const string& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+
+    pair<T*, bool> Emplace(string_view key, T value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+    void Rebuild(int newCapacity); // перестроение таблицы
+    void Compact(); // уплотнение арены (удаление ключей удалённых элементов)
+    void Release(); // уничтожение элементов и освобождение памяти
+
+public:
+    StringTable(int tableSize, const Hash& hasher = Hash(), double maxLoadFactor = 0.75); // конструктор из размера, хеш-функции и коэффициента заполнения
+    StringTable(const StringTable& table); // конструктор копирования
+    StringTable(StringTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    StringTable& operator=(StringTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(StringTable& table) noexcept; // обмен содержимым таблиц за O(1)
+
+    void Insert(const string& key, const T& value); // добавление или замена значения по ключу
+    bool Remove(const string& key); // удаление по ключу
+    bool Find(const string& key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+
+    T Get(const string& key) const; // получение значения по ключу
+
+    T* FindPtr(const string& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const string& key) const;
+
+    pair<T*, bool> TryEmplace(string key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(string key, T value); // добавление или замена значения по ключу
+
+    // поиск по string_view и const char* без создания string
+    template <typename Key, typename = enable_if_t<is_convertible<const Key&, string_view>::value>>
+    T* FindPtr(const Key& key) { return const_cast<T*>(FindValue(key)); }
+
+    template <typename Key, typename = enable_if_t<is_convertible<const Key&, string_view>::value>>
+    const T* FindPtr(const Key& key) const { return FindValue(key); }
+
+    template <typename Key, typename = enable_if_t<is_convertible<const Key&, string_view>::value>>
+    bool Find(const Key& key) const { return FindValue(key) != nullptr; }
+
+    size_t GetArenaSize() const; // объём арены длинных ключей (вместе с ещё не удалёнными уплотнением ключами)
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Print() const; // вывод таблицы
+
+    ~StringTable(); // деструктор (освобождение памяти)
+};
+
+// конструктор из размера, хеш-функции и коэффициента заполнения
+template <typename T, typename Hash>
+StringTable<T, Hash>::StringTable(int tableSize, const Hash& hasher, double maxLoadFactor) : hasher(hasher) {
+	this->size = 0; // изначально нет элементов
+	this->maxLoadFactor = maxLoadFactor;
+	this->garbage = 0;
+
+	Allocate(tableSize); // выделяем память под ячейки (все ячейки сразу свободны)
+}
+
+// конструктор копирования
+template <typename T, typename Hash>
+StringTable<T, Hash>::StringTable(const StringTable& table) : arena(table.arena), hasher(table.hasher) {
+	size = table.size; // копируем количество элементов
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
+	garbage = table.garbage;
+
+	// у перемещённой таблицы массивов нет, поэтому нет их и у копии
+	if (table.capacity == 0) {
+		capacity = 0;
+		shift = 0;
+		slots = nullptr;
+		values = nullptr;
+		return;
+	}
+
+	Allocate(table.capacity); // выделяем память под массивы той же ёмкости
+	memcpy(slots, table.slots, capacity * sizeof(Slot)); // смещения длинных ключей действительны и в копии арены
+
+	// значения копируются только в занятых ячейках
+	for (int i = 0; i < capacity; i++)
+		if (slots[i].hash != 0)
+			new (values + i) T(table.values[i]);
+}
+
+// конструктор перемещения: таблица забирает массивы и арену, а перемещённой остаётся нулевая ёмкость без выделенной памяти
+// (массивы выделяются при следующей вставке)
+template <typename T, typename Hash>
+StringTable<T, Hash>::StringTable(StringTable&& table) noexcept : hasher(table.hasher) {
+	capacity = 0;
+	shift = 0;
+	size = 0;
+	maxLoadFactor = table.maxLoadFactor;
+	slots = nullptr;
+	values = nullptr;
+	garbage = 0;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename T, typename Hash>
+StringTable<T, Hash>& StringTable<T, Hash>::operator=(StringTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename T, typename Hash>
+void StringTable<T, Hash>::Swap(StringTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(shift, table.shift);
+	swap(size, table.size);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(slots, table.slots);
+	swap(values, table.values);
+	swap(arena, table.arena);
+	swap(garbage, table.garbage);
+	swap(hasher, table.hasher);
+}
+
+// выделение памяти под свободные ячейки
+template <typename T, typename Hash>
+void StringTable<T, Hash>::Allocate(int tableSize) {
+	int newCapacity = 2; // поиск останавливается на свободной ячейке, поэтому ячеек больше одной
+
+	while (newCapacity < tableSize)
+		newCapacity *= 2;
+
+	Slot *newSlots = static_cast<Slot*>(AllocateZeroed(newCapacity, sizeof(Slot)));
+	T *newValues;
+
+	// при нехватке памяти уже выделенный массив освобождается, а таблица не меняется
+	try {
+		newValues = static_cast<T*>(AllocateZeroed(newCapacity, sizeof(T)));
+	}
+	catch (...) {
+		free(newSlots);
+		throw;
+	}
+
+	capacity = newCapacity;
+	shift = 64 - __builtin_ctz(capacity);
+	slots = newSlots;
+	values = newValues;
+}
+
+// хеш ключа в виде, хранимом в ячейке (не равен нулю)
+template <typename T, typename Hash>
+uint64_t StringTable<T, Hash>::KeyHash(string_view key) const {
+	uint64_t hash = hasher(key);
+
+	return hash == 0 ? 1 : hash; // нулевой хеш обозначает свободную ячейку
+}
+
+// начальная ячейка по хешу ключа
+template <typename T, typename Hash>
+int StringTable<T, Hash>::Home(uint64_t hash) const {
+	return (hash * FIBONACCI) >> shift;
+}
+
+// байты ключа ячейки
+template <typename T, typename Hash>
+const char* StringTable<T, Hash>::KeyData(const Slot& slot) const {
+	if (slot.length <= INLINE_SIZE)
+		return slot.bytes;
+
+	size_t offset;
+	memcpy(&offset, slot.bytes, sizeof(offset));
+
+	return arena.data() + offset;
+}
+
+// поиск ячейки с ключом или свободной ячейки, на которой поиск остановился (found - найден ли ключ)
+template <typename T, typename Hash>
+int StringTable<T, Hash>::Probe(string_view key, uint64_t hash, bool& found) const {
+	int index = Home(hash); // начальная ячейка
+
+	// в массиве всегда есть свободная ячейка, поэтому цикл завершается
+	while (true) {
+		const Slot& slot = slots[index];
+
+		if (slot.hash == 0) {
+			found = false;
+			return index; // нашли свободную ячейку - ключа нет
+		}
+
+		// байты сравниваются, только если совпали хеш и длина
+		if (slot.hash == hash && slot.length == key.length() && memcmp(KeyData(slot), key.data(), key.length()) == 0) {
+			found = true;
+			return index;
+		}
+
+		index = (index + 1) & (capacity - 1); // переходим к следующей ячейке
+	}
+}
+
+// поиск значения по ключу (nullptr, если нет)
+template <typename T, typename Hash>
+const T* StringTable<T, Hash>::FindValue(string_view key) const {
+	return FindValue(key, KeyHash(key));
+}
+
+template <typename T, typename Hash>
+const T* StringTable<T, Hash>::FindValue(string_view key, uint64_t hash) const {
+	if (capacity == 0)
+		return nullptr; // у перемещённой таблицы нет массивов
+
+	bool found;
+	int index = Probe(key, hash, found);
+
+	return found ? values + index : nullptr;
+}
+
+// хеш ключа с предварительной загрузкой начальной ячейки в кеш
+template <typename T, typename Hash>
+uint64_t StringTable<T, Hash>::PrefetchKey(const string& key) const {
+	uint64_t hash = KeyHash(key);
+
+	if (capacity > 0) // у перемещённой таблицы нет массивов
+		__builtin_prefetch(slots + Home(hash));
+
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename T, typename Hash>
+const T* StringTable<T, Hash>::FindHashed(const string& key, uint64_t hash) const {
+	return FindValue(key, hash);
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename T, typename Hash>
+pair<T*, bool> StringTable<T, Hash>::Emplace(string_view key, T value, bool assign) {
+	// у перемещённой таблицы массивы выделяются только при первой вставке
+	if (capacity == 0)
+		Allocate(1);
+
+	uint64_t hash = KeyHash(key);
+	bool found;
+	int index = Probe(key, hash, found);
+
+	if (found) {
+		if (assign)
+			values[index] = move(value); // обновляем значение на месте
+
+		return make_pair(values + index, false);
+	}
+
+	// если после вставки будет превышен коэффициент заполнения или не останется свободных ячеек, то расширяем таблицу
+	if (size + 1 > maxLoadFactor * capacity || size + 1 >= capacity) {
+		Rebuild(capacity * 2);
+		index = Probe(key, hash, found);
+	}
+
+	Slot& slot = slots[index];
+
+	// сначала записываются байты ключа: если арена не сможет вырасти, ячейка останется свободной и без созданного значения
+	if (key.length() <= INLINE_SIZE) {
+		memcpy(slot.bytes, key.data(), key.length());
+	}
+	else {
+		size_t offset = arena.size(); // длинный ключ дописывается в конец арены
+		arena.insert(arena.end(), key.begin(), key.end());
+		memcpy(slot.bytes, &offset, sizeof(offset));
+	}
+
+	slot.length = key.length();
+	new (values + index) T(move(value)); // значение создаётся последним
+	slot.hash = hash; // ячейка становится занятой
+	size++;
+
+	return make_pair(values + index, true);
+}
+
+// перестроение таблицы (ключи переносятся вместе с хешами и смещениями в арене, значения перемещаются)
+template <typename T, typename Hash>
+void StringTable<T, Hash>::Rebuild(int newCapacity) {
+	int prevCapacity = capacity;
+	Slot *prevSlots = slots;
+	T *prevValues = values;
+
+	Allocate(newCapacity); // выделяем память под новые массивы
+
+	for (int i = 0; i < prevCapacity; i++) {
+		if (prevSlots[i].hash == 0)
+			continue;
+
+		int index = Home(prevSlots[i].hash); // хеш не пересчитывается
+
+		while (slots[index].hash != 0)
+			index = (index + 1) & (capacity - 1);
+
+		slots[index] = prevSlots[i];
+		new (values + index) T(move(prevValues[i]));
+		prevValues[i].~T();
+	}
+
+	free(prevSlots);
+	free(prevValues);
+}
+
+// уплотнение арены (удаление ключей удалённых элементов)
+template <typename T, typename Hash>
+void StringTable<T, Hash>::Compact() {
+	vector<char> compacted;
+	compacted.reserve(arena.size() - garbage);
+
+	for (int i = 0; i < capacity; i++) {
+		if (slots[i].hash == 0 || slots[i].length <= INLINE_SIZE)
+			continue;
+
+		const char *data = KeyData(slots[i]);
+		size_t offset = compacted.size();
+
+		compacted.insert(compacted.end(), data, data + slots[i].length);
+		memcpy(slots[i].bytes, &offset, sizeof(offset));
+	}
+
+	arena.swap(compacted);
+	garbage = 0;
+}
+
+// добавление или замена значения по ключу
+template <typename T, typename Hash>
+void StringTable<T, Hash>::Insert(const string& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename T, typename Hash>
+bool StringTable<T, Hash>::Remove(const string& key) {
+	if (capacity == 0)
+		return false; // у перемещённой таблицы нет массивов
+
+	bool found;
+	int index = Probe(key, KeyHash(key), found);
+
+	if (!found)
+		return false; // не нашли, возвращаем ложь
+
+	values[index].~T();
+
+	if (slots[index].length > INLINE_SIZE)
+		garbage += slots[index].length; // байты ключа остаются в арене до уплотнения
+
+	int next = index; // индекс проверяемой ячейки кластера
+
+	// сдвигаем назад элементы кластера, пробная последовательность которых проходит через освободившуюся ячейку
+	while (true) {
+		next = (next + 1) & (capacity - 1); // переходим к следующей ячейке
+
+		if (slots[next].hash == 0)
+			break; // кластер закончился
+
+		int home = Home(slots[next].hash); // начальная ячейка пробной последовательности элемента
+
+		// если начальная ячейка лежит циклически в (index, next], то элемент остаётся на месте
+		if (index <= next ? (index < home && home <= next) : (index < home || home <= next))
+			continue;
+
+		// иначе сдвигаем элемент в освободившуюся ячейку
+		slots[index] = slots[next];
+		new (values + index) T(move(values[next]));
+		values[next].~T();
+		index = next;
+	}
+
+	slots[index].hash = 0; // последняя освободившаяся ячейка становится свободной
+	size--; // уменьшаем счётчик числа элементов
+
+	// если ключи удалённых элементов занимают больше половины арены, то уплотняем её
+	if (arena.size() >= MIN_COMPACT_SIZE && garbage * 2 > arena.size())
+		Compact();
+
+	return true;
+}
+
+// поиск по ключу
+template <typename T, typename Hash>
+bool StringTable<T, Hash>::Find(const string& key) const {
+	return FindValue(key) != nullptr;
+}
+
+template <typename T, typename Hash>
+void StringTable<T, Hash>::Clear() {
+	Release(); // вместо обхода ячеек массивы заменяются новыми обнулёнными
+
+	if (capacity > 0) // перемещённая таблица остаётся без памяти
+		Allocate(capacity);
+
+	arena.clear();
+	garbage = 0;
+	size = 0; // обнуляем счётчик числа элементов
+}
+
+template <typename T, typename Hash>
+int StringTable<T, Hash>::GetSize() const {
+	return size; // возвращаем размер
+}
+
+template <typename T, typename Hash>
+bool StringTable<T, Hash>::IsEmpty() const {
+	return size == 0; // таблица пуста, если нет элементов
+}
+
+// получение значения по ключу
+template <typename T, typename Hash>
+T StringTable<T, Hash>::Get(const string& key) const {
+	const T *value = FindValue(key);
+
+	if (value == nullptr)
+		throw string("No value with this key"); // бросаем исключение
+
+	return *value; // возвращаем значение
+}
+
+// указатель на значение по ключу (nullptr, если нет)
+template <typename T, typename Hash>
+T* StringTable<T, Hash>::FindPtr(const string& key) {
+	return const_cast<T*>(FindValue(key));
+}
+
+template <typename T, typename Hash>
+const T* StringTable<T, Hash>::FindPtr(const string& key) const {
+	return FindValue(key);
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename T, typename Hash>
+pair<T*, bool> StringTable<T, Hash>::TryEmplace(string key, T value) {
+	return Emplace(key, move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename T, typename Hash>
+pair<T*, bool> StringTable<T, Hash>::InsertOrAssign(string key, T value) {
+	return Emplace(key, move(value), true);
+}
+
+// объём арены длинных ключей (вместе с ещё не удалёнными уплотнением ключами)
+template <typename T, typename Hash>
+size_t StringTable<T, Hash>::GetArenaSize() const {
+	return arena.size();
+}
+
+// деструктор (освобождения памяти)
+template <typename T, typename Hash>
+StringTable<T, Hash>::~StringTable() {
+	Release(); // удаляем массивы
+}
+
+// уничтожение элементов и освобождение памяти
+template <typename T, typename Hash>
+void StringTable<T, Hash>::Release() {
+	// тривиально уничтожаемые значения не требуют обхода массива
+	if (!is_trivially_destructible<T>::value)
+		for (int i = 0; i < capacity; i++)
+			if (slots[i].hash != 0)
+				values[i].~T();
+
+	free(slots);
+	free(values);
+}
+
+// статистика заполнения и длин поиска
+template <typename T, typename Hash>
+TableStats StringTable<T, Hash>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.bytes = sizeof(*this) + capacity * (sizeof(Slot) + sizeof(T)) + arena.capacity();
+
+	StepProbes probes(capacity, 1, [this](int i) { return slots[i].hash == 0; });
+
+	for (int i = 0; i < capacity; i++) {
+		if (slots[i].hash != 0)
+			stats.AddHit(probes.Hit(Home(slots[i].hash), i));
+
+		stats.AddMiss(probes.Miss(i)); // неуспешный поиск, начинающийся в ячейке i
+	}
+
+	stats.AddClusters(capacity, [this](int i) { return slots[i].hash != 0; });
+	return stats;
+}
+
+// оператор вывода в поток
+template <typename T, typename Hash>
+void StringTable<T, Hash>::Print() const {
+	for (int i = 0; i < capacity; i++) {
+		if (slots[i].hash == 0)
+			continue; // если ячейка не занята, то переходим к следующему элементу
+
+		cout << "[" << i << "]: "; // выводим номер ячейки
+		cout << values[i] << "(" << string_view(KeyData(slots[i]), slots[i].length) << ") "; // выводим содержимое ячейки
+		cout << endl; // переходим на новую строку
+	}
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename T, typename Hash>
+void swap(StringTable<T, Hash>& table1, StringTable<T, Hash>& table2) {
+	table1.Swap(table2);
+}
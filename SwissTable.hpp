@@ -0,0 +1,632 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "HashTable.h"
+#include "HashFunctions.hpp"
+#include "CellStorage.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/*
+	Хеш таблица с групповым пробированием (swiss table)
+	Помимо массива элементов хранится массив однобайтовых управляющих меток:
+	состояние ячейки и 7 бит хеша элемента. Метки просматриваются группами
+	по 16 штук одной SSE2 инструкцией, а к ключам обращение происходит только
+	при совпадении метки. Ёмкость таблицы - степень двойки, группы
+	перебираются квадратичным пробированием
+	Массив ячеек не инициализируется: ключи и значения создаются только
+	в занятых ячейках, а свободными ячейки делает заполнение массива меток
+*/
+
+template <typename K, typename T, typename Hash = DefaultHash<K>, typename KeyEqual = equal_to<K>>
+class SwissTable final : public HashTable<K, T> {
+	static const signed char EMPTY = -128; // свободная ячейка (0b10000000)
+	static const signed char DELETED = -2; // удалённая ячейка (0b11111110)
+	static const int GROUP_SIZE = 16; // число меток в группе
+
+    // ключ и значение в объединениях создаются и уничтожаются явно, только пока ячейка занята
+    struct HashNode {
+    	union { K key; }; // значение ключа элемента
+    	union { T value; }; // значение элемента
+    };
+
+    // группа управляющих меток
+    struct Group {
+#ifdef __SSE2__
+    	__m128i tags; // загруженные метки группы
+
+    	Group(const signed char *ctrl) {
+    		tags = _mm_loadu_si128((const __m128i *) ctrl);
+    	}
+
+    	// маска ячеек с заданной меткой
+    	unsigned Match(signed char tag) const {
+    		return _mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(tag)));
+    	}
+
+    	// маска свободных и удалённых ячеек (метки со старшим битом)
+    	unsigned MatchEmptyOrDeleted() const {
+    		return _mm_movemask_epi8(tags);
+    	}
+#else
+    	const signed char *tags; // метки группы
+
+    	Group(const signed char *ctrl) {
+    		tags = ctrl;
+    	}
+
+    	// маска ячеек с заданной меткой
+    	unsigned Match(signed char tag) const {
+    		unsigned mask = 0;
+
+    		for (int i = 0; i < GROUP_SIZE; i++)
+    			if (tags[i] == tag)
+    				mask |= 1u << i;
+
+    		return mask;
+    	}
+
+    	// маска свободных и удалённых ячеек (метки со старшим битом)
+    	unsigned MatchEmptyOrDeleted() const {
+    		unsigned mask = 0;
+
+    		for (int i = 0; i < GROUP_SIZE; i++)
+    			if (tags[i] < 0)
+    				mask |= 1u << i;
+
+    		return mask;
+    	}
+#endif
+
+    	// маска свободных ячеек
+    	unsigned MatchEmpty() const {
+    		return Match(EMPTY);
+    	}
+    };
+
+    int capacity; // ёмкость таблицы
+    int size; // число элементов в таблице
+    int deleted; // число удалённых ячеек
+    double maxLoadFactor; // максимальный коэффициент заполнения
+
+    signed char *ctrl; // массив управляющих меток
+    HashNode *cells; // массив ячеек
+
+    Hash hasher; // хеш-функция
+    KeyEqual keyEqual; // сравнение ключей
+
+    template <typename Key>
+    uint64_t MixedHash(const Key& key) const; // перемешанное значение хеш-функции
+    template <typename Key>
+    int FindIndex(const Key& key) const; // поиск индекса ячейки с ключом (-1, если нет)
+    template <typename Key>
+    int FindIndex(const Key& key, uint64_t hash) const; // поиск индекса ячейки с ключом по перемешанному хешу (-1, если нет)
+    uint64_t PrefetchKey(const K& key) const; // хеш ключа с предварительной загрузкой начальной группы в кеш
+    const T* FindHashed(const K& key, uint64_t hash) const; // поиск значения по ключу с вычисленным хешем
+    int FindSlot(const K& key, uint64_t hash, bool& found) const; // поиск ячейки с ключом или первой незанятой ячейки для его вставки (-1, если нет)
+    template <typename KeyArg, typename ValueArg>
+    void Store(int index, uint64_t hash, KeyArg&& key, ValueArg&& value); // запись элемента в незанятую ячейку
+    template <typename KeyArg, typename ValueArg>
+    int Place(KeyArg&& key, ValueArg&& value); // запись элемента в первую незанятую ячейку (индекс ячейки)
+    template <typename KeyArg, typename ValueArg>
+    pair<T*, bool> Emplace(KeyArg&& key, ValueArg&& value, bool assign); // вставка или обновление элемента (указатель на значение и признак вставки)
+    void Allocate(int tableSize); // выделение памяти под метки и ячейки
+    void Rebuild(int newCapacity); // перестроение таблицы
+    void Release(); // уничтожение элементов и освобождение памяти
+    int ProbeLength(int group, int target) const; // число групп, просматриваемых поиском от начальной до целевой (или до группы со свободной ячейкой при target = -1)
+
+public:
+    SwissTable(int tableSize, const Hash& hasher = Hash(), double maxLoadFactor = 0.875, const KeyEqual& keyEqual = KeyEqual()); // конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+    SwissTable(int tableSize, int (*h)(K), double maxLoadFactor = 0.875); // конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+    SwissTable(const SwissTable& table); // конструктор копирования
+    SwissTable(SwissTable&& table) noexcept; // конструктор перемещения (перемещённая таблица остаётся пустой и без памяти)
+    SwissTable& operator=(SwissTable table); // присваивание копированием или перемещением (copy-and-swap)
+    void Swap(SwissTable& table) noexcept; // обмен содержимым таблиц за O(1)
+
+    void Insert(const K& key, const T& value); // добавление или замена значения по ключу
+    bool Remove(const K& key); // удаление по ключу
+    bool Find(const K& key) const; // поиск по ключу
+
+    void Clear(); // очистка таблицы
+
+    int GetSize() const; // получение размера
+    bool IsEmpty() const; // проверка на пустоту
+
+    T Get(const K& key) const; // получение значения по ключу
+
+    T* FindPtr(const K& key); // указатель на значение по ключу (nullptr, если нет)
+    const T* FindPtr(const K& key) const;
+
+    pair<T*, bool> TryEmplace(K key, T value); // добавление, если ключа нет
+    pair<T*, bool> InsertOrAssign(K key, T value); // добавление или замена значения по ключу
+
+    // поиск по ключу другого типа при прозрачных хеш-функции и сравнении ключей
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    T* FindPtr(const Key& key) { int index = FindIndex(key); return index == -1 ? nullptr : &cells[index].value; }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    const T* FindPtr(const Key& key) const { int index = FindIndex(key); return index == -1 ? nullptr : &cells[index].value; }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual, typename = TransparentLookup<H, E>>
+    bool Find(const Key& key) const { return FindIndex(key) != -1; }
+
+    TableStats GetStats() const; // статистика заполнения и длин поиска
+
+    void Print() const; // вывод таблицы
+
+    ~SwissTable(); // деструктор (освобождение памяти)
+};
+
+// конструктор из размера, хеш-функции, коэффициента заполнения и сравнения ключей
+template <typename K, typename T, typename Hash, typename KeyEqual>
+SwissTable<K, T, Hash, KeyEqual>::SwissTable(int tableSize, const Hash& hasher, double maxLoadFactor, const KeyEqual& keyEqual) : hasher(hasher), keyEqual(keyEqual) {
+	this->maxLoadFactor = maxLoadFactor;
+
+	Allocate(tableSize); // выделяем память под метки и ячейки
+}
+
+// конструктор из размера, указателя на хеш-функцию и коэффициента заполнения
+template <typename K, typename T, typename Hash, typename KeyEqual>
+SwissTable<K, T, Hash, KeyEqual>::SwissTable(int tableSize, int (*h)(K), double maxLoadFactor) : SwissTable(tableSize, Hash(h), maxLoadFactor) {
+}
+
+// конструктор копирования
+template <typename K, typename T, typename Hash, typename KeyEqual>
+SwissTable<K, T, Hash, KeyEqual>::SwissTable(const SwissTable& table) : hasher(table.hasher), keyEqual(table.keyEqual) {
+	maxLoadFactor = table.maxLoadFactor; // копируем коэффициент заполнения
+
+	// у перемещённой таблицы массивов нет, поэтому нет их и у копии
+	if (table.capacity == 0) {
+		capacity = 0;
+		size = 0;
+		deleted = 0;
+		ctrl = nullptr;
+		cells = nullptr;
+		return;
+	}
+
+	Allocate(table.capacity); // выделяем память под массивы
+
+	size = table.size; // копируем количество элементов
+	deleted = table.deleted; // копируем количество удалённых ячеек
+
+	// проходимся по всем ячейкам таблицы и копируем их содержимое
+	for (int i = 0; i < capacity; i++) {
+		ctrl[i] = table.ctrl[i];
+
+		if (ctrl[i] >= 0) {
+			new (&cells[i].key) K(table.cells[i].key);
+			new (&cells[i].value) T(table.cells[i].value);
+		}
+	}
+}
+
+// конструктор перемещения: таблица забирает массивы, а перемещённой остаётся нулевая ёмкость без выделенной памяти
+// (при нулевом числе групп поиск ничего не находит, а первая вставка перестраивает таблицу)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+SwissTable<K, T, Hash, KeyEqual>::SwissTable(SwissTable&& table) noexcept : hasher(table.hasher), keyEqual(table.keyEqual) {
+	capacity = 0;
+	size = 0;
+	deleted = 0;
+	maxLoadFactor = table.maxLoadFactor;
+	ctrl = nullptr;
+	cells = nullptr;
+
+	Swap(table);
+}
+
+// присваивание копированием или перемещением: параметр уже скопирован или перемещён, остаётся обменяться с ним
+template <typename K, typename T, typename Hash, typename KeyEqual>
+SwissTable<K, T, Hash, KeyEqual>& SwissTable<K, T, Hash, KeyEqual>::operator=(SwissTable table) {
+	Swap(table);
+	return *this;
+}
+
+// обмен содержимым таблиц за O(1)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void SwissTable<K, T, Hash, KeyEqual>::Swap(SwissTable& table) noexcept {
+	swap(capacity, table.capacity);
+	swap(size, table.size);
+	swap(deleted, table.deleted);
+	swap(maxLoadFactor, table.maxLoadFactor);
+	swap(ctrl, table.ctrl);
+	swap(cells, table.cells);
+	swap(hasher, table.hasher);
+	swap(keyEqual, table.keyEqual);
+}
+
+// перемешанное значение хеш-функции
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+uint64_t SwissTable<K, T, Hash, KeyEqual>::MixedHash(const Key& key) const {
+	// перемешиваем биты, чтобы и метка, и номер группы зависели от всех битов хеша
+	return MixHash(hasher(key));
+}
+
+// выделение памяти под метки и ячейки
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void SwissTable<K, T, Hash, KeyEqual>::Allocate(int tableSize) {
+	capacity = GROUP_SIZE; // ёмкость - степень двойки, не меньшая размера группы
+
+	while (capacity < tableSize)
+		capacity *= 2;
+
+	size = 0; // изначально нет элементов
+	deleted = 0; // и нет удалённых ячеек
+
+	ctrl = new signed char[capacity]; // выделяем память под метки
+	cells = static_cast<HashNode*>(AllocateZeroed(capacity, sizeof(HashNode))); // выделяем память под ячейки, не создавая элементов
+
+	memset(ctrl, EMPTY, capacity); // делаем все ячейки свободными
+}
+
+// поиск индекса ячейки с ключом (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+int SwissTable<K, T, Hash, KeyEqual>::FindIndex(const Key& key) const {
+	return FindIndex(key, MixedHash(key));
+}
+
+// поиск индекса ячейки с ключом по перемешанному хешу (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename Key>
+int SwissTable<K, T, Hash, KeyEqual>::FindIndex(const Key& key, uint64_t hash) const {
+	signed char tag = hash & 0x7F; // метка элемента
+	int groups = capacity / GROUP_SIZE; // число групп
+	int group = (hash >> 7) & (groups - 1); // начальная группа
+
+	for (int probe = 0; probe < groups; probe++) {
+		Group tags(ctrl + group * GROUP_SIZE);
+
+		// проверяем ключи только в ячейках с совпавшей меткой
+		for (unsigned mask = tags.Match(tag); mask; mask &= mask - 1) {
+			int index = group * GROUP_SIZE + __builtin_ctz(mask);
+
+			if (keyEqual(cells[index].key, key))
+				return index; // нашли элемент
+		}
+
+		// если в группе есть свободная ячейка, то дальше элемента быть не может
+		if (tags.MatchEmpty())
+			return -1;
+
+		group = (group + probe + 1) & (groups - 1); // переходим к следующей группе
+	}
+
+	return -1; // не нашли во всей таблице
+}
+
+// хеш ключа с предварительной загрузкой начальной группы в кеш
+template <typename K, typename T, typename Hash, typename KeyEqual>
+uint64_t SwissTable<K, T, Hash, KeyEqual>::PrefetchKey(const K& key) const {
+	uint64_t hash = MixedHash(key);
+
+	// у перемещённой таблицы нет массивов
+	if (capacity > 0) {
+		int group = (hash >> 7) & (capacity / GROUP_SIZE - 1); // начальная группа
+
+		__builtin_prefetch(ctrl + group * GROUP_SIZE);
+		__builtin_prefetch(cells + group * GROUP_SIZE);
+	}
+
+	return hash;
+}
+
+// поиск значения по ключу с вычисленным хешем
+template <typename K, typename T, typename Hash, typename KeyEqual>
+const T* SwissTable<K, T, Hash, KeyEqual>::FindHashed(const K& key, uint64_t hash) const {
+	int index = FindIndex(key, hash);
+
+	return index == -1 ? nullptr : &cells[index].value;
+}
+
+// поиск ячейки с ключом или первой незанятой ячейки для его вставки (-1, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int SwissTable<K, T, Hash, KeyEqual>::FindSlot(const K& key, uint64_t hash, bool& found) const {
+	signed char tag = hash & 0x7F; // метка элемента
+	int groups = capacity / GROUP_SIZE; // число групп
+	int group = (hash >> 7) & (groups - 1); // начальная группа
+	int slot = -1; // первая незанятая ячейка пробной последовательности
+
+	found = false;
+
+	for (int probe = 0; probe < groups; probe++) {
+		Group tags(ctrl + group * GROUP_SIZE);
+
+		// проверяем ключи только в ячейках с совпавшей меткой
+		for (unsigned mask = tags.Match(tag); mask; mask &= mask - 1) {
+			int index = group * GROUP_SIZE + __builtin_ctz(mask);
+
+			if (keyEqual(cells[index].key, key)) {
+				found = true;
+				return index; // нашли элемент
+			}
+		}
+
+		// запоминаем первую свободную или удалённую ячейку
+		unsigned free = tags.MatchEmptyOrDeleted();
+
+		if (slot == -1 && free)
+			slot = group * GROUP_SIZE + __builtin_ctz(free);
+
+		// если в группе есть свободная ячейка, то дальше элемента быть не может
+		if (tags.MatchEmpty())
+			return slot;
+
+		group = (group + probe + 1) & (groups - 1); // переходим к следующей группе
+	}
+
+	return slot; // прошли все группы
+}
+
+// запись элемента в незанятую ячейку
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename KeyArg, typename ValueArg>
+void SwissTable<K, T, Hash, KeyEqual>::Store(int index, uint64_t hash, KeyArg&& key, ValueArg&& value) {
+	if (ctrl[index] == DELETED)
+		deleted--; // удалённая ячейка используется повторно
+
+	new (&cells[index].key) K(forward<KeyArg>(key)); // создаём ключ
+	new (&cells[index].value) T(forward<ValueArg>(value)); // и значение
+	ctrl[index] = hash & 0x7F; // сохраняем метку
+
+	size++; // увеличиваем счётчик числа элементов
+}
+
+// запись элемента в первую незанятую ячейку (индекс ячейки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename KeyArg, typename ValueArg>
+int SwissTable<K, T, Hash, KeyEqual>::Place(KeyArg&& key, ValueArg&& value) {
+	uint64_t hash = MixedHash(key);
+	int groups = capacity / GROUP_SIZE; // число групп
+	int group = (hash >> 7) & (groups - 1); // начальная группа
+
+	for (int probe = 0; probe < groups; probe++) {
+		unsigned mask = Group(ctrl + group * GROUP_SIZE).MatchEmptyOrDeleted();
+
+		// если в группе есть незанятая ячейка
+		if (mask) {
+			int index = group * GROUP_SIZE + __builtin_ctz(mask);
+
+			Store(index, hash, forward<KeyArg>(key), forward<ValueArg>(value));
+			return index;
+		}
+
+		group = (group + probe + 1) & (groups - 1); // переходим к следующей группе
+	}
+
+	return -1; // незанятых ячеек нет (не происходит: таблица расширяется заранее)
+}
+
+// перестроение таблицы
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void SwissTable<K, T, Hash, KeyEqual>::Rebuild(int newCapacity) {
+	signed char *prevCtrl = ctrl; // запоминаем текущие массивы
+	HashNode *prevCells = cells;
+	int prevCapacity = capacity;
+
+	Allocate(newCapacity); // выделяем память под новые массивы
+
+	// перемещаем занятые ячейки, удалённые при этом пропадают
+	for (int i = 0; i < prevCapacity; i++) {
+		if (prevCtrl[i] >= 0) {
+			Place(move(prevCells[i].key), move(prevCells[i].value));
+			prevCells[i].key.~K();
+			prevCells[i].value.~T();
+		}
+	}
+
+	delete[] prevCtrl;
+	free(prevCells);
+}
+
+// вставка или обновление элемента (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+template <typename KeyArg, typename ValueArg>
+pair<T*, bool> SwissTable<K, T, Hash, KeyEqual>::Emplace(KeyArg&& key, ValueArg&& value, bool assign) {
+	uint64_t hash = MixedHash(key);
+	bool found;
+	int index = FindSlot(key, hash, found); // за один проход ищем ключ и запоминаем место для вставки
+
+	if (found) {
+		if (assign)
+			cells[index].value = forward<ValueArg>(value); // обновляем значение на месте
+
+		return make_pair(&cells[index].value, false);
+	}
+
+	bool overflow = size + deleted + 1 > maxLoadFactor * capacity || size + deleted + 1 >= capacity;
+
+	// удалённая ячейка используется повторно без расширения, свободная - если не будет превышен коэффициент заполнения
+	if (index != -1 && (ctrl[index] == DELETED || !overflow)) {
+		Store(index, hash, forward<KeyArg>(key), forward<ValueArg>(value));
+	}
+	else {
+		// если ячейки заняты в основном удалёнными элементами, то достаточно избавиться от них
+		Rebuild(size * 2 > maxLoadFactor * capacity ? capacity * 2 : capacity);
+		index = Place(forward<KeyArg>(key), forward<ValueArg>(value));
+	}
+
+	return make_pair(&cells[index].value, true);
+}
+
+// добавление или замена значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void SwissTable<K, T, Hash, KeyEqual>::Insert(const K& key, const T& value) {
+	Emplace(key, value, true);
+}
+
+// удаление по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool SwissTable<K, T, Hash, KeyEqual>::Remove(const K& key) {
+	int index = FindIndex(key);
+
+	if (index == -1)
+		return false; // не нашли, возвращаем ложь
+
+	cells[index].key.~K(); // уничтожаем элемент
+	cells[index].value.~T();
+
+	// если в группе есть свободная ячейка, то поиск через неё не проходил и ячейку можно сделать свободной
+	if (Group(ctrl + index / GROUP_SIZE * GROUP_SIZE).MatchEmpty()) {
+		ctrl[index] = EMPTY;
+	}
+	else {
+		ctrl[index] = DELETED; // иначе помечаем её как удалённую
+		deleted++;
+	}
+
+	size--; // уменьшаем счётчик числа элементов
+	return true; // возвращаем истину
+}
+
+// поиск по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool SwissTable<K, T, Hash, KeyEqual>::Find(const K& key) const {
+	return FindIndex(key) != -1;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void SwissTable<K, T, Hash, KeyEqual>::Clear() {
+	Release(); // массив ячеек заменяется новым, а не обходится
+
+	// у перемещённой таблицы массивов нет, и она остаётся без памяти
+	if (capacity > 0)
+		Allocate(capacity); // счётчики элементов и удалённых ячеек обнуляются
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int SwissTable<K, T, Hash, KeyEqual>::GetSize() const {
+	return size; // возвращаем размер
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+bool SwissTable<K, T, Hash, KeyEqual>::IsEmpty() const {
+	return size == 0; // таблица пуста, если нет элементов
+}
+
+// получение значения по ключу
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T SwissTable<K, T, Hash, KeyEqual>::Get(const K& key) const {
+	int index = FindIndex(key);
+
+	if (index == -1)
+		throw string("No value with this key"); // бросаем исключение
+
+	return cells[index].value; // возвращаем значение
+}
+
+// указатель на значение по ключу (nullptr, если нет)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+T* SwissTable<K, T, Hash, KeyEqual>::FindPtr(const K& key) {
+	int index = FindIndex(key);
+
+	return index == -1 ? nullptr : &cells[index].value;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual>
+const T* SwissTable<K, T, Hash, KeyEqual>::FindPtr(const K& key) const {
+	int index = FindIndex(key);
+
+	return index == -1 ? nullptr : &cells[index].value;
+}
+
+// добавление, если ключа нет (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> SwissTable<K, T, Hash, KeyEqual>::TryEmplace(K key, T value) {
+	return Emplace(move(key), move(value), false);
+}
+
+// добавление или замена значения по ключу (указатель на значение и признак вставки)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+pair<T*, bool> SwissTable<K, T, Hash, KeyEqual>::InsertOrAssign(K key, T value) {
+	return Emplace(move(key), move(value), true);
+}
+
+// деструктор (освобождения памяти)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+SwissTable<K, T, Hash, KeyEqual>::~SwissTable() {
+	Release(); // удаляем массивы меток и ячеек
+}
+
+// уничтожение элементов и освобождение памяти
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void SwissTable<K, T, Hash, KeyEqual>::Release() {
+	// тривиально уничтожаемые элементы не требуют обхода массива
+	if (!is_trivially_destructible<K>::value || !is_trivially_destructible<T>::value) {
+		for (int i = 0; i < capacity; i++) {
+			if (ctrl[i] >= 0) {
+				cells[i].key.~K();
+				cells[i].value.~T();
+			}
+		}
+	}
+
+	delete[] ctrl;
+	free(cells);
+}
+
+// число групп, просматриваемых поиском от начальной до целевой (или до группы со свободной ячейкой при target = -1)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+int SwissTable<K, T, Hash, KeyEqual>::ProbeLength(int group, int target) const {
+	int groups = capacity / GROUP_SIZE; // число групп
+
+	for (int probe = 0; probe < groups; probe++) {
+		if (group == target || Group(ctrl + group * GROUP_SIZE).MatchEmpty())
+			return probe + 1;
+
+		group = (group + probe + 1) & (groups - 1);
+	}
+
+	return groups;
+}
+
+// статистика заполнения и длин поиска
+template <typename K, typename T, typename Hash, typename KeyEqual>
+TableStats SwissTable<K, T, Hash, KeyEqual>::GetStats() const {
+	TableStats stats;
+	stats.size = size;
+	stats.capacity = capacity;
+	stats.bytes = sizeof(*this) + capacity * (sizeof(HashNode) + 1); // ячейки и метки
+	stats.tombstones = deleted;
+
+	int groups = capacity / GROUP_SIZE; // число групп
+
+	for (int i = 0; i < capacity; i++)
+		if (ctrl[i] >= 0)
+			stats.AddHit(ProbeLength((MixedHash(cells[i].key) >> 7) & (groups - 1), i / GROUP_SIZE));
+
+	// неуспешный поиск начинается с группы, поэтому считается для каждой группы
+	for (int group = 0; group < groups; group++)
+		stats.AddMiss(ProbeLength(group, -1));
+
+	stats.AddClusters(capacity, [this](int i) { return ctrl[i] != EMPTY; });
+	return stats;
+}
+
+// оператор вывода в поток
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void SwissTable<K, T, Hash, KeyEqual>::Print() const {
+    for (int i = 0; i < capacity; i++) {
+		if (ctrl[i] < 0)
+			continue; // если ячейка не занята, то переходим к следующему элементу
+
+		cout << "[" << i << "]: "; // выводим номер ячейки
+		cout << cells[i].value << "(" << cells[i].key << ") "; // выводим содержимое ячейки
+		cout << endl; // переходим на новую строку
+	}
+}
+
+// обмен содержимым таблиц (для swap(a, b) и стандартных алгоритмов)
+template <typename K, typename T, typename Hash, typename KeyEqual>
+void swap(SwissTable<K, T, Hash, KeyEqual>& table1, SwissTable<K, T, Hash, KeyEqual>& table2) {
+	table1.Swap(table2);
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+
+/*
+	Статистика заполнения хеш-таблицы
+	Собирается по требованию обходом ячеек таблицы (GetStats), поэтому операции
+	таблицы не ведут никаких счётчиков и не замедляются, пока статистика не запрошена
+	Длина поиска - число просмотренных ячеек (для таблиц с цепочками - элементов
+	цепочки, для таблиц с корзинами из звеньев - звеньев, для швейцарской таблицы -
+	групп, для кукушкиной таблицы - корзин и запаса): для присутствующих ключей
+	считается по каждому ключу, для отсутствующих - по каждой начальной ячейке
+	(корзине, группе)
+	Статистика собирается за время, линейное по ёмкости: при пробировании с
+	постоянным шагом длины поиска вычисляются одним обратным проходом (StepProbes),
+	а при квадратичном и двойном хешировании неуспешный поиск запускается из
+	выборки начальных ячеек с ограниченной суммарной длиной (AddSampledMisses)
+*/
+
+struct TableStats {
+	int size = 0; // число элементов
+	int capacity = 0; // число ячеек (для таблиц с цепочками - корзин)
+	int tombstones = 0; // число удалённых ячеек, ещё занимающих место
+	bool migrating = false; // выполняется постепенный перенос элементов из старого массива
+	size_t bytes = 0; // память массивов и узлов таблицы (без памяти, на которую ссылаются сами ключи и значения)
+
+	long long hitProbes = 0; // суммарная длина поиска присутствующих ключей
+	int hits = 0; // число присутствующих ключей, по которым считалась длина поиска
+	int maxHitProbe = 0; // максимальная длина поиска присутствующего ключа
+
+	long long missProbes = 0; // суммарная длина поиска отсутствующих ключей
+	int misses = 0; // число начальных ячеек, по которым считалась длина неуспешного поиска
+	int maxMissProbe = 0; // максимальная длина неуспешного поиска
+
+	std::vector<int> clusterSizes; // clusterSizes[k] - число кластеров (непрерывных серий занятых и удалённых ячеек) длины k
+	std::vector<int> chainLengths; // chainLengths[k] - число корзин с цепочкой длины k
+
+	double LoadFactor() const { return capacity ? (double) size / capacity : 0; } // коэффициент заполнения
+	double BytesPerEntry() const { return size ? (double) bytes / size : 0; } // память на один элемент
+	double AverageHitProbe() const { return hits ? (double) hitProbes / hits : 0; } // средняя длина успешного поиска
+	double AverageMissProbe() const { return misses ? (double) missProbes / misses : 0; } // средняя длина неуспешного поиска
+
+	// учёт длины успешного поиска
+	void AddHit(int probes) {
+		hitProbes += probes;
+		hits++;
+		maxHitProbe = std::max(maxHitProbe, probes);
+	}
+
+	// учёт длины неуспешного поиска
+	void AddMiss(int probes) {
+		missProbes += probes;
+		misses++;
+		maxMissProbe = std::max(maxMissProbe, probes);
+	}
+
+	// учёт цепочки заданной длины
+	void AddChain(int length) {
+		AddToHistogram(chainLengths, length);
+	}
+
+	// учёт кластеров кольцевого массива: occupied(i) - занята ли ячейка (в том числе удалённым элементом)
+	template <typename Occupied>
+	void AddClusters(int length, Occupied occupied) {
+		int start = 0; // обход начинается после свободной ячейки, чтобы не разрезать кластер на границе массива
+
+		while (start < length && occupied(start))
+			start++;
+
+		if (start == length) {
+			if (length > 0)
+				AddToHistogram(clusterSizes, length); // свободных ячеек нет - весь массив один кластер
+
+			return;
+		}
+
+		int cluster = 0;
+
+		for (int i = 1; i <= length; i++) {
+			if (occupied((start + i) % length)) {
+				cluster++;
+			}
+			else if (cluster > 0) {
+				AddToHistogram(clusterSizes, cluster);
+				cluster = 0;
+			}
+		}
+	}
+
+	// учёт длин неуспешного поиска по выборке начальных ячеек (probe(i) - длина поиска из ячейки i):
+	// ячейки перебираются с шагом, взаимно простым с length, пока суммарная длина не превысит MISS_BUDGET * length,
+	// поэтому при коротких поисках просматриваются все ячейки, а при длинных - равномерно разбросанная их часть
+	template <typename Probe>
+	void AddSampledMisses(int length, Probe probe) {
+		const int MISS_BUDGET = 8; // наибольшая суммарная длина поиска на одну ячейку
+
+		int stride = std::max(1, (int) (length * 0.6180339887)); // шаг перебора, близкий к золотому сечению
+
+		while (std::gcd(stride, length) != 1)
+			stride++;
+
+		long long spent = 0;
+		int index = 0;
+
+		for (int i = 0; i < length && spent < (long long) MISS_BUDGET * length; i++) {
+			int probes = probe(index);
+
+			AddMiss(probes);
+			spent += probes;
+			index = (index + (int64_t) stride) % length;
+		}
+	}
+
+	// объединение статистики нескольких таблиц
+	TableStats& operator+=(const TableStats& stats) {
+		size += stats.size;
+		capacity += stats.capacity;
+		tombstones += stats.tombstones;
+		migrating = migrating || stats.migrating;
+		bytes += stats.bytes;
+
+		hitProbes += stats.hitProbes;
+		hits += stats.hits;
+		maxHitProbe = std::max(maxHitProbe, stats.maxHitProbe);
+
+		missProbes += stats.missProbes;
+		misses += stats.misses;
+		maxMissProbe = std::max(maxMissProbe, stats.maxMissProbe);
+
+		for (size_t i = 0; i < stats.clusterSizes.size(); i++)
+			AddToHistogram(clusterSizes, i, stats.clusterSizes[i]);
+
+		for (size_t i = 0; i < stats.chainLengths.size(); i++)
+			AddToHistogram(chainLengths, i, stats.chainLengths[i]);
+
+		return *this;
+	}
+
+	// вывод статистики
+	void Print(std::ostream& os = std::cout) const {
+		os << "size: " << size << ", capacity: " << capacity << ", load factor: " << LoadFactor() << ", tombstones: " << tombstones << (migrating ? " (migrating)" : "") << std::endl;
+		os << "memory: " << bytes << " bytes, " << BytesPerEntry() << " bytes per entry" << std::endl;
+		os << "hit probes: average " << AverageHitProbe() << ", max " << maxHitProbe << std::endl;
+		os << "miss probes: average " << AverageMissProbe() << ", max " << maxMissProbe << std::endl;
+
+		PrintHistogram(os, "cluster sizes", clusterSizes);
+		PrintHistogram(os, "chain lengths", chainLengths);
+	}
+
+private:
+	// увеличение числа значений value в гистограмме
+	static void AddToHistogram(std::vector<int>& histogram, int value, int count = 1) {
+		if ((int) histogram.size() <= value)
+			histogram.resize(value + 1);
+
+		histogram[value] += count;
+	}
+
+	// вывод ненулевых значений гистограммы
+	static void PrintHistogram(std::ostream& os, const char *name, const std::vector<int>& histogram) {
+		if (histogram.empty())
+			return;
+
+		os << name << ":";
+
+		for (size_t i = 0; i < histogram.size(); i++)
+			if (histogram[i])
+				os << " " << i << "x" << histogram[i];
+
+		os << std::endl;
+	}
+};
+
+// длины поиска в кольцевом массиве с постоянным шагом step (линейное пробирование)
+// Шаг разбивает массив на циклы длины length / gcd(step, length): длины неуспешного
+// поиска вычисляются одним обратным проходом по каждому циклу от свободной ячейки,
+// а длина успешного поиска - по числу шагов между ячейками, поэтому вся статистика
+// собирается за O(length), а не поиском из каждой ячейки
+class StepProbes {
+    int length; // число ячеек массива
+    int step; // шаг пробирования внутри массива
+    int cycle; // длина цикла шага
+    int64_t inverse; // обратный к step / gcd элемент по модулю cycle (число шагов по смещению)
+    std::vector<int> misses; // misses[i] - число ячеек, просматриваемых от ячейки i до свободной включительно
+
+    // обратный к a элемент по модулю m (a и m взаимно просты)
+    static int64_t Inverse(int64_t a, int64_t m) {
+    	int64_t r0 = m, r1 = a % m, t0 = 0, t1 = 1;
+
+    	while (r1 != 0) {
+    		int64_t quotient = r0 / r1;
+    		int64_t r = r0 - quotient * r1;
+    		int64_t t = t0 - quotient * t1;
+
+    		r0 = r1;
+    		r1 = r;
+    		t0 = t1;
+    		t1 = t;
+    	}
+
+    	return t0 < 0 ? t0 + m : t0;
+    }
+
+public:
+    // isFree(i) - свободна ли ячейка i (поиск на ней останавливается)
+    template <typename IsFree>
+    StepProbes(int length, int step, IsFree isFree) : length(length), step(length > 0 ? step % length : 0), cycle(0), inverse(0), misses(length) {
+    	if (length == 0)
+    		return; // у перемещённой таблицы нет массива
+
+    	int gcd = std::gcd(this->step, length); // при нулевом шаге каждая ячейка - отдельный цикл
+    	cycle = length / gcd;
+    	inverse = Inverse(this->step / gcd, cycle);
+
+    	for (int start = 0; start < gcd; start++) {
+    		int free = -1; // свободная ячейка цикла
+    		int index = start;
+
+    		for (int k = 0; k < cycle && free == -1; k++) {
+    			if (isFree(index))
+    				free = index;
+
+    			index = Next(index);
+    		}
+
+    		// без свободных ячеек поиск останавливается, просмотрев length ячеек
+    		if (free == -1) {
+    			for (int k = 0; k < cycle; k++, index = Next(index))
+    				misses[index] = length;
+
+    			continue;
+    		}
+
+    		// от свободной ячейки идём против шага: длина поиска растёт на единицу до следующей свободной ячейки
+    		int probes = 0;
+    		index = free;
+
+    		for (int k = 0; k < cycle; k++) {
+    			probes = isFree(index) ? 1 : probes + 1;
+    			misses[index] = probes;
+
+    			index -= this->step;
+    			if (index < 0)
+    				index += length;
+    		}
+    	}
+    }
+
+    int Next(int index) const { return index + step >= length ? index + step - length : index + step; } // следующая ячейка пробной последовательности
+
+    int Miss(int index) const { return misses[index]; } // длина неуспешного поиска из ячейки index
+
+    // число ячеек, просматриваемых поиском от ячейки from до ячейки to того же цикла (свободных ячеек между ними нет)
+    int Hit(int from, int to) const {
+    	int gcd = length / cycle;
+    	int64_t offset = to - from < 0 ? to - from + length : to - from; // смещение делится на gcd
+
+    	return (offset / gcd) * inverse % cycle + 1;
+    }
+};
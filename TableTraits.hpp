@@ -0,0 +1,38 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+/*
+	Статический интерфейс хеш-таблицы
+	Конкретные таблицы объявлены final, поэтому вызовы через конкретный тип
+	(а не через указатель на HashTable) разрешаются на этапе компиляции и
+	встраиваются. Шаблонный код, принимающий любую таблицу, проверяет её
+	интерфейс признаком IsHashTable (или концептом HashTableType, если
+	компилятор поддерживает концепты), а HashTable остаётся тонкой обёрткой
+	со стиранием типа для выбора таблицы во время выполнения
+*/
+
+// проверка, что тип предоставляет основные операции хеш-таблицы с ключами K и значениями T
+template <typename Table, typename K, typename T, typename = void>
+struct IsHashTable : std::false_type {};
+
+template <typename Table, typename K, typename T>
+struct IsHashTable<Table, K, T, std::void_t<
+	decltype(std::declval<Table&>().Insert(std::declval<const K&>(), std::declval<const T&>())),
+	decltype(bool(std::declval<Table&>().Remove(std::declval<const K&>()))),
+	decltype(bool(std::declval<const Table&>().Find(std::declval<const K&>()))),
+	decltype(T(std::declval<const Table&>().Get(std::declval<const K&>()))),
+	decltype(bool(std::declval<const Table&>().TryGet(std::declval<const K&>(), std::declval<T&>()))),
+	decltype(int(std::declval<const Table&>().GetSize())),
+	decltype(bool(std::declval<const Table&>().IsEmpty())),
+	decltype(std::declval<Table&>().Clear())
+>> : std::true_type {};
+
+template <typename Table, typename K, typename T>
+constexpr bool IsHashTableV = IsHashTable<Table, K, T>::value;
+
+#ifdef __cpp_concepts
+template <typename Table, typename K, typename T>
+concept HashTableType = IsHashTableV<Table, K, T>;
+#endif
@@ -0,0 +1,185 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#include "Benchmark.hpp"
+#include "SeparateChainingTable.hpp"
+#include "BucketChainingTable.hpp"
+#include "LinearProbingTable.hpp"
+#include "QuadraticProbingTable.hpp"
+#include "DoubleHashingTable.hpp"
+#include "RobinHoodTable.hpp"
+#include "SwissTable.hpp"
+#include "CuckooTable.hpp"
+#include "HopscotchTable.hpp"
+#include "IntegerTable.hpp"
+#include "StringTable.hpp"
+
+/*
+	Замеры добавления, успешного и неуспешного поиска для всех таблиц при разных
+	распределениях ключей и коэффициентах заполнения. Таблицы создаются с ёмкостью
+	--size и максимальным коэффициентом заполнения 0.99, поэтому при замере не
+	перестраиваются, а коэффициент заполнения задаётся числом добавляемых ключей
+	Для каждой таблицы выводится и память на один элемент после добавления ключей
+	Запуск: bench [--quick] [--warmup N] [--trials N] [--size N] [--filter name] [--csv file] [--json file]
+*/
+
+const double maxLoadFactor = 0.99;
+
+// ключи таблицы из целых ключей набора
+void ConvertKeys(const vector<int> &keys, vector<int> &converted) {
+	converted = keys;
+}
+
+void ConvertKeys(const vector<int> &keys, vector<string> &converted) {
+	converted.clear();
+
+	for (int key : keys)
+		converted.push_back("session:" + to_string(key)); // ключи длиной от 9 до 18 символов, часть не помещается во встроенный буфер строки
+}
+
+// замер одной таблицы при заданном распределении и коэффициенте заполнения
+template <typename K, typename Table, typename Create>
+void RunCase(BenchmarkReport &report, const BenchmarkOptions &options, const string &name, const string &keyType, KeyDistribution distribution, double loadFactor, Create create) {
+	int count = max(1, (int) (options.tableSize * loadFactor));
+	int queries = max(count, 1 << 16);
+	KeySet keys = GenerateKeys(distribution, count, queries, 1000003u * count + (unsigned int) distribution);
+
+	vector<K> present, hits, misses;
+	ConvertKeys(keys.present, present);
+	ConvertKeys(keys.hits, hits);
+	ConvertKeys(keys.misses, misses);
+
+	BlockTimer insertTimer, hitTimer, missTimer;
+	double bytesPerEntry = 0;
+
+	for (int trial = 0; trial < options.warmup + options.trials; trial++) {
+		bool measured = trial >= options.warmup;
+		BlockTimer warmupTimer;
+		int found = 0;
+
+		FlushCache();
+		Table *table = create(options.tableSize);
+
+		(measured ? insertTimer : warmupTimer).Run(count, [&](int i) { table->Insert(present[i], i); });
+		(measured ? hitTimer : warmupTimer).Run(queries, [&](int i) { found += table->Find(hits[i]); });
+		(measured ? missTimer : warmupTimer).Run(queries, [&](int i) { found -= table->Find(misses[i]); });
+
+		if (table->GetSize() != count || found != queries)
+			throw string("Invalid results of table '") + name + "'";
+
+		bytesPerEntry = (double) table->GetStats().bytes / count;
+		delete table;
+	}
+
+	string distributionName = DistributionName(distribution);
+
+	report.Add({ name, keyType, distributionName, loadFactor, "insert", insertTimer.GetOperations(), insertTimer.GetStats(), bytesPerEntry });
+	report.Add({ name, keyType, distributionName, loadFactor, "find hit", hitTimer.GetOperations(), hitTimer.GetStats(), bytesPerEntry });
+	report.Add({ name, keyType, distributionName, loadFactor, "find miss", missTimer.GetOperations(), missTimer.GetStats(), bytesPerEntry });
+}
+
+// замеры таблицы для всех распределений и коэффициентов заполнения
+// таблица вызывается через конкретный тип, поэтому время не включает виртуальные вызовы
+template <typename K, typename Table, typename Create>
+void RunCases(BenchmarkReport &report, const BenchmarkOptions &options, const string &name, const string &keyType, const vector<KeyDistribution> &distributions, Create create) {
+	if (name.find(options.filter) == string::npos)
+		return;
+
+	for (KeyDistribution distribution : distributions)
+		for (double loadFactor : options.loadFactors)
+			RunCase<K, Table>(report, options, name, keyType, distribution, loadFactor, create);
+}
+
+// замеры всех таблиц с ключами типа K
+template <typename K>
+void RunTables(BenchmarkReport &report, const BenchmarkOptions &options, const string &keyType, const vector<KeyDistribution> &distributions) {
+	RunCases<K, LinearProbingTable<K, int>>(report, options, "Linear probing", keyType, distributions, [](int size) {
+		return new LinearProbingTable<K, int>(size, DefaultHash<K>(), 1, maxLoadFactor);
+	});
+
+	RunCases<K, LinearProbingTable<K, int>>(report, options, "Linear probing (backward shift)", keyType, distributions, [](int size) {
+		return new LinearProbingTable<K, int>(size, DefaultHash<K>(), 1, maxLoadFactor, true);
+	});
+
+	RunCases<K, LinearProbingTable<K, int, DefaultHash<K>, equal_to<K>, PackedStorage<K, int>>>(report, options, "Linear probing (packed)", keyType, distributions, [](int size) {
+		return new LinearProbingTable<K, int, DefaultHash<K>, equal_to<K>, PackedStorage<K, int>>(size, DefaultHash<K>(), 1, maxLoadFactor);
+	});
+
+	// целые ключи без поля состояния ячеек и со сравнением группами
+	if constexpr (is_integral<K>::value) {
+		RunCases<K, IntegerTable<K, int>>(report, options, "Linear probing (integer keys)", keyType, distributions, [](int size) {
+			return new IntegerTable<K, int>(size, IntegerMixer<K>(), maxLoadFactor);
+		});
+	}
+
+	// строковые ключи с хешами в ячейках, короткими ключами в ячейках и длинными в арене
+	if constexpr (is_same<K, string>::value) {
+		RunCases<K, StringTable<int>>(report, options, "Linear probing (string keys)", keyType, distributions, [](int size) {
+			return new StringTable<int>(size, StringHash(), maxLoadFactor);
+		});
+	}
+
+	RunCases<K, HopscotchTable<K, int>>(report, options, "Hopscotch hashing", keyType, distributions, [](int size) {
+		return new HopscotchTable<K, int>(size, DefaultHash<K>(), maxLoadFactor);
+	});
+
+	RunCases<K, QuadraticProbingTable<K, int>>(report, options, "Quadratic probing", keyType, distributions, [](int size) {
+		return new QuadraticProbingTable<K, int>(size, DefaultHash<K>(), maxLoadFactor);
+	});
+
+	RunCases<K, DoubleHashingTable<K, int>>(report, options, "Double hashing", keyType, distributions, [](int size) {
+		return new DoubleHashingTable<K, int>(size, DefaultHash<K>(), DefaultHash<K>(), maxLoadFactor);
+	});
+
+	RunCases<K, DoubleHashingTable<K, int, DefaultHash<K>, equal_to<K>, PackedStorage<K, int>>>(report, options, "Double hashing (packed)", keyType, distributions, [](int size) {
+		return new DoubleHashingTable<K, int, DefaultHash<K>, equal_to<K>, PackedStorage<K, int>>(size, DefaultHash<K>(), DefaultHash<K>(), maxLoadFactor);
+	});
+
+	RunCases<K, RobinHoodTable<K, int>>(report, options, "Robin hood hashing", keyType, distributions, [](int size) {
+		return new RobinHoodTable<K, int>(size, DefaultHash<K>(), maxLoadFactor);
+	});
+
+	RunCases<K, SwissTable<K, int>>(report, options, "Swiss table", keyType, distributions, [](int size) {
+		return new SwissTable<K, int>(size, DefaultHash<K>(), maxLoadFactor);
+	});
+
+	RunCases<K, CuckooTable<K, int>>(report, options, "Cuckoo hashing", keyType, distributions, [](int size) {
+		return new CuckooTable<K, int>(size, DefaultHash<K>(), DefaultHash<K>(), maxLoadFactor);
+	});
+
+	RunCases<K, SeparateChainingTable<K, int>>(report, options, "Separate chaining", keyType, distributions, [](int size) {
+		return new SeparateChainingTable<K, int>(size);
+	});
+
+	RunCases<K, BucketChainingTable<K, int>>(report, options, "Bucket chaining", keyType, distributions, [](int size) {
+		return new BucketChainingTable<K, int>(size);
+	});
+}
+
+int main(int argc, char **argv) {
+	BenchmarkOptions options;
+	BenchmarkReport report;
+
+	try {
+		options.Parse(argc, argv);
+
+		cout << "Table size: " << options.tableSize << ", warmup: " << options.warmup << ", trials: " << options.trials << endl;
+		report.PrintHeader();
+
+		RunTables<int>(report, options, "int", { KeyDistribution::Uniform, KeyDistribution::Sequential, KeyDistribution::Zipfian, KeyDistribution::Clustered });
+		RunTables<string>(report, options, "string", { KeyDistribution::Uniform, KeyDistribution::Zipfian });
+
+		if (options.csvPath != "")
+			report.WriteCsv(options.csvPath);
+
+		if (options.jsonPath != "")
+			report.WriteJson(options.jsonPath);
+	}
+	catch (const string &error) {
+		cout << "Error: " << error << endl;
+		return 1;
+	}
+}
@@ -81,6 +81,10 @@ void GetSize(HashTable<int, string> *table) {
     cout << "Size: " << table->GetSize() << endl;
 }
 
+void PrintStats(HashTable<int, string> *table) {
+    table->GetStats().Print();
+}
+
 int main() {
     string type;
 
@@ -105,16 +109,16 @@ int main() {
     HashTable<int, string> *table;
 
     if (type == "1") {
-        table = new SeparateChainingTable<int, string>(size, GetHash);
+        table = new SeparateChainingTable<int, string, FunctionHash<int>>(size, GetHash);
     }
     else if (type == "2") {
-        table = new LinearProbingTable<int, string>(size, GetHash);   
+        table = new LinearProbingTable<int, string, FunctionHash<int>>(size, GetHash);   
     }
     else if (type == "3") {
-        table = new QuadraticProbingTable<int, string>(size, GetHash);
+        table = new QuadraticProbingTable<int, string, FunctionHash<int>>(size, GetHash);
     }
     else {
-        table = new DoubleHashingTable<int, string>(size, GetHash, GetHash2);
+        table = new DoubleHashingTable<int, string, FunctionHash<int>>(size, GetHash, GetHash2);
     }
 
     int item; // выбираемый пункт меню
@@ -130,12 +134,13 @@ int main() {
         cout << "5. Get" << endl;
         cout << "6. Clear" << endl;
         cout << "7. Get size" << endl;
-        cout << "8. Quit" << endl;
+        cout << "8. Print stats" << endl;
+        cout << "9. Quit" << endl;
         cout << ">";
         cin >> item; // считываем пункт меню
 
         // обрабатываем некорректный ввод
-        while (item < 1 || item > 8) {
+        while (item < 1 || item > 9) {
             cout << "Incorrect item. Try again: ";
             cin >> item; // считываем пункт меню заново
         }
@@ -169,12 +174,16 @@ int main() {
             case 7:
                 GetSize(table);
                 break;
+
+            case 8:
+                PrintStats(table);
+                break;
         }
 
-        if (item != 8) {
+        if (item != 9) {
             system("pause"); // задерживаем экран
         }
-    } while (item != 8); // повторяем, пока не решим выйти
+    } while (item != 9); // повторяем, пока не решим выйти
 
     return 0;
 }
\ No newline at end of file
@@ -1,19 +1,35 @@
 #include <iostream>
 #include <chrono>
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <cstdio>
 
 using namespace std;
 using namespace std::chrono;
 
 #include "HashTable.h"
 #include "SeparateChainingTable.hpp"
+#include "BucketChainingTable.hpp"
 #include "LinearProbingTable.hpp"
 #include "QuadraticProbingTable.hpp"
 #include "DoubleHashingTable.hpp"
+#include "RobinHoodTable.hpp"
+#include "SwissTable.hpp"
+#include "CuckooTable.hpp"
+#include "HopscotchTable.hpp"
+#include "IntegerTable.hpp"
+#include "StringTable.hpp"
+#include "ShardedTable.hpp"
+#include "LockFreeTable.hpp"
+#include "MappedTable.hpp"
+#include "TableTraits.hpp"
 
-const int size = 100003;
+const int tableSize = 100003;
 const int limit = 100000;
-const int n = size / 3 * 2;
+const int n = tableSize / 3 * 2;
+const int churnRounds = 5;
+const int updateRounds = 5;
 
 int GetHash(int key) {
 	/*int hash = 0;
@@ -77,17 +93,708 @@ void RemoveTests(vector<int> &keys, HashTable<int, int> *table, string headline)
 	cout << ": " << us << " us" << endl;
 }
 
+// значение большого размера
+template <int N>
+struct Payload {
+	char data[N];
+};
+
+template <int N>
+ostream& operator<<(ostream& os, const Payload<N>& payload) {
+	return os << "payload(" << N << ")";
+}
+
+// поиск в таблице с большими значениями
+template <int N>
+void LargeValueTests(vector<int> &keys, HashTable<int, Payload<N>> *table, string headline) {
+	cout << headline;
+
+	Payload<N> payload = {};
+
+	for (size_t i = 0; i < keys.size(); i++)
+		table->Insert(keys[i], payload);
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (size_t i = 0; i < limit; i++)
+		table->Find(i);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+	auto us = duration_cast<microseconds>(t2 - t1).count() / (double) limit;
+
+	cout << ": " << us << " us" << endl;
+
+	delete table;
+}
+
+// сравнение хранения ячеек массивом структур и структурой массивов
+template <int N>
+void LargeValueTests(vector<int> &keys) {
+	LargeValueTests(keys, new LinearProbingTable<int, Payload<N>, FunctionHash<int>>(tableSize, GetHash), "Linear probing method, " + to_string(N) + " byte values (find)");
+	LargeValueTests(keys, new LinearProbingTable<int, Payload<N>, FunctionHash<int>, equal_to<int>, SplitStorage<int, Payload<N>>>(tableSize, GetHash), "Linear probing method, split storage, " + to_string(N) + " byte values (find)");
+	LargeValueTests(keys, new QuadraticProbingTable<int, Payload<N>, FunctionHash<int>>(tableSize, GetHash), "Quadratic probing method, " + to_string(N) + " byte values (find)");
+	LargeValueTests(keys, new QuadraticProbingTable<int, Payload<N>, FunctionHash<int>, equal_to<int>, SplitStorage<int, Payload<N>>>(tableSize, GetHash), "Quadratic probing method, split storage, " + to_string(N) + " byte values (find)");
+	LargeValueTests(keys, new DoubleHashingTable<int, Payload<N>, FunctionHash<int>>(tableSize, GetHash, GetHash2), "Double hashing method, " + to_string(N) + " byte values (find)");
+	LargeValueTests(keys, new DoubleHashingTable<int, Payload<N>, FunctionHash<int>, equal_to<int>, SplitStorage<int, Payload<N>>>(tableSize, GetHash, GetHash2), "Double hashing method, split storage, " + to_string(N) + " byte values (find)");
+}
+
+// сравнение способов выбора ёмкости для таблицы заданного типа
+template <typename Table>
+void CapacityTests(vector<int> &keys, Table *table, string headline) {
+	InsertTests(keys, table, headline + " (insert)");
+	FindTests(keys, table, headline + " (find)");
+
+	delete table;
+}
+
+template <typename Capacity>
+using LinearTable = LinearProbingTable<int, int, FunctionHash<int>, equal_to<int>, NodeStorage<int, int>, Capacity>;
+
+template <typename Capacity>
+using QuadraticTable = QuadraticProbingTable<int, int, FunctionHash<int>, equal_to<int>, NodeStorage<int, int>, Capacity>;
+
+template <typename Capacity>
+using DoubleTable = DoubleHashingTable<int, int, FunctionHash<int>, equal_to<int>, NodeStorage<int, int>, Capacity>;
+
+template <typename Capacity>
+using RobinHoodCapacityTable = RobinHoodTable<int, int, FunctionHash<int>, equal_to<int>, Capacity>;
+
+// сравнение остатка от деления, маски степени двойки и fastrange для простой ёмкости
+void CapacityTests(vector<int> &keys) {
+	CapacityTests(keys, new LinearTable<ModuloCapacity>(tableSize, GetHash), "Linear probing method q = 1, modulo capacity");
+	CapacityTests(keys, new LinearTable<PowerOfTwoCapacity>(tableSize, GetHash), "Linear probing method q = 1, power of two capacity");
+	CapacityTests(keys, new LinearTable<PrimeCapacity>(tableSize, GetHash), "Linear probing method q = 1, prime capacity");
+	CapacityTests(keys, new QuadraticTable<ModuloCapacity>(tableSize, GetHash), "Quadratic probing method, modulo capacity");
+	CapacityTests(keys, new QuadraticTable<PowerOfTwoCapacity>(tableSize, GetHash), "Quadratic probing method, power of two capacity");
+	CapacityTests(keys, new QuadraticTable<PrimeCapacity>(tableSize, GetHash), "Quadratic probing method, prime capacity");
+	CapacityTests(keys, new DoubleTable<ModuloCapacity>(tableSize, GetHash, GetHash2), "Double hashing method, modulo capacity");
+	CapacityTests(keys, new DoubleTable<PowerOfTwoCapacity>(tableSize, GetHash, GetHash2), "Double hashing method, power of two capacity");
+	CapacityTests(keys, new DoubleTable<PrimeCapacity>(tableSize, GetHash, GetHash2), "Double hashing method, prime capacity");
+	CapacityTests(keys, new RobinHoodCapacityTable<ModuloCapacity>(tableSize, GetHash), "Robin hood hashing method, modulo capacity");
+	CapacityTests(keys, new RobinHoodCapacityTable<PowerOfTwoCapacity>(tableSize, GetHash), "Robin hood hashing method, power of two capacity");
+	CapacityTests(keys, new RobinHoodCapacityTable<PrimeCapacity>(tableSize, GetHash), "Robin hood hashing method, prime capacity");
+}
+
+// длительная серия удалений и вставок при постоянном числе элементов
+void ChurnTests(HashTable<int, int> *table, string headline) {
+	cout << headline << endl;
+
+	vector<int> keys;
+	vector<int> missing;
+
+	// различные ключи: умножение на нечётную константу взаимно однозначно на 32-битных числах
+	uint32_t counter = 0;
+	auto nextKey = [&counter]() { return (int) (++counter * 2654435761u); };
+
+	for (int i = 0; i < n; i++) {
+		keys.push_back(nextKey());
+		missing.push_back(nextKey());
+		table->Insert(keys[i], i);
+	}
+
+	for (int round = 1; round <= churnRounds; round++) {
+		high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+		// заменяем случайные элементы новыми
+		for (int i = 0; i < n; i++) {
+			int index = rand() % n;
+
+			table->Remove(keys[index]);
+			keys[index] = nextKey();
+			table->Insert(keys[index], i);
+		}
+
+		high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+		// ищем отсутствующие ключи
+		for (int i = 0; i < n; i++)
+			table->Find(missing[i]);
+
+		high_resolution_clock::time_point t3 = high_resolution_clock::now();
+
+		auto churn = duration_cast<microseconds>(t2 - t1).count() / (double) n;
+		auto find = duration_cast<microseconds>(t3 - t2).count() / (double) n;
+
+		cout << "  round " << round << ": " << churn << " us (remove + insert), " << find << " us (unsuccessful find)" << endl;
+	}
+
+	for (int i = 0; i < n; i++)
+		if (!table->Find(keys[i]))
+			throw "";
+}
+
+// обновление значений уже существующих ключей: размер таблицы не должен расти
+void UpdateTests(vector<int> &keys, HashTable<int, int> *table, string headline) {
+	cout << headline;
+
+	for (size_t i = 0; i < keys.size(); i++)
+		table->Insert(keys[i], 0);
+
+	int size = table->GetSize();
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (int round = 1; round <= updateRounds; round++)
+		for (size_t i = 0; i < keys.size(); i++)
+			table->Insert(keys[i], round);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+	auto us = duration_cast<microseconds>(t2 - t1).count() / (double) (updateRounds * keys.size());
+
+	if (table->GetSize() != size)
+		throw "";
+
+	cout << ": " << us << " us (" << size << " elements)" << endl;
+
+	delete table;
+}
+
+// таблица с цепочками с заданным способом выделения памяти под узлы
+template <template <typename, typename> class Nodes>
+using ChainingTable = SeparateChainingTable<int, int, FunctionHash<int>, equal_to<int>, allocator<char>, Nodes>;
+
+// вставка, поиск, очистка и удаление большой таблицы с цепочками
+template <template <typename, typename> class Nodes>
+void NodeAllocatorTests(string headline) {
+	const int count = 1000000;
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	ChainingTable<Nodes> *table = new ChainingTable<Nodes>(count, GetHash);
+
+	for (int i = 0; i < count; i++)
+		table->Insert(i * 7, i);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+	for (int i = 0; i < count; i++)
+		if (!table->Find(i * 7))
+			throw "";
+
+	high_resolution_clock::time_point t3 = high_resolution_clock::now();
+
+	table->Clear();
+
+	high_resolution_clock::time_point t4 = high_resolution_clock::now();
+
+	for (int i = 0; i < count; i++)
+		table->Insert(i * 7, i);
+
+	delete table;
+
+	high_resolution_clock::time_point t5 = high_resolution_clock::now();
+
+	cout << headline << ": ";
+	cout << duration_cast<nanoseconds>(t2 - t1).count() / (double) count << " ns (insert), ";
+	cout << duration_cast<nanoseconds>(t3 - t2).count() / (double) count << " ns (find), ";
+	cout << duration_cast<microseconds>(t4 - t3).count() / 1000.0 << " ms (clear), ";
+	cout << duration_cast<microseconds>(t5 - t4).count() / 1000.0 << " ms (refill + destroy)" << endl;
+}
+
+// поиск в таблице с цепочками при заданном коэффициенте заполнения (большинство запросов - промахи)
+void ChainLoadTests(HashTable<int, int> *table, int count, string headline) {
+	const int misses = 9; // число промахов на одно попадание
+
+	for (int i = 0; i < count; i++)
+		table->Insert(i * 2654435761u & 0x7ffffffe, i); // чётные ключи есть в таблице
+
+	vector<int> queries; // запросы в случайном порядке, чтобы он не совпадал с порядком вставки
+
+	for (int i = 0; i < count * (misses + 1); i++)
+		queries.push_back(((rand() % count) * 2654435761u & 0x7ffffffe) | (i % (misses + 1) > 0)); // нечётных ключей нет
+
+	int found = 0;
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (size_t i = 0; i < queries.size(); i++)
+		found += table->Find(queries[i]);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+	if (found != count)
+		throw "";
+
+	cout << headline << ": " << duration_cast<nanoseconds>(t2 - t1).count() / (double) queries.size() << " ns" << endl;
+
+	delete table;
+}
+
+void ChainLoadTests() {
+	const int count = 1000000;
+
+	for (int loadFactor : { 1, 2, 4 }) {
+		int buckets = count / loadFactor + 1; // нечётное число корзин, чтобы нечётные ключи попадали в занятые корзины
+		string suffix = ", load factor " + to_string(loadFactor) + " (90% misses)";
+
+		ChainLoadTests(new SeparateChainingTable<int, int, FunctionHash<int>>(buckets, GetHash), count, "Separate chaining method" + suffix);
+		ChainLoadTests(new BucketChainingTable<int, int, FunctionHash<int>>(buckets, GetHash, loadFactor + 1), count, "Bucket chaining method" + suffix);
+	}
+}
+
+// поиск со взятием значения: Find и Get (два прохода пробной последовательности) против FindPtr (один проход)
+void LookupTests(vector<int> &keys, HashTable<int, int> *table, string headline) {
+	for (size_t i = 0; i < keys.size(); i++)
+		table->Insert(keys[i], i);
+
+	long long sum1 = 0, sum2 = 0;
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (int i = 0; i < limit; i++)
+		if (table->Find(i))
+			sum1 += table->Get(i);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+	for (int i = 0; i < limit; i++)
+		if (const int *value = table->FindPtr(i))
+			sum2 += *value;
+
+	high_resolution_clock::time_point t3 = high_resolution_clock::now();
+
+	if (sum1 != sum2)
+		throw "";
+
+	cout << headline << " (Find + Get): " << duration_cast<microseconds>(t2 - t1).count() / (double) limit << " us" << endl;
+	cout << headline << " (FindPtr): " << duration_cast<microseconds>(t3 - t2).count() / (double) limit << " us" << endl;
+
+	delete table;
+}
+
+// строка заданной длины из числа (числа дополняются общим префиксом, как идентификаторы с одинаковым началом)
+string PaddedKey(int key, size_t length) {
+	string digits = to_string(key);
+	return string(length - digits.length(), 'k') + digits;
+}
+
+// вставка и поиск строковых ключей заданной длины
+void StringKeyTests(vector<int> &keys, size_t length, HashTable<string, int> *table, string headline) {
+	vector<string> strings;
+	vector<string> lookups;
+
+	for (size_t i = 0; i < keys.size(); i++)
+		strings.push_back(PaddedKey(keys[i], length));
+
+	for (int i = 0; i < limit; i++)
+		lookups.push_back(PaddedKey(i, length));
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (size_t i = 0; i < strings.size(); i++)
+		table->Insert(strings[i], i);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+	long long sum = 0;
+
+	for (int i = 0; i < limit; i++)
+		if (const int *value = table->FindPtr(lookups[i]))
+			sum += *value;
+
+	high_resolution_clock::time_point t3 = high_resolution_clock::now();
+
+	volatile long long result = sum;
+	(void) result;
+
+	string suffix = ", " + to_string(length) + " byte keys";
+
+	cout << headline << suffix << " (insert): " << duration_cast<nanoseconds>(t2 - t1).count() / (double) strings.size() << " ns" << endl;
+	cout << headline << suffix << " (find): " << duration_cast<nanoseconds>(t3 - t2).count() / (double) limit << " ns" << endl;
+	cout << headline << suffix << ": " << table->GetStats().BytesPerEntry() << " bytes per entry" << endl;
+
+	delete table;
+}
+
+// ячейки со string сравнивают строки на каждом шаге пробирования, а таблица для строковых ключей - только при совпадении хешей
+void StringKeyTests(vector<int> &keys) {
+	for (size_t length : { 8, 20, 64 }) {
+		StringKeyTests(keys, length, new LinearProbingTable<string, int, StringHash>(tableSize), "Linear probing method q = 1");
+		StringKeyTests(keys, length, new SwissTable<string, int, StringHash>(tableSize), "Swiss table group probing method");
+		StringKeyTests(keys, length, new StringTable<int>(tableSize), "String key table");
+	}
+}
+
+// поиск в большой таблице по одному ключу и пакетами разного размера (пакетный поиск загружает ячейки заранее)
+void BatchTests(HashTable<int, int> *table, string headline) {
+	const int count = 4000000;
+	const int queries = 4000000;
+
+	vector<int> keys(count);
+
+	for (int i = 0; i < count; i++)
+		keys[i] = i * 2;
+
+	table->InsertBatch(keys.data(), keys.data(), count);
+
+	vector<int> lookups(queries);
+
+	for (int i = 0; i < queries; i++)
+		lookups[i] = rand() % (count * 2); // половина ключей отсутствует
+
+	int expected = 0;
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (int i = 0; i < queries; i++)
+		expected += table->Find(lookups[i]);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+	cout << headline << " (scalar): " << duration_cast<nanoseconds>(t2 - t1).count() / (double) queries << " ns" << endl;
+
+	for (int batch : { 8, 16, 32, 64 }) {
+		bool found[64];
+		int total = 0;
+
+		t1 = high_resolution_clock::now();
+
+		for (int i = 0; i + batch <= queries; i += batch) {
+			table->FindBatch(lookups.data() + i, batch, found);
+
+			for (int j = 0; j < batch; j++)
+				total += found[j];
+		}
+
+		t2 = high_resolution_clock::now();
+
+		if (total != expected)
+			throw "";
+
+		cout << headline << " (batch " << batch << "): " << duration_cast<nanoseconds>(t2 - t1).count() / (double) queries << " ns" << endl;
+	}
+
+	delete table;
+}
+
+void BatchTests() {
+	// последовательные ключи с хешем key образуют в линейном пробировании длинные кластеры, поэтому используется встроенная хеш-функция
+	BatchTests(new LinearProbingTable<int, int>(tableSize), "Linear probing method q = 1, 4M elements");
+	BatchTests(new LinearProbingTable<int, int, DefaultHash<int>, equal_to<int>, NodeStorage<int, int>, PowerOfTwoCapacity>(tableSize), "Linear probing method q = 1, power of two capacity, 4M elements");
+	BatchTests(new SwissTable<int, int>(tableSize), "Swiss table group probing method, 4M elements");
+	BatchTests(new SeparateChainingTable<int, int>(4000037), "Separate chaining method, 4M elements");
+	BatchTests(new BucketChainingTable<int, int>(tableSize), "Bucket chaining method, 4M elements");
+}
+
+// добавление и поиск ключей через переданный тип таблицы (время в наносекундах на операцию)
+template <typename Table>
+pair<double, double> DispatchRun(Table &table, const vector<int> &keys, const vector<int> &lookups) {
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (size_t i = 0; i < keys.size(); i++)
+		table.Insert(keys[i], i);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+	int found = 0;
+
+	for (size_t i = 0; i < lookups.size(); i++)
+		found += table.Find(lookups[i]);
+
+	high_resolution_clock::time_point t3 = high_resolution_clock::now();
+
+	if (found == 0)
+		throw "";
+
+	double insert = duration_cast<nanoseconds>(t2 - t1).count() / (double) keys.size();
+	double find = duration_cast<nanoseconds>(t3 - t2).count() / (double) lookups.size();
+	return make_pair(insert, find);
+}
+
+// вызовы через интерфейс: отдельная невстраиваемая функция, чтобы компилятор не узнал тип таблицы и не убрал виртуальные вызовы
+__attribute__((noinline)) pair<double, double> DispatchRun(HashTable<int, int> *table, const vector<int> &keys, const vector<int> &lookups) {
+	return DispatchRun<HashTable<int, int>>(*table, keys, lookups);
+}
+
+// сравнение вызовов через интерфейс HashTable (виртуальные) и через конкретный тип (статические, встраиваемые)
+// пути чередуются, и из нескольких повторов берётся лучшее время
+template <typename Table>
+void DispatchTests(const vector<int> &keys, const vector<int> &lookups, string headline) {
+	static_assert(IsHashTableV<Table, int, int>, "table must provide hash table interface");
+
+	const int rounds = 3;
+	pair<double, double> dynamicTimes(1e9, 1e9);
+	pair<double, double> staticTimes(1e9, 1e9);
+
+	for (int round = 0; round < rounds; round++) {
+		HashTable<int, int> *dynamicTable = new Table(tableSize, GetHash);
+		pair<double, double> times = DispatchRun(dynamicTable, keys, lookups);
+		dynamicTimes = make_pair(min(dynamicTimes.first, times.first), min(dynamicTimes.second, times.second));
+		delete dynamicTable;
+
+		Table staticTable(tableSize, GetHash);
+		times = DispatchRun(staticTable, keys, lookups);
+		staticTimes = make_pair(min(staticTimes.first, times.first), min(staticTimes.second, times.second));
+	}
+
+	cout << headline << " (insert, virtual): " << dynamicTimes.first << " ns" << endl;
+	cout << headline << " (insert, static): " << staticTimes.first << " ns" << endl;
+	cout << headline << " (find, virtual): " << dynamicTimes.second << " ns" << endl;
+	cout << headline << " (find, static): " << staticTimes.second << " ns" << endl;
+}
+
+void DispatchTests() {
+	vector<int> keys;
+	vector<int> lookups;
+
+	for (int i = 0; i < n; i++)
+		keys.push_back(rand() % limit);
+
+	for (int i = 0; i < 4 * limit; i++)
+		lookups.push_back(rand() % limit);
+
+	DispatchTests<LinearProbingTable<int, int, FunctionHash<int>>>(keys, lookups, "Linear probing method q = 1");
+	DispatchTests<RobinHoodTable<int, int, FunctionHash<int>>>(keys, lookups, "Robin hood hashing method");
+	DispatchTests<SwissTable<int, int, FunctionHash<int>>>(keys, lookups, "Swiss table group probing method");
+	DispatchTests<HopscotchTable<int, int, FunctionHash<int>>>(keys, lookups, "Hopscotch hashing method");
+	DispatchTests<SeparateChainingTable<int, int, FunctionHash<int>>>(keys, lookups, "Separate chaining method");
+	DispatchTests<BucketChainingTable<int, int, FunctionHash<int>>>(keys, lookups, "Bucket chaining method");
+}
+
+// создание большой таблицы, заполнение малой её части и очистка: время не должно зависеть от ёмкости
+template <typename Table>
+void ClearTests(const vector<int> &keys, string headline) {
+	const int rounds = 20;
+	const int capacities[] = { 1 << 16, 1 << 20, 1 << 23 };
+
+	for (int capacity : capacities) {
+		high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+		for (int round = 0; round < rounds; round++) {
+			Table table(capacity, GetHash);
+
+			for (int i = 0; i < 1000; i++)
+				table.Insert(keys[i], i);
+
+			table.Clear();
+
+			for (int i = 0; i < 1000; i++)
+				table.Insert(keys[i], i);
+		}
+
+		high_resolution_clock::time_point t2 = high_resolution_clock::now();
+		cout << headline << " (create and clear, capacity " << capacity << "): " << duration_cast<microseconds>(t2 - t1).count() / (double) rounds << " us" << endl;
+	}
+}
+
+void ClearTests(vector<int> &keys) {
+	ClearTests<LinearProbingTable<int, int, FunctionHash<int>>>(keys, "Linear probing method q = 1");
+	ClearTests<QuadraticProbingTable<int, int, FunctionHash<int>>>(keys, "Quadratic probing method");
+	ClearTests<RobinHoodTable<int, int, FunctionHash<int>>>(keys, "Robin hood hashing method");
+	ClearTests<SwissTable<int, int, FunctionHash<int>>>(keys, "Swiss table group probing method");
+}
+
+// запуск со снимком: построение таблицы вставками против открытия снимка через mmap
+void SnapshotTests() {
+	const int count = 1 << 21;
+	const int lookups = 1000;
+	const string path = "snapshot_perfomance.bin";
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+	LinearProbingTable<int, int> table(16);
+
+	for (int i = 0; i < count; i++)
+		table.Insert(i * 7, i);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+	table.Save(path);
+	high_resolution_clock::time_point t3 = high_resolution_clock::now();
+
+	cout << "Linear probing method, " << count << " elements (build with inserts): " << duration_cast<milliseconds>(t2 - t1).count() << " ms" << endl;
+	cout << "Linear probing method, " << count << " elements (save snapshot): " << duration_cast<milliseconds>(t3 - t2).count() << " ms" << endl;
+
+	for (bool verify : { true, false }) {
+		high_resolution_clock::time_point t4 = high_resolution_clock::now();
+		MappedTable<int, int> mapped(path, DefaultHash<int>(), verify);
+		int found = 0;
+
+		for (int i = 0; i < lookups; i++)
+			found += mapped.Find(rand() % count * 7);
+
+		high_resolution_clock::time_point t5 = high_resolution_clock::now();
+
+		if (found != lookups)
+			throw string("Invalid snapshot lookups");
+
+		cout << "Linear probing method, " << count << " elements (open snapshot" << (verify ? " with checksum" : "") << " and " << lookups << " lookups): " << duration_cast<microseconds>(t5 - t4).count() << " us" << endl;
+	}
+
+	remove(path.c_str());
+}
+
+// передача таблицы со строковыми значениями: копирование против перемещения и обмена,
+// а также рост таблицы, при котором элементы переносятся в новый массив перемещением
+template <typename Table>
+void HandoffTests(const vector<int> &keys, Table table, string headline) {
+	for (size_t i = 0; i < keys.size(); i++)
+		table.Insert(keys[i], string(64, 'a' + i % 26));
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+	Table copy(table);
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+	Table moved(move(copy));
+	high_resolution_clock::time_point t3 = high_resolution_clock::now();
+	swap(moved, table);
+	high_resolution_clock::time_point t4 = high_resolution_clock::now();
+
+	if (moved.GetSize() != table.GetSize() || !copy.IsEmpty())
+		throw string("Invalid handoff of table '") + headline + "'";
+
+	Table grown(16);
+	high_resolution_clock::time_point t5 = high_resolution_clock::now();
+
+	for (size_t i = 0; i < keys.size(); i++)
+		grown.Insert(keys[i], string(64, 'a' + i % 26));
+
+	high_resolution_clock::time_point t6 = high_resolution_clock::now();
+
+	cout << headline << " (copy): " << duration_cast<microseconds>(t2 - t1).count() << " us" << endl;
+	cout << headline << " (move): " << duration_cast<microseconds>(t3 - t2).count() << " us" << endl;
+	cout << headline << " (swap): " << duration_cast<microseconds>(t4 - t3).count() << " us" << endl;
+	cout << headline << " (insert with growth): " << duration_cast<microseconds>(t6 - t5).count() / (double) keys.size() << " us" << endl;
+}
+
+void HandoffTests(vector<int> &keys) {
+	HandoffTests(keys, SeparateChainingTable<int, string>(tableSize), "Separate chaining method");
+	HandoffTests(keys, BucketChainingTable<int, string>(tableSize), "Bucket chaining method");
+	HandoffTests(keys, LinearProbingTable<int, string>(tableSize), "Linear probing method q = 1");
+	HandoffTests(keys, QuadraticProbingTable<int, string>(tableSize), "Quadratic probing method");
+	HandoffTests(keys, DoubleHashingTable<int, string>(tableSize), "Double hashing method");
+	HandoffTests(keys, RobinHoodTable<int, string>(tableSize), "Robin hood hashing method");
+	HandoffTests(keys, SwissTable<int, string>(tableSize), "Swiss table group probing method");
+}
+
+// таблица под одной общей блокировкой (для сравнения с таблицей из сегментов)
+class LockedTable {
+	mutable mutex lock;
+	LinearProbingTable<int, int, FunctionHash<int>> table;
+
+public:
+	LockedTable(int tableSize) : table(tableSize, GetHash) {}
+
+	void Insert(int key, int value) { lock_guard<mutex> guard(lock); table.Insert(key, value); }
+	bool Remove(int key) { lock_guard<mutex> guard(lock); return table.Remove(key); }
+	bool Find(int key) const { lock_guard<mutex> guard(lock); return table.Find(key); }
+};
+
+// смесь чтений и изменений из нескольких потоков (writes - доля изменений в процентах)
+template <typename Table>
+void ConcurrencyTests(Table &table, int threadCount, int writes, string headline) {
+	const int operations = 2000000; // общее число операций всех потоков
+
+	for (int i = 0; i < limit; i += 2)
+		table.Insert(i, i);
+
+	vector<thread> threads;
+	vector<int> found(threadCount);
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (int t = 0; t < threadCount; t++)
+		threads.emplace_back([&table, &found, t, threadCount, writes]() {
+			unsigned int seed = t + 1;
+
+			for (int i = 0; i < operations / threadCount; i++) {
+				seed = seed * 1103515245 + 12345;
+				int key = (seed >> 8) % limit;
+
+				if ((int) ((seed >> 4) % 100) >= writes)
+					found[t] += table.Find(key);
+				else if (seed & 0x10000)
+					table.Insert(key, i);
+				else
+					table.Remove(key);
+			}
+		});
+
+	for (int t = 0; t < threadCount; t++)
+		threads[t].join();
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+	double seconds = duration_cast<microseconds>(t2 - t1).count() / 1000000.0;
+
+	cout << headline << ", " << threadCount << " threads: " << operations / seconds / 1000000 << " Mops/s" << endl;
+}
+
+void ConcurrencyTests() {
+	for (int writes : { 5, 50 }) {
+		string mix = to_string(writes) + "% writes";
+
+		for (int threadCount : { 1, 2, 4, 8 }) {
+			LockedTable locked(tableSize);
+			ShardedTable<int, int, FunctionHash<int>> sharded(tableSize, GetHash, 64);
+			LockFreeTable<FunctionHash<int>> lockFree(tableSize, GetHash);
+
+			ConcurrencyTests(locked, threadCount, writes, "Global mutex, " + mix);
+			ConcurrencyTests(sharded, threadCount, writes, "Sharded table, 64 shards, " + mix);
+			ConcurrencyTests(lockFree, threadCount, writes, "Lock-free table, " + mix);
+		}
+	}
+}
+
+// среднее время вычисления хеш-функции на наборе ключей
+template <typename K, typename HashFunction>
+void HashThroughputTests(const vector<K> &keys, HashFunction hash, string headline) {
+	cout << headline;
+
+	const int rounds = 20;
+	uint64_t checksum = 0; // сумма хешей не даёт компилятору выбросить вычисления
+
+	high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+	for (int round = 0; round < rounds; round++)
+		for (size_t i = 0; i < keys.size(); i++)
+			checksum += hash(keys[i]);
+
+	high_resolution_clock::time_point t2 = high_resolution_clock::now();
+	auto nanos = duration_cast<nanoseconds>(t2 - t1).count() / (double) (rounds * keys.size());
+
+	volatile uint64_t result = checksum;
+	(void) result;
+
+	cout << ": " << nanos << " ns" << endl;
+}
+
+void HashThroughputTests(vector<int> &keys) {
+	HashThroughputTests(keys, FunctionHash<int>(GetHash), "Legacy hash function (int)");
+	HashThroughputTests(keys, hash<int>(), "std::hash (int)");
+	HashThroughputTests(keys, [](int key) { return MixHash(key); }, "Murmur finalizer (int)");
+	HashThroughputTests(keys, IntegerHash<int>(), "SplitMix finalizer (int)");
+	HashThroughputTests(keys, SeededHash<int>(), "Seeded hash (int)");
+
+	for (size_t length : { 8, 32, 256 }) {
+		vector<string> strings;
+
+		for (size_t i = 0; i < keys.size(); i++) {
+			string key = to_string(keys[i]);
+			strings.push_back(string(length - key.length(), 'k') + key);
+		}
+
+		string suffix = " (string, " + to_string(length) + " bytes)";
+
+		HashThroughputTests(strings, hash<string>(), "std::hash" + suffix);
+		HashThroughputTests(strings, StringHash(), "String hash" + suffix);
+		HashThroughputTests(strings, SeededHash<string>(), "Seeded hash" + suffix);
+	}
+}
+
 int main() {
-	HashTable<int, int> *chaining = new SeparateChainingTable<int, int>(size, GetHash);
-	HashTable<int, int> *linear = new LinearProbingTable<int, int>(size, GetHash);
-	HashTable<int, int> *linear2 = new LinearProbingTable<int, int>(size, GetHash, 2);
-	HashTable<int, int> *linear4 = new LinearProbingTable<int, int>(size, GetHash, 4);
-	HashTable<int, int> *linear8 = new LinearProbingTable<int, int>(size, GetHash, 8);
-	HashTable<int, int> *linear64 = new LinearProbingTable<int, int>(size, GetHash, 64);
-	HashTable<int, int> *linear256 = new LinearProbingTable<int, int>(size, GetHash, 256);
-	HashTable<int, int> *linear1024 = new LinearProbingTable<int, int>(size, GetHash, 1024);
-	HashTable<int, int> *quadratic = new QuadraticProbingTable<int, int>(size, GetHash);
-	HashTable<int, int> *doubleHash = new DoubleHashingTable<int, int>(size, GetHash, GetHash2);
+	HashTable<int, int> *chaining = new SeparateChainingTable<int, int, FunctionHash<int>>(tableSize, GetHash);
+	HashTable<int, int> *linear = new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash);
+	HashTable<int, int> *linear2 = new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 2);
+	HashTable<int, int> *linear4 = new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 4);
+	HashTable<int, int> *linear8 = new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 8);
+	HashTable<int, int> *linear64 = new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 64);
+	HashTable<int, int> *linear256 = new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 256);
+	HashTable<int, int> *linear1024 = new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 1024);
+	HashTable<int, int> *quadratic = new QuadraticProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash);
+	HashTable<int, int> *doubleHash = new DoubleHashingTable<int, int, FunctionHash<int>>(tableSize, GetHash, GetHash2);
+	HashTable<int, int> *linearShift = new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 1, 0.75, true);
+	HashTable<int, int> *integer = new IntegerTable<int, int>(tableSize);
+	HashTable<int, int> *hopscotch = new HopscotchTable<int, int, FunctionHash<int>>(tableSize, GetHash);
+	HashTable<int, int> *robinHood = new RobinHoodTable<int, int, FunctionHash<int>>(tableSize, GetHash);
+	HashTable<int, int> *swiss = new SwissTable<int, int, FunctionHash<int>>(tableSize, GetHash);
+	HashTable<int, int> *cuckoo = new CuckooTable<int, int, FunctionHash<int>>(tableSize, GetHash, GetHash); // вторая корзина зависит от обоих хешей, поэтому функция может быть одной
+	HashTable<int, int> *bucketChaining = new BucketChainingTable<int, int, FunctionHash<int>>(tableSize, GetHash);
 
 	vector<int> keys;
 
@@ -95,6 +802,7 @@ int main() {
 		keys.push_back(rand() % limit);
 
 	InsertTests(keys, chaining, "Separate chaining method (insert)");
+	InsertTests(keys, bucketChaining, "Bucket chaining method (insert)");
 	InsertTests(keys, quadratic, "Quadratic probing method (insert)");
 	InsertTests(keys, doubleHash, "Doubly hashing method (insert)");
 	InsertTests(keys, linear1024, "Linear probing method q = 1024 (insert)");
@@ -104,10 +812,17 @@ int main() {
 	InsertTests(keys, linear4, "Linear probing method q = 4 (insert)");
 	InsertTests(keys, linear2, "Linear probing method q = 2 (insert)");
 	InsertTests(keys, linear, "Linear probing method q = 1 (insert)");
+	InsertTests(keys, linearShift, "Linear probing method q = 1, backward shift (insert)");
+	InsertTests(keys, integer, "Linear probing method, integer keys (insert)");
+	InsertTests(keys, hopscotch, "Hopscotch hashing method (insert)");
+	InsertTests(keys, robinHood, "Robin hood hashing method (insert)");
+	InsertTests(keys, swiss, "Swiss table group probing method (insert)");
+	InsertTests(keys, cuckoo, "Cuckoo hashing method (insert)");
 
 	cout << endl;
 
 	FindTests(keys, chaining, "Separate chaining method (find)");
+	FindTests(keys, bucketChaining, "Bucket chaining method (find)");
 	FindTests(keys, quadratic, "Quadratic probing method (find)");
 	FindTests(keys, doubleHash, "Double hashing method (find)");
 	FindTests(keys, linear1024, "Linear probing method q = 1024 (find)");
@@ -117,10 +832,17 @@ int main() {
 	FindTests(keys, linear4, "Linear probing method q = 4 (find)");
 	FindTests(keys, linear2, "Linear probing method q = 2 (find)");
 	FindTests(keys, linear, "Linear probing method q = 1 (find)");
+	FindTests(keys, linearShift, "Linear probing method q = 1, backward shift (find)");
+	FindTests(keys, integer, "Linear probing method, integer keys (find)");
+	FindTests(keys, hopscotch, "Hopscotch hashing method (find)");
+	FindTests(keys, robinHood, "Robin hood hashing method (find)");
+	FindTests(keys, swiss, "Swiss table group probing method (find)");
+	FindTests(keys, cuckoo, "Cuckoo hashing method (find)");
 
 	cout << endl;
 
 	RemoveTests(keys, chaining, "Separate chaining method (remove)");
+	RemoveTests(keys, bucketChaining, "Bucket chaining method (remove)");
 	RemoveTests(keys, quadratic, "Quadratic probing method (remove)");
 	RemoveTests(keys, doubleHash, "Doubly hashing method (remove)");
 	RemoveTests(keys, linear1024, "Linear probing method q = 1024 (remove)");
@@ -130,4 +852,94 @@ int main() {
 	RemoveTests(keys, linear4, "Linear probing method q = 4 (remove)");
 	RemoveTests(keys, linear2, "Linear probing method q = 2 (remove)");
 	RemoveTests(keys, linear, "Linear probing method q = 1 (remove)");
-}
\ No newline at end of file
+	RemoveTests(keys, linearShift, "Linear probing method q = 1, backward shift (remove)");
+	RemoveTests(keys, integer, "Linear probing method, integer keys (remove)");
+	RemoveTests(keys, hopscotch, "Hopscotch hashing method (remove)");
+	RemoveTests(keys, robinHood, "Robin hood hashing method (remove)");
+	RemoveTests(keys, swiss, "Swiss table group probing method (remove)");
+	RemoveTests(keys, cuckoo, "Cuckoo hashing method (remove)");
+
+	cout << endl;
+
+	// при одинаковом коэффициенте заполнения удалённые ячейки удлиняют пробные последовательности
+	ChurnTests(new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 1, 0.9), "Linear probing method q = 1, tombstones (churn)");
+	ChurnTests(new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 1, 0.9, true), "Linear probing method q = 1, backward shift (churn)");
+	ChurnTests(new IntegerTable<int, int>(tableSize, IntegerMixer<int>(), 0.9), "Linear probing method, integer keys (churn)");
+	ChurnTests(new RobinHoodTable<int, int, FunctionHash<int>>(tableSize, GetHash, 0.9), "Robin hood hashing method (churn)");
+	ChurnTests(new HopscotchTable<int, int, FunctionHash<int>>(tableSize, GetHash, 0.9), "Hopscotch hashing method (churn)");
+	ChurnTests(new CuckooTable<int, int, FunctionHash<int>>(tableSize, GetHash, GetHash, 0.9), "Cuckoo hashing method (churn)");
+
+	cout << endl;
+
+	LargeValueTests<64>(keys);
+	LargeValueTests<256>(keys);
+
+	cout << endl;
+
+	CapacityTests(keys);
+
+	cout << endl;
+
+	UpdateTests(keys, new SeparateChainingTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Separate chaining method (update)");
+	UpdateTests(keys, new BucketChainingTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Bucket chaining method (update)");
+	UpdateTests(keys, new QuadraticProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Quadratic probing method (update)");
+	UpdateTests(keys, new DoubleHashingTable<int, int, FunctionHash<int>>(tableSize, GetHash, GetHash2), "Double hashing method (update)");
+	UpdateTests(keys, new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Linear probing method q = 1 (update)");
+	UpdateTests(keys, new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash, 1, 0.75, true), "Linear probing method q = 1, backward shift (update)");
+	UpdateTests(keys, new IntegerTable<int, int>(tableSize), "Linear probing method, integer keys (update)");
+	UpdateTests(keys, new HopscotchTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Hopscotch hashing method (update)");
+	UpdateTests(keys, new RobinHoodTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Robin hood hashing method (update)");
+	UpdateTests(keys, new SwissTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Swiss table group probing method (update)");
+	UpdateTests(keys, new CuckooTable<int, int, FunctionHash<int>>(tableSize, GetHash, GetHash), "Cuckoo hashing method (update)");
+
+	cout << endl;
+
+	NodeAllocatorTests<HeapNodes>("Separate chaining method, heap nodes, 1M elements");
+	NodeAllocatorTests<PooledNodes>("Separate chaining method, pooled nodes, 1M elements");
+
+	cout << endl;
+
+	ChainLoadTests();
+
+	cout << endl;
+
+	LookupTests(keys, new SeparateChainingTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Separate chaining method");
+	LookupTests(keys, new BucketChainingTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Bucket chaining method");
+	LookupTests(keys, new LinearProbingTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Linear probing method q = 1");
+	LookupTests(keys, new IntegerTable<int, int>(tableSize), "Linear probing method, integer keys");
+	LookupTests(keys, new HopscotchTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Hopscotch hashing method");
+	LookupTests(keys, new SwissTable<int, int, FunctionHash<int>>(tableSize, GetHash), "Swiss table group probing method");
+	LookupTests(keys, new CuckooTable<int, int, FunctionHash<int>>(tableSize, GetHash, GetHash), "Cuckoo hashing method");
+
+	cout << endl;
+
+	HashThroughputTests(keys);
+
+	cout << endl;
+
+	StringKeyTests(keys);
+
+	cout << endl;
+
+	BatchTests();
+
+	cout << endl;
+
+	DispatchTests();
+
+	cout << endl;
+
+	HandoffTests(keys);
+
+	cout << endl;
+
+	ClearTests(keys);
+
+	cout << endl;
+
+	SnapshotTests();
+
+	cout << endl;
+
+	ConcurrencyTests();
+}
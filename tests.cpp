@@ -1,11 +1,30 @@
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <climits>
+#include <map>
+#include <fstream>
+#include <cstdio>
 
 #include "SeparateChainingTable.hpp"
+#include "BucketChainingTable.hpp"
 #include "LinearProbingTable.hpp"
 #include "QuadraticProbingTable.hpp"
 #include "DoubleHashingTable.hpp"
+#include "RobinHoodTable.hpp"
+#include "SwissTable.hpp"
+#include "CuckooTable.hpp"
+#include "HopscotchTable.hpp"
+#include "IntegerTable.hpp"
+#include "StringTable.hpp"
+#include "ShardedTable.hpp"
+#include "LockFreeTable.hpp"
+#include "MappedTable.hpp"
+#include "TableTraits.hpp"
 
 using namespace std;
 
@@ -122,6 +141,1126 @@ void ClearTest(HashTable<int, string> *table) {
 	cout << "OK" << endl;
 }
 
+void GrowTests(HashTable<int, string> *table) {
+	cout << "Grow tests: ";
+
+	assert(table->IsEmpty());
+
+	// вставляем больше элементов, чем ёмкость таблицы
+	for (int i = 0; i < 1000; i++)
+		table->Insert(i * 7, to_string(i));
+
+	assert(table->GetSize() == 1000);
+
+	for (int i = 0; i < 1000; i++)
+		assert(table->Get(i * 7) == to_string(i));
+
+	assert(!table->Find(3));
+
+	// удаляем и вставляем элементы, накапливая удалённые ячейки
+	for (int i = 0; i < 1000; i += 2) {
+		assert(table->Remove(i * 7));
+		table->Insert(i * 7 + 1, to_string(i));
+	}
+
+	assert(table->GetSize() == 1000);
+
+	for (int i = 0; i < 1000; i++) {
+		assert(table->Find(i * 7) == (i % 2 == 1));
+		assert(table->Find(i * 7 + 1) == (i % 2 == 0));
+	}
+
+	table->Clear();
+
+	assert(table->IsEmpty());
+	assert(!table->Find(7));
+
+	cout << "OK" << endl;
+}
+
+void PointerTests(HashTable<int, string> *table) {
+	cout << "Pointer tests: ";
+
+	assert(table->IsEmpty());
+	assert(table->FindPtr(12345) == nullptr);
+
+	string value;
+	assert(!table->TryGet(12345, value));
+
+	table->Insert(12345, "first");
+
+	// значение изменяется через указатель без повторного поиска
+	string *found = table->FindPtr(12345);
+	assert(found != nullptr && *found == "first");
+	*found = "changed";
+	assert(table->Get(12345) == "changed");
+	assert(table->TryGet(12345, value) && value == "changed");
+
+	// TryEmplace не заменяет существующее значение
+	pair<string*, bool> result = table->TryEmplace(12345, "other");
+	assert(!result.second && *result.first == "changed");
+
+	result = table->TryEmplace(135, "second");
+	assert(result.second && *result.first == "second");
+	assert(table->GetSize() == 2);
+
+	// InsertOrAssign заменяет значение на месте
+	result = table->InsertOrAssign(135, "replaced");
+	assert(!result.second && *result.first == "replaced");
+	assert(table->Get(135) == "replaced");
+	assert(table->GetSize() == 2);
+
+	result = table->InsertOrAssign(35, "third");
+	assert(result.second && *result.first == "third");
+	assert(table->GetSize() == 3);
+
+	// указатель на вставленное значение корректен и при расширении таблицы
+	for (int i = 0; i < 1000; i++) {
+		string text = to_string(i);
+		result = table->TryEmplace(i * 7 + 3, move(text));
+
+		assert(result.second && *result.first == to_string(i));
+	}
+
+	assert(table->GetSize() == 1003);
+
+	for (int i = 0; i < 1000; i++)
+		assert(*table->FindPtr(i * 7 + 3) == to_string(i));
+
+	const HashTable<int, string> *constTable = table;
+	assert(*constTable->FindPtr(35) == "third");
+	assert(constTable->FindPtr(36) == nullptr);
+
+	table->Clear();
+	assert(table->IsEmpty());
+
+	cout << "OK" << endl;
+}
+
+void UpsertTests(HashTable<int, string> *table) {
+	cout << "Upsert tests: ";
+
+	assert(table->IsEmpty());
+
+	// повторная вставка заменяет значение, а не добавляет дубликат
+	table->Insert(1, "first");
+	table->Insert(1, "second");
+
+	assert(table->GetSize() == 1);
+	assert(table->Get(1) == "second");
+
+	// ключи с одинаковым хешем образуют одну пробную последовательность
+	table->Insert(101, "third");
+	table->Insert(201, "fourth");
+	assert(table->Remove(101));
+
+	// ключ за удалённой ячейкой обновляется на месте, а не записывается в неё
+	table->Insert(201, "fifth");
+
+	assert(table->GetSize() == 2);
+	assert(table->Get(201) == "fifth");
+	assert(table->Remove(201));
+	assert(!table->Find(201));
+	assert(table->GetSize() == 1);
+
+	// многократное обновление не увеличивает размер таблицы
+	for (int round = 0; round < 10; round++)
+		for (int i = 0; i < 500; i++)
+			table->Insert(i * 3, to_string(round));
+
+	assert(table->GetSize() == 501); // 500 новых ключей и ключ 1
+
+	for (int i = 0; i < 500; i++)
+		assert(table->Get(i * 3) == "9");
+
+	for (int i = 0; i < 500; i++)
+		assert(table->Remove(i * 3));
+
+	assert(table->GetSize() == 1);
+	assert(!table->Find(0));
+
+	table->Clear();
+
+	cout << "OK" << endl;
+}
+
+// хеш-функция строк без учёта регистра
+struct CaseInsensitiveHash {
+	uint64_t operator()(const string& key) const {
+		uint64_t hash = 0;
+
+		for (size_t i = 0; i < key.length(); i++)
+			hash = hash * 31 + tolower(key[i]);
+
+		return MixHash(hash);
+	}
+};
+
+// сравнение строк без учёта регистра
+struct CaseInsensitiveEqual {
+	bool operator()(const string& a, const string& b) const {
+		if (a.length() != b.length())
+			return false;
+
+		for (size_t i = 0; i < a.length(); i++)
+			if (tolower(a[i]) != tolower(b[i]))
+				return false;
+
+		return true;
+	}
+};
+
+void HasherTests(HashTable<string, int> *table) {
+	cout << "Hasher tests: ";
+
+	table->Insert("Hello", 1);
+	table->Insert("World", 2);
+
+	assert(table->Find("HELLO"));
+	assert(table->Get("world") == 2);
+	assert(!table->Find("hell"));
+	assert(table->Remove("hElLo"));
+	assert(!table->Find("Hello"));
+	assert(table->GetSize() == 1);
+
+	cout << "OK" << endl;
+}
+
+// наибольшее отклонение от 0.5 вероятности изменения выходного бита при изменении одного входного бита
+template <typename HashFunction>
+double AvalancheBias(HashFunction hash, int inputBits, int samples) {
+	vector<int> flips(inputBits * 64, 0);
+	uint64_t input = 1;
+
+	for (int sample = 0; sample < samples; sample++) {
+		input = SplitMix(input); // псевдослучайный вход
+		uint64_t mask = inputBits == 64 ? ~0ULL : (1ULL << inputBits) - 1;
+		uint64_t value = input & mask;
+		uint64_t hash0 = hash(value);
+
+		for (int i = 0; i < inputBits; i++) {
+			uint64_t diff = hash0 ^ hash(value ^ (1ULL << i));
+
+			for (int j = 0; j < 64; j++)
+				flips[i * 64 + j] += (diff >> j) & 1;
+		}
+	}
+
+	double bias = 0;
+
+	for (size_t i = 0; i < flips.size(); i++)
+		bias = max(bias, fabs((double) flips[i] / samples - 0.5));
+
+	return bias;
+}
+
+// отношение дисперсии числа ключей в корзинах к ожидаемой (около 1 для равномерного хеша)
+// корзина выбирается младшими битами, так как их используют таблицы с ёмкостью - степенью двойки
+template <typename HashFunction>
+double BucketDispersion(HashFunction hash, int keys, int buckets) {
+	vector<int> counts(buckets, 0);
+
+	for (int i = 0; i < keys; i++)
+		counts[hash(i) & (buckets - 1)]++;
+
+	double mean = (double) keys / buckets;
+	double variance = 0;
+
+	for (int i = 0; i < buckets; i++)
+		variance += (counts[i] - mean) * (counts[i] - mean);
+
+	return variance / buckets / mean;
+}
+
+void HashQualityTests() {
+	cout << "Hash quality tests: ";
+
+	auto mix = [](uint64_t value) { return MixHash(value); };
+	auto splitMix = [](uint64_t value) { return SplitMix(value); };
+	auto bytes = [](uint64_t value) { return HashBytes(&value, sizeof(value)); };
+	auto seeded = [](uint64_t value) { return SeededHash<uint64_t>(12345)(value); };
+	auto intHash = [](uint64_t value) { return DefaultHash<int>()((int) value); };
+	auto stringHash = [](uint64_t value) { return StringHash()("key" + to_string(value)); };
+	auto legacy = [](uint64_t value) { return FunctionHash<int>(GetHash)((int) value); };
+
+	// каждый входной бит меняет каждый выходной бит с вероятностью около 0.5
+	assert(AvalancheBias(mix, 64, 2000) < 0.05);
+	assert(AvalancheBias(splitMix, 64, 2000) < 0.05);
+	assert(AvalancheBias(bytes, 64, 2000) < 0.05);
+	assert(AvalancheBias(seeded, 64, 2000) < 0.05);
+	assert(AvalancheBias(intHash, 32, 2000) < 0.05);
+
+	// последовательные ключи распределяются по корзинам равномерно
+	assert(BucketDispersion(splitMix, 1 << 16, 1 << 10) < 1.2);
+	assert(BucketDispersion(bytes, 1 << 16, 1 << 10) < 1.2);
+	assert(BucketDispersion(stringHash, 1 << 16, 1 << 10) < 1.2);
+	assert(BucketDispersion(legacy, 1 << 16, 1 << 10) > 10); // key % 100 использует лишь 100 корзин
+
+	// хеш строки зависит от всех байт и от длины
+	for (size_t length = 0; length <= 100; length++) {
+		string key(length, 'a');
+		string other = key + "b";
+
+		assert(StringHash()(key) != StringHash()(other));
+
+		for (size_t i = 0; i < length; i++) {
+			string changed = key;
+			changed[i] = 'b';
+			assert(StringHash()(key) != StringHash()(changed));
+		}
+	}
+
+	// string и string_view хешируются одинаково, а начальное значение меняет хеш
+	assert(StringHash()(string("hash")) == StringHash()(string_view("hash")));
+	assert(DefaultHash<string>()("hash") == StringHash()("hash"));
+	assert(SeededHash<string>(1)("hash") == SeededHash<string>(1)("hash"));
+	assert(SeededHash<string>(1)("hash") != SeededHash<string>(2)("hash"));
+	assert(SeededHash<int>(1)(42) != SeededHash<int>(2)(42));
+
+	cout << "OK" << endl;
+}
+
+// аллокатор, считающий выделения и освобождения памяти
+int allocations = 0;
+int deallocations = 0;
+
+template <typename T>
+struct CountingAllocator {
+	using value_type = T;
+
+	CountingAllocator() {}
+
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>&) {}
+
+	T* allocate(size_t n) {
+		allocations++;
+		return allocator<T>().allocate(n);
+	}
+
+	void deallocate(T *p, size_t n) {
+		deallocations++;
+		allocator<T>().deallocate(p, n);
+	}
+
+	template <typename U>
+	bool operator==(const CountingAllocator<U>&) const { return true; }
+
+	template <typename U>
+	bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+template <template <typename, typename> class Nodes>
+int AllocatorTests() {
+	allocations = 0;
+	deallocations = 0;
+
+	using Table = SeparateChainingTable<int, int, FunctionHash<int>, equal_to<int>, CountingAllocator<char>, Nodes>;
+	Table *table = new Table(100, GetHash);
+
+	for (int i = 0; i < 10000; i++)
+		table->Insert(i, i * 2);
+
+	// удалённые узлы переиспользуются
+	for (int i = 0; i < 10000; i += 2)
+		assert(table->Remove(i));
+
+	for (int i = 0; i < 10000; i += 2)
+		table->Insert(i, i * 3);
+
+	assert(table->GetSize() == 10000);
+
+	// копия не зависит от памяти исходной таблицы
+	Table *copy = new Table(*table);
+	table->Clear();
+
+	assert(table->IsEmpty());
+	assert(copy->GetSize() == 10000);
+
+	for (int i = 0; i < 10000; i++)
+		assert(copy->Get(i) == (i % 2 ? i * 2 : i * 3));
+
+	// после очистки таблица снова работает
+	for (int i = 0; i < 100; i++)
+		table->Insert(i, i);
+
+	assert(table->GetSize() == 100 && table->Get(99) == 99);
+
+	delete table;
+	delete copy;
+
+	assert(allocations == deallocations); // вся память возвращена
+
+	return allocations;
+}
+
+// поиск по string_view и const char* в таблице со строковыми ключами
+template <typename Table>
+void TransparentTests(Table *table) {
+	cout << "Transparent lookup tests: ";
+
+	table->Insert("Hello", 1);
+	table->Insert("world", 2);
+
+	string_view text = "Hello world";
+
+	assert(table->Find(text.substr(0, 5)));
+	assert(*table->FindPtr(text.substr(6)) == 2);
+	assert(!table->Find(text.substr(0, 4)));
+	assert(table->FindPtr(text) == nullptr);
+	assert(*table->FindPtr("Hello") == 1);
+
+	*table->FindPtr(text.substr(0, 5)) = 3;
+	assert(table->Get("Hello") == 3);
+
+	const Table *constTable = table;
+	assert(*constTable->FindPtr(text.substr(6)) == 2);
+
+	delete table;
+
+	cout << "OK" << endl;
+}
+
+// операции через конкретный тип таблицы (статическая диспетчеризация) согласованы с вызовами через интерфейс
+template <typename Table>
+void StaticTests(Table &table) {
+	static_assert(IsHashTableV<Table, int, string>, "table must provide hash table interface");
+	static_assert(is_final<Table>::value, "table must be final to devirtualize calls");
+
+	cout << "Static dispatch tests: ";
+
+	HashTable<int, string> &base = table;
+
+	for (int i = 0; i < 50; i++)
+		table.Insert(i, to_string(i));
+
+	assert(table.GetSize() == 50);
+	assert(base.GetSize() == 50);
+
+	for (int i = 0; i < 50; i++) {
+		assert(table.Find(i) && base.Find(i));
+		assert(table.Get(i) == base.Get(i));
+	}
+
+	for (int i = 0; i < 50; i += 2)
+		assert(base.Remove(i));
+
+	string value;
+
+	for (int i = 0; i < 50; i++)
+		assert(table.TryGet(i, value) == (i % 2 == 1));
+
+	table.Clear();
+	assert(base.IsEmpty());
+
+	cout << "OK" << endl;
+}
+
+// копирование, перемещение, присваивание и обмен таблиц
+template <typename Table>
+void MoveTests(Table table) {
+	cout << "Move tests: ";
+
+	for (int i = 0; i < 300; i++)
+		table.Insert(i, string(40, 'a' + i % 26) + to_string(i)); // строки длиннее встроенного буфера
+
+	Table copy(table);
+	assert(copy.GetSize() == 300 && table.GetSize() == 300);
+
+	static_assert(is_nothrow_move_constructible<Table>::value, "move constructor must not throw");
+
+	Table moved(move(table));
+	assert(moved.GetSize() == 300);
+	assert(table.IsEmpty() && !table.Find(1) && !table.Remove(1)); // перемещённая таблица пуста и пригодна к использованию
+	assert(table.GetStats().capacity == 0 && table.GetStats().LoadFactor() == 0); // и не выделяет память
+
+	Table empty(table); // копия перемещённой таблицы тоже без памяти
+	assert(empty.IsEmpty() && empty.GetStats().capacity == 0);
+	empty.Clear();
+	empty.Insert(0, "zero");
+	assert(empty.Get(0) == "zero");
+
+	table.Insert(1000, "reused");
+	assert(table.Get(1000) == "reused");
+
+	for (int i = 0; i < 300; i++) {
+		assert(moved.Get(i) == string(40, 'a' + i % 26) + to_string(i));
+		assert(copy.Get(i) == moved.Get(i));
+	}
+
+	table = copy; // присваивание копированием
+	assert(table.GetSize() == 300 && copy.GetSize() == 300 && !table.Find(1000));
+
+	copy.Insert(0, "changed");
+	assert(table.Get(0) != "changed"); // копии независимы
+
+	table = move(copy); // присваивание перемещением
+	assert(table.Get(0) == "changed" && table.GetSize() == 300);
+
+	table = table; // самоприсваивание
+	assert(table.GetSize() == 300);
+
+	Table other(move(copy)); // перемещённая таблица пуста, но сохраняет хеш-функцию
+	other.Insert(-1, "other");
+
+	swap(table, other);
+	assert(table.GetSize() == 1 && table.Get(-1) == "other");
+	assert(other.GetSize() == 300 && other.Get(0) == "changed");
+
+	for (int i = 0; i < 300; i += 3)
+		other.Remove(i);
+
+	for (int i = 300; i < 600; i++)
+		other.Insert(i, to_string(i)); // рост таблицы перемещает элементы
+
+	assert(other.GetSize() == 500);
+
+	for (int i = 1; i < 300; i++)
+		if (i % 3 != 0)
+			assert(other.Get(i) == string(40, 'a' + i % 26) + to_string(i));
+
+	cout << "OK" << endl;
+}
+
+// значение без конструктора по умолчанию с подсчётом существующих объектов
+struct Counted {
+	static int alive; // число существующих объектов
+	int value;
+
+	Counted(int value) : value(value) { alive++; }
+	Counted(const Counted& counted) : value(counted.value) { alive++; }
+	Counted& operator=(const Counted& counted) = default;
+	~Counted() { alive--; }
+};
+
+int Counted::alive = 0;
+
+ostream& operator<<(ostream& os, const Counted& counted) {
+	return os << counted.value;
+}
+
+// ячейки таблиц с открытой адресацией не создают ключей и значений, пока не заняты
+template <typename Table>
+void LazyInitTests(Table table) {
+	cout << "Lazy init tests: ";
+
+	assert(Counted::alive == 0); // создание таблицы не создаёт значений
+
+	{
+		Table grown(move(table));
+
+		for (int i = 0; i < 1000; i++)
+			grown.Insert(i, Counted(i)); // рост и перенос таблицы
+
+		assert(Counted::alive == 1000);
+
+		for (int i = 0; i < 1000; i += 2)
+			grown.Remove(i);
+
+		assert(Counted::alive == 500); // удалённые значения уничтожаются сразу
+
+		Table copy(grown);
+		assert(Counted::alive == 1000);
+
+		grown.Clear();
+		assert(Counted::alive == 500 && grown.IsEmpty() && !grown.Find(1));
+
+		grown.Insert(7, Counted(7)); // после очистки таблица пригодна к использованию
+		assert(grown.Get(7).value == 7 && copy.Get(7).value == 7 && !copy.Find(8));
+	}
+
+	assert(Counted::alive == 0); // все значения уничтожены вместе с таблицами
+
+	cout << "OK" << endl;
+}
+
+// кукушкина таблица: поиск просматривает не более двух корзин, а вытеснение сохраняет все элементы
+void CuckooTests() {
+	cout << "Cuckoo table tests: ";
+
+	// высокое заполнение без роста: элементы размещаются путями вытеснения
+	CuckooTable<int, int> table(4096, DefaultHash<int>(), DefaultHash<int>(), 0.95);
+
+	for (int i = 0; i < 3850; i++)
+		table.Insert(i * 31, i);
+
+	TableStats stats = table.GetStats();
+	assert(stats.size == 3850 && stats.capacity == 4096);
+	assert(stats.maxHitProbe <= 3 && stats.maxMissProbe <= 3); // две корзины и запас
+
+	for (int i = 0; i < 3850; i++)
+		assert(table.Get(i * 31) == i && !table.Find(i * 31 + 1));
+
+	for (int i = 0; i < 3850; i += 2)
+		assert(table.Remove(i * 31));
+
+	for (int i = 1; i < 3850; i += 2)
+		assert(table.Get(i * 31) == i);
+
+	// хеш-функции с малым числом значений: большинство ключей не помещается в свои корзины и попадает в запас
+	CuckooTable<int, int, FunctionHash<int>> weak(8, GetHash, GetHash2);
+
+	for (int i = 0; i < 2000; i++)
+		weak.Insert(i * 7, i);
+
+	stats = weak.GetStats();
+	assert(stats.size == 2000 && stats.maxHitProbe == 3);
+
+	for (int i = 0; i < 2000; i++)
+		assert(weak.Get(i * 7) == i);
+
+	for (int i = 0; i < 2000; i++)
+		assert(weak.Remove(i * 7));
+
+	assert(weak.IsEmpty() && !weak.Find(0));
+
+	cout << "OK" << endl;
+}
+
+// таблица хешинга классиков: ключи находятся в окрестности начальной ячейки даже при высоком заполнении
+void HopscotchTests() {
+	cout << "Hopscotch table tests: ";
+
+	HopscotchTable<int, int> table(4096, DefaultHash<int>(), 0.95);
+
+	for (int i = 0; i < 3850; i++)
+		table.Insert(i * 31, i);
+
+	TableStats stats = table.GetStats();
+	assert(stats.size == 3850 && stats.capacity == 4096);
+	assert(stats.maxHitProbe <= 32 && stats.maxMissProbe <= 32); // сравниваются только ключи окрестности
+
+	for (int i = 0; i < 3850; i++)
+		assert(table.Get(i * 31) == i && !table.Find(i * 31 + 1));
+
+	for (int i = 0; i < 3850; i += 2)
+		assert(table.Remove(i * 31));
+
+	stats = table.GetStats();
+	assert(stats.tombstones == 0 && stats.size == 1925);
+
+	for (int i = 1; i < 3850; i += 2)
+		assert(table.Get(i * 31) == i);
+
+	// хеш-функция с тремя значениями: ключи, не поместившиеся в окрестности, попадают в переполнение
+	HopscotchTable<int, int, FunctionHash<int>> weak(64, +[](int key) { return key % 3; });
+
+	for (int i = 0; i < 500; i++)
+		weak.Insert(i, i);
+
+	assert(weak.GetSize() == 500 && weak.GetStats().maxHitProbe > 32);
+
+	for (int i = 0; i < 500; i++)
+		assert(weak.Get(i) == i && !weak.Find(i + 500));
+
+	for (int i = 0; i < 500; i++)
+		assert(weak.Remove(i));
+
+	assert(weak.IsEmpty() && !weak.Find(0));
+
+	cout << "OK" << endl;
+}
+
+// проверка, что открытие снимка завершается исключением
+template <typename Table, typename... Args>
+bool OpenFails(const string& path, Args... args) {
+	try {
+		Table table(path, args...);
+	}
+	catch (const string& error) {
+		return true;
+	}
+
+	return false;
+}
+
+// изменение байтов записанного снимка (контрольная сумма не пересчитывается)
+template <typename Change>
+void PatchSnapshot(const string& path, Change change) {
+	ifstream in(path, ios::binary);
+	vector<char> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+	in.close();
+
+	change((SnapshotHeader *) bytes.data(), bytes.data());
+
+	ofstream out(path, ios::binary);
+	out.write(bytes.data(), bytes.size());
+}
+
+// запись снимков таблицы с линейным пробированием и их открытие через mmap
+void SnapshotTests() {
+	cout << "Snapshot tests: ";
+
+	const string path = "snapshot_tests.bin";
+
+	LinearProbingTable<int, int, FunctionHash<int>> ints(100, GetHash);
+
+	for (int i = 0; i < 1000; i++)
+		ints.Insert(i * 7, i);
+
+	for (int i = 0; i < 1000; i += 3)
+		ints.Remove(i * 7); // удалённые ячейки сохраняются на своих местах
+
+	ints.Save(path);
+
+	{
+		MappedTable<int, int, FunctionHash<int>> mapped(path, GetHash);
+		assert(mapped.GetSize() == ints.GetSize() && mapped.GetCapacity() == ints.GetStats().capacity);
+
+		for (int i = 0; i < 1000; i++) {
+			int value = -1;
+			assert(mapped.Find(i * 7) == (i % 3 != 0) && !mapped.Find(i * 7 + 1));
+			assert(mapped.TryGet(i * 7, value) == (i % 3 != 0) && (i % 3 == 0 || value == i));
+		}
+
+		assert(mapped.Get(7) == 1);
+		assert(mapped.GetStats().tombstones == ints.GetStats().tombstones);
+
+		assert((OpenFails<MappedTable<int, int>>(path, DefaultHash<int>()))); // другая хеш-функция
+		assert((OpenFails<MappedTable<int, int, FunctionHash<int>, PowerOfTwoCapacity>>(path, GetHash))); // другой способ выбора ёмкости
+		assert((OpenFails<MappedTable<int, long long, FunctionHash<int>>>(path, GetHash))); // другой тип значений
+	}
+
+	// строки хранятся в куче, незавершённый перенос завершается при записи
+	LinearProbingTable<string, string> strings(4, DefaultHash<string>(), 2);
+
+	int count = 0;
+
+	// добавляем элементы, пока таблица не окажется в середине переноса
+	while (count < 500 || !strings.GetStats().migrating) {
+		strings.Insert("key " + to_string(count), string(count % 50, 'a' + count % 26));
+		count++;
+	}
+
+	strings.Save(path);
+
+	{
+		MappedTable<string, string> mapped(path);
+		assert(mapped.GetSize() == count);
+
+		for (int i = 0; i < count; i++)
+			assert(mapped.Get("key " + to_string(i)) == string(i % 50, 'a' + i % 26));
+
+		assert(!mapped.Find("key " + to_string(count)) && !mapped.Find(""));
+	}
+
+	// шаг пробирования и положения строк проверяются и без контрольной суммы
+	strings.Save(path);
+	PatchSnapshot(path, [](SnapshotHeader *header, char *bytes) { header->q = -1; });
+	assert((OpenFails<MappedTable<string, string>>(path, DefaultHash<string>(), false)));
+
+	strings.Save(path);
+	PatchSnapshot(path, [](SnapshotHeader *header, char *bytes) {
+		SnapshotCell<string, string> *cells = (SnapshotCell<string, string> *) (bytes + header->cellsOffset);
+
+		for (int i = 0; i < header->capacity; i++)
+			if (cells[i].state == SNAPSHOT_BUSY)
+				cells[i].value.offset = UINT32_MAX; // значение за пределами кучи
+	});
+
+	{
+		MappedTable<string, string> mapped(path, DefaultHash<string>(), false);
+		assert(mapped.Find("key 1"));
+
+		try {
+			mapped.Get("key 1");
+			assert(false);
+		}
+		catch (string s) {
+		}
+	}
+
+	PatchSnapshot(path, [](SnapshotHeader *header, char *bytes) {
+		SnapshotCell<string, string> *cells = (SnapshotCell<string, string> *) (bytes + header->cellsOffset);
+
+		for (int i = 0; i < header->capacity; i++)
+			if (cells[i].state == SNAPSHOT_BUSY)
+				cells[i].key.offset = UINT32_MAX; // ключ за пределами кучи
+	});
+
+	assert((OpenFails<MappedTable<string, string>>(path, DefaultHash<string>(), false)));
+	strings.Save(path);
+
+	// повреждённый снимок не открывается с проверкой контрольной суммы
+	{
+		fstream f(path, ios::in | ios::out | ios::binary);
+		f.seekg(0, ios::end);
+		f.seekp((long long) f.tellg() - 1);
+		f.put('#');
+	}
+
+	assert((OpenFails<MappedTable<string, string>>(path, DefaultHash<string>(), true)));
+	assert((!OpenFails<MappedTable<string, string>>(path, DefaultHash<string>(), false)));
+
+	LinearProbingTable<int, int, FunctionHash<int>>(10, GetHash).Save(path); // пустая таблица
+
+	{
+		MappedTable<int, int, FunctionHash<int>> mapped(path, GetHash);
+		assert(mapped.IsEmpty() && !mapped.Find(0));
+	}
+
+	remove(path.c_str());
+	assert((OpenFails<MappedTable<int, int, FunctionHash<int>>>(path, GetHash))); // файла нет
+
+	cout << "OK" << endl;
+}
+
+void AllocatorTests() {
+	cout << "Allocator tests: ";
+
+	int heap = AllocatorTests<HeapNodes>();
+	int pooled = AllocatorTests<PooledNodes>();
+
+	assert(pooled * 100 < heap); // пул выделяет память блоками, а не под каждый узел
+
+	cout << "OK" << endl;
+}
+
+void BatchTests(HashTable<int, string> *table) {
+	cout << "Batch tests: ";
+
+	assert(table->IsEmpty());
+
+	// пакет больше блока предварительной загрузки и не кратен ему
+	const int count = 150;
+	int keys[count * 2];
+	string values[count * 2];
+	bool found[count * 2];
+
+	for (int i = 0; i < count * 2; i++) {
+		keys[i] = i * 7;
+		values[i] = to_string(i);
+	}
+
+	table->InsertBatch(keys, values, count); // вставляем первую половину ключей
+
+	assert(table->GetSize() == count);
+
+	table->FindBatch(keys, count * 2, found);
+
+	for (int i = 0; i < count * 2; i++)
+		assert(found[i] == (i < count));
+
+	string result[count * 2];
+	table->GetBatch(keys, count * 2, result, found);
+
+	for (int i = 0; i < count * 2; i++)
+		assert(found[i] == (i < count) && result[i] == (i < count ? values[i] : ""));
+
+	// пустой пакет ничего не делает
+	table->FindBatch(keys, 0, found);
+	table->InsertBatch(keys, values, 0);
+
+	for (int i = 0; i < count; i++)
+		assert(table->Remove(keys[i]));
+
+	assert(table->IsEmpty());
+
+	cout << "OK" << endl;
+}
+
+// таблица для целых ключей: нулевой ключ хранится отдельно, а удаление не оставляет удалённых ячеек
+void IntegerTests() {
+	cout << "Integer table tests: ";
+
+	static_assert(is_same<FlatTable<int, int>, IntegerTable<int, int>>::value, "integer keys must use the specialized table");
+	static_assert(is_same<FlatTable<string, int>, LinearProbingTable<string, int>>::value, "other keys must use generic cells");
+	static_assert(IntegerMixer<int>()(-1) == 0xffffffffULL, "mixer must be evaluated at compile time");
+
+	IntegerTable<int, int> table(16);
+	assert(!table.Find(0) && !table.Remove(0));
+
+	table.Insert(0, 100); // ключ свободной ячейки
+	table.Insert(-1, -1);
+	table.Insert(INT_MIN, 1);
+	table.Insert(INT_MAX, 2);
+	assert(table.GetSize() == 4 && table.Get(0) == 100 && table.Get(-1) == -1 && table.Get(INT_MIN) == 1 && table.Get(INT_MAX) == 2);
+	assert(!table.TryEmplace(0, 5).second && table.InsertOrAssign(0, 200).first == table.FindPtr(0) && table.Get(0) == 200);
+
+	for (int i = 1; i <= 2000; i++)
+		table.Insert(i * 37, i); // рост таблицы переносит и нулевой ключ
+
+	TableStats stats = table.GetStats();
+	assert(stats.size == 2004 && stats.hits == 2004 && stats.tombstones == 0);
+	assert((stats.capacity & (stats.capacity - 1)) == 0 && stats.LoadFactor() <= 0.75);
+
+	for (int i = 2; i <= 2000; i += 2)
+		assert(table.Remove(i * 37));
+
+	stats = table.GetStats();
+	assert(stats.size == 1004 && stats.tombstones == 0);
+
+	int clustered = 0; // число ячеек в кластерах (нулевой ключ образует отдельный кластер)
+
+	for (size_t i = 0; i < stats.clusterSizes.size(); i++)
+		clustered += i * stats.clusterSizes[i];
+
+	assert(clustered == 1004 && stats.clusterSizes[1] >= 1);
+
+	for (int i = 1; i <= 2000; i++)
+		assert(table.Find(i * 37) == (i % 2 == 1));
+
+	assert(table.Remove(0) && !table.Find(0) && table.Get(-1) == -1 && table.GetSize() == 1003);
+
+	// 64-битные ключи, различающиеся только старшими битами
+	IntegerTable<long long, int> wide(16);
+
+	for (int i = 0; i < 1000; i++)
+		wide.Insert((long long) i << 40, i);
+
+	for (int i = 0; i < 1000; i++)
+		assert(wide.Get((long long) i << 40) == i && !wide.Find(((long long) i << 40) + 1));
+
+	assert(wide.GetStats().AverageHitProbe() < 2);
+
+	// хеш-функция с малым числом значений: длинные кластеры просматриваются группами ключей
+	IntegerTable<int, int, FunctionHash<int>> weak(16, FunctionHash<int>(GetHash));
+
+	for (int i = 0; i < 500; i++)
+		weak.Insert(i, i);
+
+	for (int i = 0; i < 500; i += 3)
+		assert(weak.Remove(i));
+
+	for (int i = 0; i < 500; i++)
+		assert(weak.Find(i) == (i % 3 != 0) && (i % 3 == 0 || weak.Get(i) == i));
+
+	cout << "OK" << endl;
+}
+
+// хеш-функция, у всех ключей совпадающая с обозначением свободной ячейки
+struct ZeroHash {
+	uint64_t operator()(string_view key) const {
+		return 0;
+	}
+};
+
+// таблица для строковых ключей: короткие ключи хранятся в ячейках, длинные - в общей арене
+void StringTableTests() {
+	cout << "String table tests: ";
+
+	StringTable<int> table(16);
+
+	for (int i = 0; i < 1000; i++)
+		table.Insert("key" + to_string(i), i); // короткие ключи
+
+	assert(table.GetSize() == 1000 && table.GetArenaSize() == 0);
+
+	string prefix(40, 'x');
+
+	for (int i = 0; i < 1000; i++)
+		table.Insert(prefix + to_string(i), -i); // длинные ключи
+
+	size_t arenaSize = table.GetArenaSize();
+	assert(table.GetSize() == 2000 && arenaSize > 40 * 1000);
+
+	for (int i = 0; i < 1000; i++) {
+		assert(table.Get("key" + to_string(i)) == i && table.Get(prefix + to_string(i)) == -i);
+		assert(!table.Find(prefix + to_string(i) + "!"));
+	}
+
+	// ключи на границе хранения в ячейке
+	string inlineKey(20, 'a');
+	string longKey(21, 'a');
+
+	table.Insert(inlineKey, 20);
+	assert(table.GetArenaSize() == arenaSize);
+
+	table.Insert(longKey, 21);
+	assert(table.GetArenaSize() == arenaSize + 21 && table.Get(inlineKey) == 20 && table.Get(longKey) == 21);
+	assert(table.Remove(inlineKey) && table.Remove(longKey));
+
+	StringTable<int> copy(table);
+
+	// удаление большей части длинных ключей уплотняет арену
+	for (int i = 0; i < 900; i++)
+		assert(table.Remove(prefix + to_string(i)));
+
+	assert(table.GetArenaSize() < arenaSize / 2 && table.GetStats().tombstones == 0);
+
+	for (int i = 0; i < 1000; i++) {
+		assert(table.Find("key" + to_string(i)) && table.Find(prefix + to_string(i)) == (i >= 900));
+		assert(copy.Get(prefix + to_string(i)) == -i); // копия не зависит от уплотнения арены
+	}
+
+	StringTable<int> moved(move(copy));
+	assert(copy.IsEmpty() && copy.GetArenaSize() == 0 && moved.GetSize() == 2000);
+	assert(copy.GetStats().capacity == 0 && !copy.Find("key0") && !copy.Remove("key0")); // перемещённая таблица без памяти
+
+	copy.Insert("key0", 1); // массивы выделяются при первой вставке
+	assert(copy.Get("key0") == 1 && copy.GetSize() == 1);
+
+	swap(moved, table);
+	assert(moved.GetSize() == 1100 && table.Get(prefix + "0") == 0);
+
+	// при совпадении хешей всех ключей ключи различаются по длине и байтам
+	StringTable<string, ZeroHash> collisions(4);
+
+	for (int i = 0; i < 100; i++)
+		collisions.Insert(to_string(i) + (i % 2 ? prefix : ""), to_string(i));
+
+	for (int i = 0; i < 100; i++)
+		assert(collisions.Get(to_string(i) + (i % 2 ? prefix : "")) == to_string(i) && !collisions.Find(to_string(i) + "?"));
+
+	for (int i = 0; i < 100; i += 2)
+		assert(collisions.Remove(to_string(i)));
+
+	assert(collisions.GetSize() == 50 && collisions.Get("1" + prefix) == "1");
+
+	cout << "OK" << endl;
+}
+
+// статистика заполнения согласована с содержимым таблицы
+void StatsTests(HashTable<int, string> *table) {
+	cout << "Stats tests: ";
+
+	table->Clear();
+
+	TableStats stats = table->GetStats();
+	assert(stats.size == 0 && stats.hits == 0 && stats.maxHitProbe == 0);
+
+	for (int i = 0; i < 200; i++)
+		table->Insert(i * 7, to_string(i));
+
+	stats = table->GetStats();
+	assert(stats.size == 200 && stats.hits == 200);
+	assert(stats.capacity > 0 && fabs(stats.LoadFactor() - 200.0 / stats.capacity) < 1e-9);
+	assert(stats.AverageHitProbe() >= 1 && stats.maxHitProbe >= stats.AverageHitProbe());
+	assert(stats.misses > 0 && stats.maxMissProbe >= stats.AverageMissProbe());
+	assert(stats.BytesPerEntry() > sizeof(int) + sizeof(string)); // память не меньше самих элементов
+
+	int clustered = 0; // число ячеек в кластерах
+
+	for (size_t i = 0; i < stats.clusterSizes.size(); i++)
+		clustered += i * stats.clusterSizes[i];
+
+	assert(stats.migrating || stats.clusterSizes.empty() || clustered >= stats.size);
+
+	int chained = 0; // число элементов в цепочках
+
+	for (size_t i = 0; i < stats.chainLengths.size(); i++)
+		chained += i * stats.chainLengths[i];
+
+	assert(stats.chainLengths.empty() || chained == stats.size);
+
+	for (int i = 0; i < 200; i += 2)
+		table->Remove(i * 7);
+
+	stats = table->GetStats();
+	assert(stats.size == 100 && stats.hits == 100);
+
+	table->Clear();
+
+	cout << "OK" << endl;
+}
+
+void LoadFactorTests() {
+	cout << "Linear probing load factor tests: ";
+
+	// коэффициент заполнения, не меньший единицы, не должен оставлять таблицу без свободных ячеек
+	for (bool backwardShift : { false, true }) {
+		LinearProbingTable<int, int, FunctionHash<int>> table(8, GetHash, 1, 1, backwardShift);
+
+		for (int i = 0; i < 8; i++)
+			table.Insert(i, i);
+
+		assert(!table.Find(100));
+
+		for (int i = 0; i < 8; i++)
+			assert(table.Remove(i));
+
+		assert(table.IsEmpty());
+	}
+
+	cout << "OK" << endl;
+}
+
+// проверка, что выбор ёмкости завершается исключением
+template <typename Capacity>
+bool RoundFails(int64_t capacity) {
+	try {
+		Capacity::Round(capacity);
+	}
+	catch (const string& error) {
+		return true;
+	}
+
+	return false;
+}
+
+void CapacityPolicyTests() {
+	cout << "Capacity policy tests: ";
+
+	assert(PowerOfTwoCapacity::Round(100) == 128 && PowerOfTwoCapacity::Round(1 << 30) == 1 << 30);
+	assert(PrimeCapacity::Round(100) == 101 && PrimeCapacity::Round(INT_MAX) == INT_MAX);
+	assert(ModuloCapacity::Round(INT_MAX) == INT_MAX);
+
+	// удвоение наибольшей ёмкости не должно переполнять int
+	assert(RoundFails<PowerOfTwoCapacity>((1 << 30) + 1) && RoundFails<PowerOfTwoCapacity>((1 << 30) * 2ll));
+	assert(RoundFails<PrimeCapacity>(INT_MAX * 2ll) && RoundFails<ModuloCapacity>(INT_MAX * 2ll));
+
+	cout << "OK" << endl;
+}
+
+void QuadraticGrowthTests() {
+	cout << "Quadratic probing growth tests: ";
+
+	// ключи с одной начальной ячейкой: при ёмкости 6 треугольные смещения обходят только 4 ячейки,
+	// поэтому таблица перестраивается, и новая ёмкость - степень двойки, при которой обходятся все ячейки
+	QuadraticProbingTable<int, int, FunctionHash<int>> table(6, GetHash, 0.99);
+
+	for (int i = 0; i < 5; i++)
+		table.Insert(i * 100, i);
+
+	assert(table.GetStats().capacity == 16);
+
+	for (int i = 5; i < 15; i++)
+		table.Insert(i * 100, i);
+
+	assert(table.GetStats().capacity == 16); // больше перестроений не требуется
+
+	for (int i = 0; i < 15; i++)
+		assert(table.Get(i * 100) == i);
+
+	cout << "OK" << endl;
+}
+
+void CoprimeStepGrowthTests() {
+	cout << "Coprime step growth tests: ";
+
+	assert(CoprimeStep(2, 11) == 2 && CoprimeStep(2, 22) == 3 && CoprimeStep(12, 22) == 13 && CoprimeStep(22, 22) == 1);
+	assert(ModuloCapacity::Step(4, 100) == 7 && CoprimeStep(5, 0) == 1);
+
+	// после удвоений ёмкость 11 * 2^k чётная: чётные шаги обходили бы только часть ячеек, и поиск отсутствующего ключа
+	// просматривал бы весь массив, а неудачные вставки вызывали бы лишние перестроения
+	DoubleHashingTable<int, int> doubleHashing(11);
+
+	for (int i = 0; i < 100000; i++)
+		doubleHashing.Insert(i, i);
+
+	TableStats stats = doubleHashing.GetStats();
+	assert(stats.capacity == 11 * (1 << 14) && stats.maxMissProbe < 64);
+
+	for (int i = 100000; i < 200000; i++)
+		doubleHashing.Insert(i, i);
+
+	assert(doubleHashing.GetStats().capacity == 11 * (1 << 15));
+
+	// то же для линейного пробирования с шагом 2
+	LinearProbingTable<int, int> linear(11, DefaultHash<int>(), 2);
+
+	for (int i = 0; i < 100000; i++)
+		linear.Insert(i, i);
+
+	stats = linear.GetStats();
+	assert(stats.capacity == 11 * (1 << 14) && stats.maxMissProbe < 1000);
+
+	for (int i = 0; i < 200000; i++)
+		assert(doubleHashing.Get(i) == i && (i >= 100000 || linear.Get(i) == i));
+
+	cout << "OK" << endl;
+}
+
 void Tests(HashTable<int, string> *table, string description) {
 	cout << description << endl;
 
@@ -130,22 +1269,726 @@ void Tests(HashTable<int, string> *table, string description) {
 	RemoveTests(table);
 	GetTests(table);
 	ClearTest(table);
+	GrowTests(table);
+	PointerTests(table);
+	UpsertTests(table);
+	BatchTests(table);
+	StatsTests(table);
 
 	cout << endl;
 }
 
+// точные значения статистики для небольших таблиц
+void ExactStatsTests() {
+	cout << "Exact stats tests: ";
+
+	// ключи 0..9 с хешем key % 100 образуют один кластер, каждый ключ лежит в своей начальной ячейке
+	LinearProbingTable<int, string, FunctionHash<int>> linear(100, GetHash);
+
+	for (int i = 0; i < 10; i++)
+		linear.Insert(i, "");
+
+	linear.Insert(100, ""); // начальная ячейка занята, ключ ляжет в ячейку 10
+
+	TableStats stats = linear.GetStats();
+	assert(stats.capacity == 100 && stats.tombstones == 0);
+	assert(stats.hitProbes == 10 + 11 && stats.maxHitProbe == 11);
+	assert(stats.maxMissProbe == 12);
+	assert(stats.clusterSizes.size() == 12 && stats.clusterSizes[11] == 1);
+
+	linear.Remove(5);
+	stats = linear.GetStats();
+	assert(stats.size == 10 && stats.tombstones == 1 && stats.clusterSizes[11] == 1);
+
+	// удаление со сдвигом назад не оставляет удалённых ячеек
+	LinearProbingTable<int, string, FunctionHash<int>> shift(100, GetHash, 1, 0.75, true);
+
+	for (int i = 0; i < 10; i++)
+		shift.Insert(i, "");
+
+	shift.Remove(5);
+	stats = shift.GetStats();
+	assert(stats.tombstones == 0 && stats.clusterSizes[5] == 1 && stats.clusterSizes[4] == 1);
+
+	// ключи 0, 100 и 200 попадают в одну цепочку
+	SeparateChainingTable<int, string, FunctionHash<int>> chaining(10, GetHash);
+	chaining.Insert(0, "");
+	chaining.Insert(100, "");
+	chaining.Insert(200, "");
+	chaining.Insert(1, "");
+
+	stats = chaining.GetStats();
+	assert(stats.chainLengths[0] == 8 && stats.chainLengths[1] == 1 && stats.chainLengths[3] == 1);
+	assert(stats.hitProbes == 1 + 2 + 3 + 1 && stats.maxHitProbe == 3 && stats.maxMissProbe == 3);
+
+	// статистика сегментов суммируется
+	ShardedTable<int, int, FunctionHash<int>> sharded(64, GetHash, 4);
+
+	for (int i = 0; i < 100; i++)
+		sharded.Insert(i, i);
+
+	stats = sharded.GetStats();
+	assert(stats.size == 100 && stats.hits == 100);
+
+	LockFreeTable<FunctionHash<int>> lockFree(64, GetHash);
+
+	for (int i = 0; i < 20; i++)
+		lockFree.Insert(i, i);
+
+	lockFree.Remove(3);
+	stats = lockFree.GetStats();
+	assert(stats.size == 19 && stats.hits == 19 && stats.tombstones == 1);
+
+	// длинный кластер из последовательных ключей: длины неуспешного поиска считаются за один проход, а не за квадрат размера кластера
+	auto identity = [](int key) { return key; };
+	LinearProbingTable<int, int, FunctionHash<int>> sequential(100000, +identity, 3);
+
+	for (int i = 0; i < 60000; i++)
+		sequential.Insert(i, i);
+
+	stats = sequential.GetStats();
+	assert(stats.capacity == 100000 && stats.hitProbes == 60000 && stats.maxHitProbe == 1);
+	assert(stats.maxMissProbe == 20001 && stats.clusterSizes[60000] == 1);
+
+	// упакованные состояния занимают меньше памяти, чем поле состояния в каждой ячейке
+	LinearProbingTable<int, int, FunctionHash<int>> nodeLinear(1000, GetHash);
+	LinearProbingTable<int, int, FunctionHash<int>, equal_to<int>, PackedStorage<int, int>> packedLinear(1000, GetHash);
+	size_t nodeBytes = nodeLinear.GetStats().bytes - sizeof(nodeLinear);
+	size_t packedBytes = packedLinear.GetStats().bytes - sizeof(packedLinear);
+	assert(nodeBytes == 1000 * 12 && packedBytes == 32 * 8 + 1000 * 8);
+
+	cout << "OK" << endl;
+}
+
+// потокобезопасная таблица с сегментами
+void ShardedTests(int shardCount) {
+	cout << "Sharded table tests (" << shardCount << " shards): ";
+
+	ShardedTable<int, int, FunctionHash<int>> table(64, GetHash, shardCount);
+	const int threadCount = 4;
+	const int count = 2000;
+
+	assert(table.IsEmpty());
+
+	// однопоточные операции
+	assert(table.TryEmplace(1, 10));
+	assert(!table.TryEmplace(1, 20));
+	assert(table.Get(1) == 10);
+	assert(!table.InsertOrAssign(1, 30));
+	assert(table.Get(1) == 30);
+	assert(table.Remove(1));
+	assert(!table.Find(1));
+
+	int value;
+	assert(!table.TryGet(1, value));
+
+	// одновременная вставка непересекающихся диапазонов ключей
+	vector<thread> threads;
+
+	for (int t = 0; t < threadCount; t++)
+		threads.emplace_back([&table, t, count]() {
+			for (int i = 0; i < count; i++)
+				table.Insert(t * count + i, i);
+		});
+
+	for (size_t t = 0; t < threads.size(); t++)
+		threads[t].join();
+
+	assert(table.GetSize() == threadCount * count);
+
+	for (int i = 0; i < threadCount * count; i++)
+		assert(table.TryGet(i, value) && value == i % count);
+
+	// одновременные изменения одних и тех же значений не теряются
+	threads.clear();
+
+	for (int t = 0; t < threadCount; t++)
+		threads.emplace_back([&table, count]() {
+			for (int i = 0; i < count; i++)
+				table.Update(i % 100, [](int &value) { value++; });
+		});
+
+	for (size_t t = 0; t < threads.size(); t++)
+		threads[t].join();
+
+	for (int i = 0; i < 100; i++)
+		assert(table.Get(i) == i + threadCount * count / 100);
+
+	// чтение одновременно с удалением: читатели видят либо исходное значение, либо отсутствие ключа
+	threads.clear();
+
+	for (int t = 0; t < threadCount; t++)
+		threads.emplace_back([&table, t, count]() {
+			for (int i = 0; i < threadCount * count; i++) {
+				int value;
+
+				if (t % 2 == 0 && i % threadCount == t)
+					table.Remove(i);
+				else if (i >= 100 && table.TryGet(i, value))
+					assert(value == i % count);
+			}
+		});
+
+	for (size_t t = 0; t < threads.size(); t++)
+		threads[t].join();
+
+	for (int i = 0; i < threadCount * count; i++)
+		assert(table.Find(i) == (i % 2 == 1));
+
+	table.Clear();
+	assert(table.IsEmpty());
+
+	cout << "OK" << endl;
+}
+
+// неблокирующая таблица: однопоточные операции и расширение
+void LockFreeTests() {
+	cout << "Lock-free table tests: ";
+
+	LockFreeTable<FunctionHash<int>> table(2, GetHash);
+	int value;
+
+	assert(table.IsEmpty());
+	assert(!table.Find(0));
+	assert(!table.Remove(0));
+
+	// допустимы любые ключи и значения, включая граничные
+	table.Insert(0, INT_MIN);
+	table.Insert(INT_MIN, -1);
+	table.Insert(-1, INT_MAX);
+
+	assert(table.GetSize() == 3);
+	assert(table.Get(0) == INT_MIN && table.Get(INT_MIN) == -1 && table.Get(-1) == INT_MAX);
+
+	// вставка с многократным расширением
+	for (int i = 1; i <= 1000; i++)
+		table.Insert(i, i * 2);
+
+	assert(table.GetSize() == 1003);
+	assert(table.GetCapacity() >= 1003);
+
+	for (int i = 1; i <= 1000; i++)
+		assert(table.TryGet(i, value) && value == i * 2);
+
+	// удаление и повторная вставка
+	for (int i = 1; i <= 1000; i += 2)
+		assert(table.Remove(i));
+
+	for (int i = 1; i <= 1000; i++)
+		assert(table.Find(i) == (i % 2 == 0));
+
+	assert(!table.TryEmplace(2, 0));
+	assert(table.Get(2) == 4);
+	assert(table.TryEmplace(1, 7));
+	assert(table.Get(1) == 7);
+
+	// счётчики
+	assert(table.Add(5000, 3) == 3);
+	assert(table.Add(5000, -5) == -2);
+	assert(table.Get(5000) == -2);
+
+	try {
+		table.Get(3);
+		assert(false);
+	}
+	catch (string s) {
+	}
+
+	table.Clear();
+	assert(table.IsEmpty() && !table.Find(2));
+
+	cout << "OK" << endl;
+}
+
+// нагрузочный тест: потоки изменяют собственные ключи и общие счётчики, пока таблица расширяется
+void LockFreeStressTests() {
+	cout << "Lock-free table stress tests: ";
+
+	LockFreeTable<FunctionHash<int>> table(2, GetHash);
+	const int threadCount = 4;
+	const int count = 20000;
+	const int counters = 16;
+
+	vector<thread> threads;
+
+	for (int t = 0; t < threadCount; t++)
+		threads.emplace_back([&table, t, count, counters]() {
+			for (int i = 0; i < count; i++) {
+				int key = t * count + i;
+
+				table.Insert(key, key);
+				table.Add(-1 - i % counters, 1);
+
+				if (i % 3 == 0)
+					assert(table.Remove(key));
+
+				int value;
+				assert(table.TryGet(key, value) == (i % 3 != 0));
+			}
+		});
+
+	for (size_t t = 0; t < threads.size(); t++)
+		threads[t].join();
+
+	int value;
+
+	for (int key = 0; key < threadCount * count; key++)
+		assert(table.TryGet(key, value) == (key % count % 3 != 0) && (value == key || key % count % 3 == 0));
+
+	for (int i = 0; i < counters; i++)
+		assert(table.Get(-1 - i) == threadCount * count / counters);
+
+	assert(table.GetSize() == threadCount * (count - (count + 2) / 3) + counters);
+
+	cout << "OK" << endl;
+}
+
+void LockFreeMigrationTests() {
+	cout << "Lock-free table remove during migration tests: ";
+
+	LockFreeTable<FunctionHash<int>> table(2, GetHash);
+	const int threadCount = 4;
+	const int count = 50000;
+
+	vector<thread> threads;
+
+	// почти все ключи удаляются, но новые ключи продолжают занимать ячейки небольшого массива,
+	// поэтому переносы идут непрерывно и пересекаются с удалениями
+	for (int t = 0; t < threadCount; t++)
+		threads.emplace_back([&table, t, count]() {
+			for (int i = 0; i < count; i++) {
+				int key = t * count + i;
+
+				table.Insert(key, key);
+
+				if (i > 0 && (i - 1) % 1024 != 0) {
+					assert(table.Remove(key - 1));
+					assert(!table.Find(key - 1));
+				}
+			}
+		});
+
+	for (size_t t = 0; t < threads.size(); t++)
+		threads[t].join();
+
+	int present = 0;
+
+	for (int key = 0; key < threadCount * count; key++) {
+		int i = key % count;
+		bool removed = i < count - 1 && i % 1024 != 0;
+
+		assert(table.Find(key) == !removed);
+		present += !removed;
+	}
+
+	assert(table.GetSize() == present);
+
+	// после завершения всех операций снятые массивы освобождены, остаётся только текущий
+	TableStats stats = table.GetStats();
+	assert(stats.bytes <= sizeof(table) + 64 + stats.capacity * 2 * sizeof(uint64_t));
+
+	cout << "OK" << endl;
+}
+
+atomic<int> stalledHashes(0); // число потоков, остановленных при вычислении хеша
+atomic<int> releasedHashes(0); // наибольший модуль отрицательного ключа, хеш которого разрешено вычислить
+
+// хеш-функция, задерживающая поиск отрицательного ключа до разрешения: операция остаётся незавершённой
+struct StallingHash {
+	uint64_t operator()(int key) const {
+		if (key < 0) {
+			stalledHashes++;
+
+			while (releasedHashes.load() < -key)
+				this_thread::yield();
+		}
+
+		return key;
+	}
+};
+
+// снятые массивы освобождаются после операций, начатых до снятия, даже если более поздние операции ещё выполняются
+void LockFreeReclamationTests() {
+	cout << "Lock-free table reclamation tests: ";
+
+	LockFreeTable<StallingHash> table(2);
+	thread first([&table]() { assert(!table.Find(-1)); });
+
+	while (stalledHashes.load() < 1)
+		this_thread::yield();
+
+	// расширения снимают массивы, которые мог получить незавершённый поиск
+	for (int i = 0; i < 1000; i++)
+		table.Insert(i, i);
+
+	TableStats stats = table.GetStats();
+	assert(stats.bytes > sizeof(table) + 64 + stats.capacity * 2 * sizeof(uint64_t));
+
+	thread second([&table]() { assert(!table.Find(-2)); });
+
+	while (stalledHashes.load() < 2)
+		this_thread::yield();
+
+	releasedHashes.store(1);
+	first.join();
+
+	// второй поиск начат после снятия массивов и не задерживает их освобождение
+	stats = table.GetStats();
+	assert(stats.bytes <= sizeof(table) + 64 + stats.capacity * 2 * sizeof(uint64_t));
+
+	releasedHashes.store(2);
+	second.join();
+
+	for (int i = 0; i < 1000; i++)
+		assert(table.Get(i) == i);
+
+	cout << "OK" << endl;
+}
+
+// событие истории: запись (вставка или удаление) или чтение значения ключа
+struct HistoryEvent {
+	int key;
+	bool write;
+	bool present; // значение есть (после записи или по результату чтения)
+	int value; // уникальное записанное или прочитанное значение
+	long long invoke; // момент вызова
+	long long response; // момент завершения
+};
+
+// проверка линеаризуемости истории операций с регистрами-ключами:
+// каждое чтение должно возвращать результат записи, которая могла выполниться до него
+// без другой записи, полностью лежащей между ними, а два последовательных чтения
+// не могут видеть записи в обратном порядке (записанные значения уникальны)
+bool IsLinearizable(const vector<HistoryEvent> &history) {
+	map<int, vector<HistoryEvent>> writes, reads; // события по ключам
+	map<int, HistoryEvent> inserts; // вставка по записанному значению
+
+	for (size_t i = 0; i < history.size(); i++) {
+		const HistoryEvent &event = history[i];
+
+		if (event.write) {
+			writes[event.key].push_back(event);
+
+			if (event.present)
+				inserts[event.value] = event;
+		}
+		else {
+			reads[event.key].push_back(event);
+		}
+	}
+
+	for (auto &keyReads : reads) {
+		const vector<HistoryEvent> &keyWrites = writes[keyReads.first];
+
+		for (const HistoryEvent &read : keyReads.second) {
+			HistoryEvent source = { read.key, true, false, 0, -1, -1 }; // изначально ключа нет
+
+			if (read.present) {
+				if (inserts.count(read.value) == 0 || inserts[read.value].key != read.key)
+					return false; // значение никогда не записывалось
+
+				source = inserts[read.value];
+			}
+			else {
+				// из удалений, начавшихся до конца чтения, сильнее всего ограничивает последнее завершившееся
+				for (const HistoryEvent &write : keyWrites)
+					if (!write.present && write.invoke < read.response && write.response > source.response)
+						source = write;
+			}
+
+			if (source.invoke >= read.response)
+				return false; // запись началась после завершения чтения
+
+			// другая запись не может целиком лежать между источником и чтением
+			for (const HistoryEvent &other : keyWrites)
+				if ((other.present != read.present || (read.present && other.value != read.value)) && source.response < other.invoke && other.response < read.invoke)
+					return false;
+		}
+
+		// последовательные чтения не видят записи в обратном порядке
+		for (const HistoryEvent &first : keyReads.second)
+			for (const HistoryEvent &second : keyReads.second)
+				if (first.present && second.present && first.value != second.value && first.response < second.invoke)
+					if (inserts[second.value].response < inserts[first.value].invoke)
+						return false;
+	}
+
+	return true;
+}
+
+// запись истории одновременных операций над несколькими ключами, пока другой поток вызывает расширения
+void LinearizabilityTests() {
+	cout << "Lock-free table linearizability tests: ";
+
+	LockFreeTable<FunctionHash<int>> table(2, GetHash);
+	atomic<long long> clock(0);
+	atomic<bool> stop(false);
+
+	const int threadCount = 4;
+	const int operations = 1000;
+	const int keys = 4;
+
+	vector<vector<HistoryEvent>> histories(threadCount);
+	vector<thread> threads;
+
+	for (int t = 0; t < threadCount; t++)
+		threads.emplace_back([&, t]() {
+			unsigned int seed = t + 1;
+
+			for (int i = 0; i < operations; i++) {
+				seed = seed * 1103515245 + 12345;
+
+				HistoryEvent event = { (int) (seed >> 8) % keys, false, false, 0, 0, 0 };
+				int kind = (seed >> 16) % 3;
+
+				event.invoke = clock++;
+
+				if (kind == 0) {
+					event.write = true;
+					event.present = true;
+					event.value = t * operations + i;
+					table.Insert(event.key, event.value);
+				}
+				else if (kind == 1) {
+					event.write = table.Remove(event.key); // неудачное удаление - чтение отсутствующего ключа
+				}
+				else {
+					event.present = table.TryGet(event.key, event.value);
+				}
+
+				event.response = clock++;
+				histories[t].push_back(event);
+			}
+		});
+
+	// вставки других ключей вызывают перенос во время записи истории
+	thread grower([&]() {
+		for (int key = keys; !stop; key++) {
+			table.Insert(key, key);
+			table.Remove(key);
+		}
+	});
+
+	for (int t = 0; t < threadCount; t++)
+		threads[t].join();
+
+	stop = true;
+	grower.join();
+
+	vector<HistoryEvent> history;
+
+	for (int t = 0; t < threadCount; t++)
+		history.insert(history.end(), histories[t].begin(), histories[t].end());
+
+	assert(IsLinearizable(history));
+
+	// искажённая история (чтение значения, которое ещё не было записано) не проходит проверку
+	history.push_back({ 0, false, true, -5, -3, -2 });
+	history.push_back({ 0, true, true, -5, 0, 1 });
+	assert(!IsLinearizable(history));
+
+	cout << "OK" << endl;
+}
+
 int main() {
-	HashTable<int, string> *chaining = new SeparateChainingTable<int, string>(100, GetHash);
-	HashTable<int, string> *linear = new LinearProbingTable<int, string>(100, GetHash);
-	HashTable<int, string> *linear4 = new LinearProbingTable<int, string>(100, GetHash, 4);
-	HashTable<int, string> *linear2 = new LinearProbingTable<int, string>(100, GetHash, 2);
-	HashTable<int, string> *quadratic = new QuadraticProbingTable<int, string>(100, GetHash);
-	HashTable<int, string> *doubleHashing = new DoubleHashingTable<int, string>(100, GetHash, GetHash2);
+	HashTable<int, string> *chaining = new SeparateChainingTable<int, string, FunctionHash<int>>(100, GetHash);
+	HashTable<int, string> *linear = new LinearProbingTable<int, string, FunctionHash<int>>(100, GetHash);
+	HashTable<int, string> *linear4 = new LinearProbingTable<int, string, FunctionHash<int>>(100, GetHash, 4);
+	HashTable<int, string> *linear2 = new LinearProbingTable<int, string, FunctionHash<int>>(100, GetHash, 2);
+	HashTable<int, string> *linearShift = new LinearProbingTable<int, string, FunctionHash<int>>(100, GetHash, 1, 0.75, true);
+	HashTable<int, string> *robinHood = new RobinHoodTable<int, string, FunctionHash<int>>(100, GetHash);
+	HashTable<int, string> *linearSplit = new LinearProbingTable<int, string, FunctionHash<int>, equal_to<int>, SplitStorage<int, string>>(100, GetHash);
+	HashTable<int, string> *quadraticSplit = new QuadraticProbingTable<int, string, FunctionHash<int>, equal_to<int>, SplitStorage<int, string>>(100, GetHash);
+	HashTable<int, string> *doubleHashingSplit = new DoubleHashingTable<int, string, FunctionHash<int>, equal_to<int>, SplitStorage<int, string>>(100, GetHash, GetHash2);
+	HashTable<int, string> *linearPacked = new LinearProbingTable<int, string, FunctionHash<int>, equal_to<int>, PackedStorage<int, string>>(100, GetHash);
+	HashTable<int, string> *quadraticPacked = new QuadraticProbingTable<int, string, FunctionHash<int>, equal_to<int>, PackedStorage<int, string>>(100, GetHash);
+	HashTable<int, string> *doubleHashingPacked = new DoubleHashingTable<int, string, FunctionHash<int>, equal_to<int>, PackedStorage<int, string>>(100, GetHash, GetHash2);
+	HashTable<int, string> *swiss = new SwissTable<int, string, FunctionHash<int>>(100, GetHash);
+	HashTable<int, string> *quadratic = new QuadraticProbingTable<int, string, FunctionHash<int>>(100, GetHash);
+	HashTable<int, string> *doubleHashing = new DoubleHashingTable<int, string, FunctionHash<int>>(100, GetHash, GetHash2);
 
 	Tests(chaining, "Tests for table with separate chaining method");
 	Tests(linear, "Tests for table with linear probing method");
 	Tests(linear2, "Tests for table with linear probing method (q = 2)");
 	Tests(linear4, "Tests for table with linear probing method (q = 4)");
+	Tests(linearShift, "Tests for table with linear probing method (backward shift deletion)");
+	Tests(robinHood, "Tests for table with robin hood hashing method");
+	Tests(swiss, "Tests for swiss table with group probing");
 	Tests(quadratic, "Tests for table with quadratic probing method");
 	Tests(doubleHashing, "Tests for table with double hashing method");
-}
\ No newline at end of file
+	Tests(linearSplit, "Tests for table with linear probing method (split storage)");
+	Tests(quadraticSplit, "Tests for table with quadratic probing method (split storage)");
+	Tests(doubleHashingSplit, "Tests for table with double hashing method (split storage)");
+	Tests(linearPacked, "Tests for table with linear probing method (packed storage)");
+	Tests(quadraticPacked, "Tests for table with quadratic probing method (packed storage)");
+	Tests(doubleHashingPacked, "Tests for table with double hashing method (packed storage)");
+	LoadFactorTests();
+	QuadraticGrowthTests();
+	CoprimeStepGrowthTests();
+	CapacityPolicyTests();
+	Tests(new CuckooTable<int, string>(100), "Tests for table with cuckoo hashing method");
+	Tests(new CuckooTable<int, string, FunctionHash<int>>(100, GetHash, GetHash2), "Tests for table with cuckoo hashing method (weak hashes)");
+	CuckooTests();
+	cout << endl;
+
+	// GetHash собирает 1000 ключей в 100 соседних окрестностях, и часть из них уходит в переполнение (проверяется отдельно)
+	Tests(new HopscotchTable<int, string>(100), "Tests for table with hopscotch hashing method");
+	Tests(new HopscotchTable<int, string>(100, DefaultHash<int>(), 0.97), "Tests for table with hopscotch hashing method (load factor 0.97)");
+	HopscotchTests();
+	cout << endl;
+
+	// таблица для целых ключей без поля состояния ячеек
+	Tests(new IntegerTable<int, string>(100), "Tests for table with integer keys");
+	Tests(new IntegerTable<int, string, FunctionHash<int>>(100, FunctionHash<int>(GetHash)), "Tests for table with integer keys (weak hash)");
+	IntegerTests();
+	cout << endl;
+
+	// таблица с выделением памяти под каждый узел
+	Tests(new SeparateChainingTable<int, string, FunctionHash<int>, equal_to<int>, allocator<char>, HeapNodes>(100, GetHash), "Tests for table with separate chaining method (heap nodes)");
+	AllocatorTests();
+	cout << endl;
+
+	// таблицы с корзинами и звеньями из нескольких элементов (длинные цепочки без роста и с ростом из одной корзины)
+	Tests(new BucketChainingTable<int, string, FunctionHash<int>>(100, GetHash), "Tests for table with bucket chaining method");
+	Tests(new BucketChainingTable<int, string, FunctionHash<int>>(10, GetHash, 100), "Tests for table with bucket chaining method (load factor 100)");
+	Tests(new BucketChainingTable<int, string, FunctionHash<int>>(1, GetHash, 3), "Tests for table with bucket chaining method (growth from one bucket)");
+
+	// таблицы с ёмкостью - степенью двойки и простым числом
+	Tests(new LinearProbingTable<int, string, FunctionHash<int>, equal_to<int>, NodeStorage<int, string>, PowerOfTwoCapacity>(100, GetHash), "Tests for table with linear probing method (power of two capacity)");
+	Tests(new LinearProbingTable<int, string, FunctionHash<int>, equal_to<int>, NodeStorage<int, string>, PrimeCapacity>(100, GetHash), "Tests for table with linear probing method (prime capacity)");
+	Tests(new LinearProbingTable<int, string, FunctionHash<int>, equal_to<int>, NodeStorage<int, string>, PowerOfTwoCapacity>(100, GetHash, 1, 0.75, true), "Tests for table with linear probing method (power of two capacity, backward shift deletion)");
+	Tests(new QuadraticProbingTable<int, string, FunctionHash<int>, equal_to<int>, NodeStorage<int, string>, PowerOfTwoCapacity>(100, GetHash), "Tests for table with quadratic probing method (power of two capacity)");
+	Tests(new QuadraticProbingTable<int, string, FunctionHash<int>, equal_to<int>, NodeStorage<int, string>, PrimeCapacity>(100, GetHash), "Tests for table with quadratic probing method (prime capacity)");
+	Tests(new DoubleHashingTable<int, string, FunctionHash<int>, equal_to<int>, NodeStorage<int, string>, PowerOfTwoCapacity>(100, GetHash, GetHash2), "Tests for table with double hashing method (power of two capacity)");
+	Tests(new DoubleHashingTable<int, string, FunctionHash<int>, equal_to<int>, NodeStorage<int, string>, PrimeCapacity>(100, GetHash, GetHash2), "Tests for table with double hashing method (prime capacity)");
+	Tests(new RobinHoodTable<int, string, FunctionHash<int>, equal_to<int>, PowerOfTwoCapacity>(100, GetHash), "Tests for table with robin hood hashing method (power of two capacity)");
+	Tests(new RobinHoodTable<int, string, FunctionHash<int>, equal_to<int>, PrimeCapacity>(100, GetHash), "Tests for table with robin hood hashing method (prime capacity)");
+
+	// таблицы со встроенной хеш-функцией
+	Tests(new SeparateChainingTable<int, string>(100), "Tests for table with separate chaining method (default hash)");
+	Tests(new LinearProbingTable<int, string>(100), "Tests for table with linear probing method (default hash)");
+	Tests(new QuadraticProbingTable<int, string>(100), "Tests for table with quadratic probing method (default hash)");
+	Tests(new DoubleHashingTable<int, string>(100), "Tests for table with double hashing method (default hash)");
+	Tests(new RobinHoodTable<int, string>(100), "Tests for table with robin hood hashing method (default hash)");
+	Tests(new SwissTable<int, string>(100), "Tests for swiss table with group probing (default hash)");
+	Tests(new BucketChainingTable<int, string>(100), "Tests for table with bucket chaining method (default hash)");
+
+	// таблицы с пользовательскими функторами хеширования и сравнения
+	cout << "Tests for tables with case insensitive string keys" << endl;
+	HasherTests(new SeparateChainingTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+	HasherTests(new LinearProbingTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+	HasherTests(new QuadraticProbingTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+	HasherTests(new DoubleHashingTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+	HasherTests(new RobinHoodTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+	HasherTests(new SwissTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+	HasherTests(new CuckooTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+	HasherTests(new HopscotchTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+	HasherTests(new BucketChainingTable<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>(10));
+
+	// качество встроенных хеш-функций
+	cout << endl;
+	HashQualityTests();
+
+	// таблицы с хеш-функциями из библиотеки
+	cout << "Tests for tables with library hashes" << endl;
+	Tests(new LinearProbingTable<int, string, IntegerHash<int>>(100), "Tests for table with linear probing method (integer hash)");
+	Tests(new SwissTable<int, string, SeededHash<int>>(100), "Tests for swiss table with group probing (seeded hash)");
+
+	// таблицы с прозрачными хеш-функцией и сравнением ключей
+	cout << "Tests for tables with transparent lookup" << endl;
+	TransparentTests(new SeparateChainingTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new LinearProbingTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new QuadraticProbingTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new DoubleHashingTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new RobinHoodTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new SwissTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new CuckooTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new HopscotchTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new BucketChainingTable<string, int, StringHash, equal_to<>>(10));
+	TransparentTests(new StringTable<int>(10));
+
+	// таблица для строковых ключей
+	StringTableTests();
+
+	// вызовы через конкретные типы таблиц
+	cout << "Tests for tables with static dispatch" << endl;
+	SeparateChainingTable<int, string, FunctionHash<int>> staticChaining(10, GetHash);
+	BucketChainingTable<int, string, FunctionHash<int>> staticBucketChaining(10, GetHash);
+	LinearProbingTable<int, string, FunctionHash<int>> staticLinear(10, GetHash);
+	QuadraticProbingTable<int, string, FunctionHash<int>> staticQuadratic(10, GetHash);
+	DoubleHashingTable<int, string, FunctionHash<int>> staticDoubleHashing(10, GetHash, GetHash2);
+	RobinHoodTable<int, string, FunctionHash<int>> staticRobinHood(10, GetHash);
+	SwissTable<int, string, FunctionHash<int>> staticSwiss(10, GetHash);
+	CuckooTable<int, string> staticCuckoo(10);
+	HopscotchTable<int, string, FunctionHash<int>> staticHopscotch(10, GetHash);
+	IntegerTable<int, string> staticInteger(10);
+
+	StaticTests(staticChaining);
+	StaticTests(staticBucketChaining);
+	StaticTests(staticLinear);
+	StaticTests(staticQuadratic);
+	StaticTests(staticDoubleHashing);
+	StaticTests(staticRobinHood);
+	StaticTests(staticSwiss);
+	StaticTests(staticCuckoo);
+	StaticTests(staticHopscotch);
+	StaticTests(staticInteger);
+
+	// копирование и перемещение таблиц
+	cout << "Tests for table copying and moving" << endl;
+	MoveTests(SeparateChainingTable<int, string, FunctionHash<int>>(10, GetHash));
+	MoveTests(SeparateChainingTable<int, string, DefaultHash<int>, equal_to<int>, allocator<char>, HeapNodes>(10));
+	MoveTests(BucketChainingTable<int, string, FunctionHash<int>>(10, GetHash));
+	MoveTests(LinearProbingTable<int, string, FunctionHash<int>>(10, GetHash));
+	MoveTests(LinearProbingTable<int, string, FunctionHash<int>>(10, GetHash, 2)); // шаг 2 при чётной ёмкости не обходит все ячейки
+	MoveTests(LinearProbingTable<int, string, FunctionHash<int>, equal_to<int>, SplitStorage<int, string>>(10, GetHash, 1, 0.75, true));
+	MoveTests(LinearProbingTable<int, string, FunctionHash<int>, equal_to<int>, PackedStorage<int, string>>(10, GetHash, 1, 0.75, true));
+	MoveTests(QuadraticProbingTable<int, string, FunctionHash<int>>(10, GetHash));
+	MoveTests(DoubleHashingTable<int, string, FunctionHash<int>>(10, GetHash, GetHash2));
+	MoveTests(RobinHoodTable<int, string, FunctionHash<int>>(10, GetHash));
+	MoveTests(SwissTable<int, string, FunctionHash<int>>(10, GetHash));
+	MoveTests(CuckooTable<int, string>(10));
+	MoveTests(HopscotchTable<int, string, FunctionHash<int>>(10, GetHash));
+	MoveTests(IntegerTable<int, string>(10));
+	cout << endl;
+
+	// отложенное создание элементов в ячейках
+	cout << "Tests for lazy cell initialization" << endl;
+	LazyInitTests(LinearProbingTable<int, Counted, FunctionHash<int>>(10, GetHash));
+	LazyInitTests(LinearProbingTable<int, Counted, FunctionHash<int>>(10, GetHash, 1, 0.75, true));
+	LazyInitTests(LinearProbingTable<int, Counted, FunctionHash<int>, equal_to<int>, SplitStorage<int, Counted>>(10, GetHash));
+	LazyInitTests(LinearProbingTable<int, Counted, FunctionHash<int>, equal_to<int>, PackedStorage<int, Counted>>(10, GetHash, 1, 0.75, true));
+	LazyInitTests(QuadraticProbingTable<int, Counted, FunctionHash<int>>(10, GetHash));
+	LazyInitTests(DoubleHashingTable<int, Counted, FunctionHash<int>>(10, GetHash, GetHash2));
+	LazyInitTests(RobinHoodTable<int, Counted, FunctionHash<int>>(10, GetHash));
+	LazyInitTests(SwissTable<int, Counted, FunctionHash<int>>(10, GetHash));
+	LazyInitTests(CuckooTable<int, Counted>(10));
+	LazyInitTests(HopscotchTable<int, Counted, FunctionHash<int>>(10, GetHash));
+	LazyInitTests(IntegerTable<int, Counted>(10));
+	cout << endl;
+
+	// снимки таблиц
+	cout << "Tests for table snapshots" << endl;
+	SnapshotTests();
+	cout << endl;
+
+	// потокобезопасные таблицы не наследуют интерфейс, но предоставляют те же операции
+	static_assert(IsHashTableV<ShardedTable<int, string>, int, string>, "sharded table must provide hash table interface");
+	static_assert(IsHashTableV<LockFreeTable<>, int, int>, "lock-free table must provide hash table interface");
+	static_assert(!IsHashTableV<vector<int>, int, int>, "vector is not a hash table");
+
+	// статистика заполнения
+	ExactStatsTests();
+
+	// потокобезопасная таблица
+	cout << endl;
+	ShardedTests(1);
+	ShardedTests(16);
+
+	// неблокирующая таблица
+	LockFreeTests();
+	LockFreeStressTests();
+	LockFreeMigrationTests();
+	LockFreeReclamationTests();
+	LinearizabilityTests();
+}